@@ -98,6 +98,21 @@ static int i2c_emul_transfer(const struct device *dev, struct i2c_msg *msgs, uin
 	return 0;
 }
 
+#ifdef CONFIG_I2C_RTIO
+static void i2c_emul_iodev_submit(const struct device *dev, uint16_t addr,
+				  const struct rtio_sqe *sqe, struct rtio *r)
+{
+	/* Emulators complete transfers synchronously */
+	int err = i2c_rtio_sqe_transfer(dev, addr, sqe, i2c_emul_transfer);
+
+	if (err < 0) {
+		rtio_sqe_err(r, sqe, err);
+	} else {
+		rtio_sqe_ok(r, sqe, err);
+	}
+}
+#endif /* CONFIG_I2C_RTIO */
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -136,6 +151,9 @@ static struct i2c_driver_api i2c_emul_api = {
 	.configure = i2c_emul_configure,
 	.get_config = i2c_emul_get_config,
 	.transfer = i2c_emul_transfer,
+#ifdef CONFIG_I2C_RTIO
+	.iodev_submit = i2c_emul_iodev_submit,
+#endif
 };
 
 #define EMUL_LINK_AND_COMMA(node_id)                                                               \
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_work.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(i2c_rtio, CONFIG_I2C_LOG_LEVEL);
+
+int i2c_rtio_sqe_transfer(const struct device *dev, uint16_t addr,
+			  const struct rtio_sqe *sqe, i2c_api_full_io_t io)
+{
+	struct i2c_msg msgs[2];
+	uint8_t num_msgs = 1;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		msgs[0].buf = sqe->buf;
+		msgs[0].len = sqe->buf_len;
+		msgs[0].flags = I2C_MSG_READ | I2C_MSG_STOP;
+		break;
+	case RTIO_OP_TX:
+		msgs[0].buf = sqe->buf;
+		msgs[0].len = sqe->buf_len;
+		msgs[0].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+		break;
+	case RTIO_OP_TX_THEN_RX:
+		msgs[0].buf = sqe->wr_buf;
+		msgs[0].len = sqe->wr_buf_len;
+		msgs[0].flags = I2C_MSG_WRITE;
+		msgs[1].buf = sqe->rd_buf;
+		msgs[1].len = sqe->rd_buf_len;
+		msgs[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+		num_msgs = 2;
+		break;
+	default:
+		/* I2C is half duplex, RTIO_OP_TXRX is not possible */
+		LOG_ERR("Unsupported op %u", sqe->op);
+		return -ENOTSUP;
+	}
+
+	return io(dev, msgs, num_msgs, addr);
+}
+
+static void i2c_iodev_work_handler(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct i2c_dt_spec *spec = sqe->iodev->data;
+	const struct i2c_driver_api *api = spec->bus->api;
+	int err;
+
+	err = i2c_rtio_sqe_transfer(spec->bus, spec->addr, sqe, api->transfer);
+	if (err < 0) {
+		rtio_sqe_err(r, sqe, err);
+	} else {
+		rtio_sqe_ok(r, sqe, err);
+	}
+}
+
+static void i2c_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct i2c_dt_spec *spec = sqe->iodev->data;
+	const struct i2c_driver_api *api = spec->bus->api;
+
+	if (sqe->op == RTIO_OP_NOP) {
+		rtio_sqe_ok(r, sqe, 0);
+	} else if (api->iodev_submit != NULL) {
+		api->iodev_submit(spec->bus, spec->addr, sqe, r);
+	} else {
+		rtio_work_submit(sqe, r, i2c_iodev_work_handler);
+	}
+}
+
+const struct rtio_iodev_api i2c_iodev_api = {
+	.submit = i2c_iodev_submit,
+};
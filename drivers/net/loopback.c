@@ -82,6 +82,100 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+/* Packets waiting to be received, in the order they were sent. As the
+ * delay is the same for all of them the deadlines are increasing.
+ */
+#define LOOPBACK_DELAY_QUEUE_LEN CONFIG_NET_PKT_RX_COUNT
+
+static struct {
+	struct net_pkt *pkt;
+	int64_t deadline;
+} loopback_delay_queue[LOOPBACK_DELAY_QUEUE_LEN];
+
+static uint16_t loopback_delay_head;
+static uint16_t loopback_delay_count;
+static uint32_t loopback_packet_delay_ms;
+static struct k_spinlock loopback_delay_lock;
+
+static void loopback_delay_process(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_process);
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_packet_delay_ms = delay_ms;
+	return 0;
+}
+
+static void loopback_delay_process(struct k_work *work)
+{
+	k_spinlock_key_t key;
+	struct net_pkt *pkt;
+	int64_t remaining;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delay_count == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		remaining = loopback_delay_queue[loopback_delay_head].deadline -
+			    k_uptime_get();
+		if (remaining > 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			k_work_reschedule(&loopback_delay_work,
+					  K_MSEC(remaining));
+			break;
+		}
+
+		pkt = loopback_delay_queue[loopback_delay_head].pkt;
+		loopback_delay_head = (loopback_delay_head + 1) %
+				      LOOPBACK_DELAY_QUEUE_LEN;
+		loopback_delay_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+static void loopback_delay_enqueue(struct net_pkt *pkt)
+{
+	k_spinlock_key_t key;
+	uint16_t tail;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (loopback_delay_count == LOOPBACK_DELAY_QUEUE_LEN) {
+		k_spin_unlock(&loopback_delay_lock, key);
+		/* Like a full router queue, drop the packet */
+		LOG_DBG("Delay queue full, dropping %p", pkt);
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	tail = (loopback_delay_head + loopback_delay_count) %
+	       LOOPBACK_DELAY_QUEUE_LEN;
+	loopback_delay_queue[tail].pkt = pkt;
+	loopback_delay_queue[tail].deadline = k_uptime_get() +
+					      loopback_packet_delay_ms;
+	loopback_delay_count++;
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	/* Does nothing if an earlier packet already scheduled it */
+	k_work_schedule(&loopback_delay_work,
+			K_MSEC(loopback_packet_delay_ms));
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -138,6 +232,14 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	if (loopback_packet_delay_ms > 0) {
+		loopback_delay_enqueue(cloned);
+		res = 0;
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
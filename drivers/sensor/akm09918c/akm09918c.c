@@ -13,24 +13,21 @@
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/logging/log.h>
+#ifdef CONFIG_SENSOR_ASYNC_API
+#include <zephyr/rtio/rtio_work.h>
+#endif
 
 #include "akm09918c.h"
 #include "akm09918c_reg.h"
 
 LOG_MODULE_REGISTER(AKM09918C, CONFIG_SENSOR_LOG_LEVEL);
 
-static int akm09918c_sample_fetch(const struct device *dev, enum sensor_channel chan)
+static int akm09918c_fetch(const struct device *dev, int16_t readings[3])
 {
 	struct akm09918c_data *data = dev->data;
 	const struct akm09918c_config *cfg = dev->config;
 	uint8_t buf[9] = {0};
 
-	if (chan != SENSOR_CHAN_ALL && chan != SENSOR_CHAN_MAGN_X && chan != SENSOR_CHAN_MAGN_Y &&
-	    chan != SENSOR_CHAN_MAGN_Z && chan != SENSOR_CHAN_MAGN_XYZ) {
-		LOG_WRN("Invalid channel %d", chan);
-		return -EINVAL;
-	}
-
 	if (data->mode == AKM09918C_CNTL2_PWR_DOWN) {
 		if (i2c_reg_write_byte_dt(&cfg->i2c, AKM09918C_REG_CNTL2,
 					  AKM09918C_CNTL2_SINGLE_MEASURE) != 0) {
@@ -54,9 +51,33 @@ static int akm09918c_sample_fetch(const struct device *dev, enum sensor_channel
 		return -EBUSY;
 	}
 
-	data->x_sample = sys_le16_to_cpu(buf[1] | (buf[2] << 8));
-	data->y_sample = sys_le16_to_cpu(buf[3] | (buf[4] << 8));
-	data->z_sample = sys_le16_to_cpu(buf[5] | (buf[6] << 8));
+	readings[0] = sys_le16_to_cpu(buf[1] | (buf[2] << 8));
+	readings[1] = sys_le16_to_cpu(buf[3] | (buf[4] << 8));
+	readings[2] = sys_le16_to_cpu(buf[5] | (buf[6] << 8));
+
+	return 0;
+}
+
+static int akm09918c_sample_fetch(const struct device *dev, enum sensor_channel chan)
+{
+	struct akm09918c_data *data = dev->data;
+	int16_t readings[3];
+	int rc;
+
+	if (chan != SENSOR_CHAN_ALL && chan != SENSOR_CHAN_MAGN_X && chan != SENSOR_CHAN_MAGN_Y &&
+	    chan != SENSOR_CHAN_MAGN_Z && chan != SENSOR_CHAN_MAGN_XYZ) {
+		LOG_WRN("Invalid channel %d", chan);
+		return -EINVAL;
+	}
+
+	rc = akm09918c_fetch(dev, readings);
+	if (rc != 0) {
+		return rc;
+	}
+
+	data->x_sample = readings[0];
+	data->y_sample = readings[1];
+	data->z_sample = readings[2];
 
 	return 0;
 }
@@ -149,11 +170,49 @@ static int akm09918c_attr_set(const struct device *dev, enum sensor_channel chan
 	return 0;
 }
 
+#ifdef CONFIG_SENSOR_ASYNC_API
+static void akm09918c_submit_work(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct sensor_read_config *cfg = sqe->iodev->data;
+	struct akm09918c_encoded_data *edata = (struct akm09918c_encoded_data *)sqe->buf;
+	int rc;
+
+	if (sqe->buf_len < sizeof(*edata)) {
+		LOG_ERR("Buffer too small (%u < %zu)", sqe->buf_len, sizeof(*edata));
+		rtio_sqe_err(r, sqe, -ENOMEM);
+		return;
+	}
+
+	edata->timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	rc = akm09918c_fetch(cfg->sensor, edata->readings);
+	if (rc != 0) {
+		rtio_sqe_err(r, sqe, rc);
+		return;
+	}
+
+	rtio_sqe_ok(r, sqe, 0);
+}
+
+static void akm09918c_submit(const struct device *dev, const struct rtio_sqe *sqe,
+			     struct rtio *r)
+{
+	ARG_UNUSED(dev);
+
+	/* The bus API is blocking, so is a measurement in single-measure mode */
+	rtio_work_submit(sqe, r, akm09918c_submit_work);
+}
+#endif /* CONFIG_SENSOR_ASYNC_API */
+
 static const struct sensor_driver_api akm09918c_driver_api = {
 	.sample_fetch = akm09918c_sample_fetch,
 	.channel_get = akm09918c_channel_get,
 	.attr_get = akm09918c_attr_get,
 	.attr_set = akm09918c_attr_set,
+#ifdef CONFIG_SENSOR_ASYNC_API
+	.submit = akm09918c_submit,
+	.get_decoder = akm09918c_get_decoder,
+#endif
 };
 
 static inline int akm09918c_check_who_am_i(const struct i2c_dt_spec *i2c)
@@ -7,6 +7,7 @@
 #define ZEPHYR_DRIVERS_SENSOR_AKM09918C_AKM09918C_H_
 
 #include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/sensor.h>
 
 #include "akm09918c_reg.h"
@@ -28,6 +29,16 @@ struct akm09918c_config {
 	struct i2c_dt_spec i2c;
 };
 
+#ifdef CONFIG_SENSOR_ASYNC_API
+/* Frame read with the async API, decoded by akm09918c_get_decoder() */
+struct akm09918c_encoded_data {
+	uint64_t timestamp;
+	int16_t readings[3];
+};
+
+int akm09918c_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+#endif /* CONFIG_SENSOR_ASYNC_API */
+
 static inline uint8_t akm09918c_hz_to_reg(const struct sensor_value *val)
 {
 	if (val->val1 >= 100) {
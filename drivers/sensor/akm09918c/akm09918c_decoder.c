@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor.h>
+
+#include "akm09918c.h"
+
+/* Full scale is +/- 32768 * 500 micro gauss, below 2^5 gauss */
+#define AKM09918C_SHIFT 5
+
+static int akm09918c_decoder_get_frame_count(const uint8_t *buffer, uint16_t *frame_count)
+{
+	ARG_UNUSED(buffer);
+
+	*frame_count = 1;
+	return 0;
+}
+
+static int akm09918c_decoder_get_timestamp(const uint8_t *buffer, uint64_t *timestamp_ns)
+{
+	*timestamp_ns = ((const struct akm09918c_encoded_data *)buffer)->timestamp;
+	return 0;
+}
+
+static int akm09918c_decoder_get_shift(const uint8_t *buffer, enum sensor_channel channel,
+				       int8_t *shift)
+{
+	ARG_UNUSED(buffer);
+
+	switch (channel) {
+	case SENSOR_CHAN_MAGN_X:
+	case SENSOR_CHAN_MAGN_Y:
+	case SENSOR_CHAN_MAGN_Z:
+	case SENSOR_CHAN_MAGN_XYZ:
+		*shift = AKM09918C_SHIFT;
+		return 0;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static inline q31_t akm09918c_convert_q31(int16_t reading)
+{
+	return (q31_t)((reading * AKM09918C_MICRO_GAUSS_PER_BIT *
+			(INT64_C(1) << (31 - AKM09918C_SHIFT))) / 1000000);
+}
+
+static int akm09918c_decoder_decode(const uint8_t *buffer, enum sensor_channel channel,
+				    uint32_t *fit, uint16_t max_count, q31_t *values)
+{
+	const struct akm09918c_encoded_data *edata = (const struct akm09918c_encoded_data *)buffer;
+
+	if (*fit != 0 || max_count == 0) {
+		return 0;
+	}
+
+	switch (channel) {
+	case SENSOR_CHAN_MAGN_X:
+	case SENSOR_CHAN_MAGN_Y:
+	case SENSOR_CHAN_MAGN_Z:
+		values[0] = akm09918c_convert_q31(edata->readings[channel - SENSOR_CHAN_MAGN_X]);
+		break;
+	case SENSOR_CHAN_MAGN_XYZ:
+		values[0] = akm09918c_convert_q31(edata->readings[0]);
+		values[1] = akm09918c_convert_q31(edata->readings[1]);
+		values[2] = akm09918c_convert_q31(edata->readings[2]);
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	*fit = 1;
+	return 1;
+}
+
+static const struct sensor_decoder_api akm09918c_decoder = {
+	.get_frame_count = akm09918c_decoder_get_frame_count,
+	.get_timestamp = akm09918c_decoder_get_timestamp,
+	.get_shift = akm09918c_decoder_get_shift,
+	.decode = akm09918c_decoder_decode,
+};
+
+int akm09918c_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+
+	*decoder = &akm09918c_decoder;
+	return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_work.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(sensor_async, CONFIG_SENSOR_LOG_LEVEL);
+
+/*
+ * Frame of the sensors read with sensor_sample_fetch() and
+ * sensor_channel_get(): a single frame holding the values of each channel,
+ * converted to q31 with the smallest shift fitting them.
+ */
+struct sensor_default_header {
+	uint64_t timestamp_ns;
+	uint16_t num_channels;
+};
+
+struct sensor_default_entry {
+	uint16_t channel;
+	int8_t shift;
+	uint8_t reserved;
+	q31_t values[3];
+};
+
+#define SENSOR_DEFAULT_SHIFT_MAX 31
+
+static inline const struct sensor_default_entry *
+default_entries(const uint8_t *buffer)
+{
+	return (const struct sensor_default_entry *)(buffer +
+						     sizeof(struct sensor_default_header));
+}
+
+static int8_t default_shift_get(const int64_t *micro, int count)
+{
+	int64_t max = 0;
+	int8_t shift = 0;
+
+	for (int i = 0; i < count; i++) {
+		max = MAX(max, (micro[i] < 0) ? -micro[i] : micro[i]);
+	}
+
+	while (shift < SENSOR_DEFAULT_SHIFT_MAX &&
+	       max >= (INT64_C(1000000) << shift)) {
+		shift++;
+	}
+
+	return shift;
+}
+
+static int default_encode_channel(const struct device *dev, enum sensor_channel channel,
+				  struct sensor_default_entry *entry)
+{
+	struct sensor_value val[3];
+	int64_t micro[3];
+	int count = sensor_channel_num_values(channel);
+	int rc;
+
+	rc = sensor_channel_get(dev, channel, val);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (int i = 0; i < count; i++) {
+		micro[i] = (int64_t)val[i].val1 * 1000000 + val[i].val2;
+	}
+
+	entry->channel = channel;
+	entry->shift = default_shift_get(micro, count);
+	entry->reserved = 0;
+
+	for (int i = 0; i < count; i++) {
+		int64_t q = (micro[i] * (INT64_C(1) << (31 - entry->shift))) / 1000000;
+
+		entry->values[i] = (q31_t)CLAMP(q, INT32_MIN, INT32_MAX);
+	}
+
+	return 0;
+}
+
+static void sensor_default_work_handler(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct sensor_read_config *cfg = sqe->iodev->data;
+	struct sensor_default_header *header = (struct sensor_default_header *)sqe->buf;
+	struct sensor_default_entry *entries;
+	size_t required;
+	int rc;
+
+	required = (uint8_t *)default_entries(sqe->buf) - sqe->buf +
+		   cfg->count * sizeof(struct sensor_default_entry);
+	if (sqe->buf_len < required) {
+		LOG_ERR("Buffer too small for %zu channels (%u < %zu)", cfg->count,
+			sqe->buf_len, required);
+		rtio_sqe_err(r, sqe, -ENOMEM);
+		return;
+	}
+
+	header->timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	rc = sensor_sample_fetch(cfg->sensor);
+	if (rc < 0) {
+		rtio_sqe_err(r, sqe, rc);
+		return;
+	}
+
+	entries = (struct sensor_default_entry *)default_entries(sqe->buf);
+	for (size_t i = 0; i < cfg->count; i++) {
+		rc = default_encode_channel(cfg->sensor, cfg->channels[i], &entries[i]);
+		if (rc < 0) {
+			LOG_ERR("Failed to get channel %d: %d", cfg->channels[i], rc);
+			rtio_sqe_err(r, sqe, rc);
+			return;
+		}
+	}
+	header->num_channels = cfg->count;
+
+	rtio_sqe_ok(r, sqe, 0);
+}
+
+static void sensor_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct sensor_read_config *cfg = sqe->iodev->data;
+	const struct sensor_driver_api *api = cfg->sensor->api;
+
+	if (sqe->op == RTIO_OP_NOP) {
+		rtio_sqe_ok(r, sqe, 0);
+	} else if (sqe->op != RTIO_OP_RX) {
+		rtio_sqe_err(r, sqe, -ENOTSUP);
+	} else if (api->submit != NULL) {
+		api->submit(cfg->sensor, sqe, r);
+	} else {
+		rtio_work_submit(sqe, r, sensor_default_work_handler);
+	}
+}
+
+const struct rtio_iodev_api sensor_iodev_api = {
+	.submit = sensor_iodev_submit,
+};
+
+static const struct sensor_default_entry *
+default_entry_find(const uint8_t *buffer, enum sensor_channel channel)
+{
+	const struct sensor_default_header *header =
+		(const struct sensor_default_header *)buffer;
+	const struct sensor_default_entry *entries = default_entries(buffer);
+
+	for (uint16_t i = 0; i < header->num_channels; i++) {
+		if (entries[i].channel == channel) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int default_get_frame_count(const uint8_t *buffer, uint16_t *frame_count)
+{
+	ARG_UNUSED(buffer);
+
+	*frame_count = 1;
+	return 0;
+}
+
+static int default_get_timestamp(const uint8_t *buffer, uint64_t *timestamp_ns)
+{
+	*timestamp_ns = ((const struct sensor_default_header *)buffer)->timestamp_ns;
+	return 0;
+}
+
+static int default_get_shift(const uint8_t *buffer, enum sensor_channel channel,
+			     int8_t *shift)
+{
+	const struct sensor_default_entry *entry = default_entry_find(buffer, channel);
+
+	if (entry == NULL) {
+		return -ENOTSUP;
+	}
+
+	*shift = entry->shift;
+	return 0;
+}
+
+static int default_decode(const uint8_t *buffer, enum sensor_channel channel, uint32_t *fit,
+			  uint16_t max_count, q31_t *values)
+{
+	const struct sensor_default_entry *entry = default_entry_find(buffer, channel);
+
+	if (entry == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (*fit != 0 || max_count == 0) {
+		return 0;
+	}
+
+	memcpy(values, entry->values, sensor_channel_num_values(channel) * sizeof(q31_t));
+	*fit = 1;
+
+	return 1;
+}
+
+static const struct sensor_decoder_api sensor_default_decoder = {
+	.get_frame_count = default_get_frame_count,
+	.get_timestamp = default_get_timestamp,
+	.get_shift = default_get_shift,
+	.decode = default_decode,
+};
+
+int sensor_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
+{
+	const struct sensor_driver_api *api = dev->api;
+
+	if (api->get_decoder != NULL) {
+		return api->get_decoder(dev, decoder);
+	}
+
+	*decoder = &sensor_default_decoder;
+	return 0;
+}
+
+int sensor_read(const struct rtio_iodev *iodev, struct rtio *ctx, uint8_t *buf, size_t buf_len)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(ctx);
+	struct rtio_cqe *cqe;
+	int rc;
+
+	if (sqe == NULL) {
+		return -ENOMEM;
+	}
+
+	rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, buf, buf_len, buf);
+	sqe->flags = 0;
+
+	rc = rtio_submit(ctx, 1);
+	if (rc < 0) {
+		return rc;
+	}
+
+	cqe = rtio_cqe_consume(ctx);
+	if (cqe == NULL) {
+		return -EIO;
+	}
+
+	rc = cqe->result;
+	rtio_cqe_release_all(ctx);
+
+	return rc;
+}
@@ -81,6 +81,21 @@ static int spi_emul_io(const struct device *dev, const struct spi_config *config
 	return api->io(emul->target, config, tx_bufs, rx_bufs);
 }
 
+#ifdef CONFIG_SPI_RTIO
+static void spi_emul_iodev_submit(const struct device *dev, const struct spi_config *config,
+				  const struct rtio_sqe *sqe, struct rtio *r)
+{
+	/* Emulators complete transfers synchronously */
+	int err = spi_rtio_sqe_transceive(dev, config, sqe, spi_emul_io);
+
+	if (err < 0) {
+		rtio_sqe_err(r, sqe, err);
+	} else {
+		rtio_sqe_ok(r, sqe, err);
+	}
+}
+#endif /* CONFIG_SPI_RTIO */
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -111,6 +126,9 @@ int spi_emul_register(const struct device *dev, struct spi_emul *emul)
 
 static struct spi_driver_api spi_emul_api = {
 	.transceive = spi_emul_io,
+#ifdef CONFIG_SPI_RTIO
+	.iodev_submit = spi_emul_iodev_submit,
+#endif
 };
 
 #define EMUL_LINK_AND_COMMA(node_id)                                                               \
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_work.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(spi_rtio, CONFIG_SPI_LOG_LEVEL);
+
+int spi_rtio_sqe_transceive(const struct device *dev,
+			    const struct spi_config *config,
+			    const struct rtio_sqe *sqe,
+			    spi_api_io io)
+{
+	struct spi_buf tx_buf[2];
+	struct spi_buf rx_buf[2];
+	struct spi_buf_set tx = { .buffers = tx_buf, .count = 1 };
+	struct spi_buf_set rx = { .buffers = rx_buf, .count = 1 };
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		rx_buf[0] = (struct spi_buf){ .buf = sqe->buf, .len = sqe->buf_len };
+		return io(dev, config, NULL, &rx);
+	case RTIO_OP_TX:
+		tx_buf[0] = (struct spi_buf){ .buf = sqe->buf, .len = sqe->buf_len };
+		return io(dev, config, &tx, NULL);
+	case RTIO_OP_TXRX:
+		tx_buf[0] = (struct spi_buf){ .buf = sqe->tx_buf, .len = sqe->txrx_buf_len };
+		rx_buf[0] = (struct spi_buf){ .buf = sqe->rx_buf, .len = sqe->txrx_buf_len };
+		return io(dev, config, &tx, &rx);
+	case RTIO_OP_TX_THEN_RX:
+		/* Dummy bytes are clocked out while reading and read bytes are
+		 * discarded while writing, with chip select held throughout.
+		 */
+		tx_buf[0] = (struct spi_buf){ .buf = sqe->wr_buf, .len = sqe->wr_buf_len };
+		tx_buf[1] = (struct spi_buf){ .buf = NULL, .len = sqe->rd_buf_len };
+		rx_buf[0] = (struct spi_buf){ .buf = NULL, .len = sqe->wr_buf_len };
+		rx_buf[1] = (struct spi_buf){ .buf = sqe->rd_buf, .len = sqe->rd_buf_len };
+		tx.count = 2;
+		rx.count = 2;
+		return io(dev, config, &tx, &rx);
+	default:
+		LOG_ERR("Unsupported op %u", sqe->op);
+		return -ENOTSUP;
+	}
+}
+
+static void spi_iodev_work_handler(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_dt_spec *spec = sqe->iodev->data;
+	const struct spi_driver_api *api = spec->bus->api;
+	int err;
+
+	err = spi_rtio_sqe_transceive(spec->bus, &spec->config, sqe, api->transceive);
+	if (err < 0) {
+		rtio_sqe_err(r, sqe, err);
+	} else {
+		rtio_sqe_ok(r, sqe, err);
+	}
+}
+
+static void spi_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_dt_spec *spec = sqe->iodev->data;
+	const struct spi_driver_api *api = spec->bus->api;
+
+	if (sqe->op == RTIO_OP_NOP) {
+		rtio_sqe_ok(r, sqe, 0);
+	} else if (api->iodev_submit != NULL) {
+		api->iodev_submit(spec->bus, &spec->config, sqe, r);
+	} else {
+		rtio_work_submit(sqe, r, spi_iodev_work_handler);
+	}
+}
+
+const struct rtio_iodev_api spi_iodev_api = {
+	.submit = spi_iodev_submit,
+};
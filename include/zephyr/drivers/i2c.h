@@ -25,6 +25,9 @@
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#ifdef CONFIG_I2C_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif /* CONFIG_I2C_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -230,6 +233,12 @@ typedef int (*i2c_api_transfer_cb_t)(const struct device *dev,
 				 void *userdata);
 #endif /* CONFIG_I2C_CALLBACK */
 typedef int (*i2c_api_recover_bus_t)(const struct device *dev);
+#ifdef CONFIG_I2C_RTIO
+typedef void (*i2c_api_iodev_submit)(const struct device *dev,
+				     uint16_t addr,
+				     const struct rtio_sqe *sqe,
+				     struct rtio *r);
+#endif /* CONFIG_I2C_RTIO */
 
 __subsystem struct i2c_driver_api {
 	i2c_api_configure_t configure;
@@ -239,6 +248,9 @@ __subsystem struct i2c_driver_api {
 	i2c_api_target_unregister_t target_unregister;
 #ifdef CONFIG_I2C_CALLBACK
 	i2c_api_transfer_cb_t transfer_cb;
+#endif
+#ifdef CONFIG_I2C_RTIO
+	i2c_api_iodev_submit iodev_submit;
 #endif
 	i2c_api_recover_bus_t recover_bus;
 };
@@ -1478,6 +1490,63 @@ static inline int i2c_reg_update_byte_dt(const struct i2c_dt_spec *spec,
 				   reg_addr, mask, value);
 }
 
+#if defined(CONFIG_I2C_RTIO) || defined(__DOXYGEN__)
+
+/** @brief RTIO iodev API for devices on an I2C bus */
+extern const struct rtio_iodev_api i2c_iodev_api;
+
+/**
+ * @brief Define an iodev for a given dt node on the bus
+ *
+ * Submissions to the iodev are performed by the bus driver if it supports
+ * RTIO, or with blocking calls on the RTIO work queue otherwise. Supported
+ * operations are RTIO_OP_RX, RTIO_OP_TX and RTIO_OP_TX_THEN_RX, the latter
+ * with a repeated start between the write and the read.
+ *
+ * @param name Name of the iodev
+ * @param node_id Devicetree node identifier
+ */
+#define I2C_DT_IODEV_DEFINE(name, node_id)					\
+	static const struct i2c_dt_spec _i2c_dt_spec_##name =			\
+		I2C_DT_SPEC_GET(node_id);					\
+	RTIO_IODEV_DEFINE(name, &i2c_iodev_api, 1, (void *)&_i2c_dt_spec_##name)
+
+/**
+ * @brief Validate that the I2C bus of an iodev is ready.
+ *
+ * @param iodev I2C iodev defined with I2C_DT_IODEV_DEFINE
+ *
+ * @retval true if the I2C bus is ready for use.
+ * @retval false if the I2C bus is not ready for use.
+ */
+static inline bool i2c_is_ready_iodev(const struct rtio_iodev *iodev)
+{
+	const struct i2c_dt_spec *spec = iodev->data;
+
+	return i2c_is_ready_dt(spec);
+}
+
+/**
+ * @brief Perform a submission with a blocking transfer function
+ *
+ * Converts the buffers of the submission to I2C messages for @p io. Meant
+ * for drivers implementing i2c_driver_api::iodev_submit with a synchronous
+ * transfer function.
+ *
+ * @param dev I2C device
+ * @param addr Address of the I2C target device
+ * @param sqe Submission to perform
+ * @param io Transfer function
+ *
+ * @retval 0 If successful
+ * @retval -ENOTSUP The operation is not supported.
+ * @retval -errno Error returned by @p io.
+ */
+int i2c_rtio_sqe_transfer(const struct device *dev, uint16_t addr,
+			  const struct rtio_sqe *sqe, i2c_api_full_io_t io);
+
+#endif /* CONFIG_I2C_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
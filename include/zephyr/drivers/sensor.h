@@ -22,6 +22,10 @@
 #include <zephyr/types.h>
 #include <zephyr/device.h>
 #include <errno.h>
+#ifdef CONFIG_SENSOR_ASYNC_API
+#include <zephyr/dsp/types.h>
+#include <zephyr/rtio/rtio.h>
+#endif /* CONFIG_SENSOR_ASYNC_API */
 
 #ifdef __cplusplus
 extern "C" {
@@ -394,12 +398,104 @@ typedef int (*sensor_channel_get_t)(const struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+#if defined(CONFIG_SENSOR_ASYNC_API) || defined(__DOXYGEN__)
+
+/**
+ * @brief Decoder of the frames read with the asynchronous sensor API
+ *
+ * A buffer holds one or more frames in an encoding private to the driver,
+ * typically the raw register values with what is needed to scale them.
+ * Values are decoded to q31 fixed point numbers, which share a shift per
+ * channel and buffer: a q31 value v stands for v * 2^(shift - 31) in the
+ * unit used by struct sensor_value for the channel.
+ */
+struct sensor_decoder_api {
+	/**
+	 * @brief Get the number of frames in a buffer
+	 *
+	 * @param[in] buffer Buffer read from the sensor
+	 * @param[out] frame_count Number of frames in @p buffer
+	 *
+	 * @return 0 on success or negative error code
+	 */
+	int (*get_frame_count)(const uint8_t *buffer, uint16_t *frame_count);
+
+	/**
+	 * @brief Get the time the first frame of a buffer was read
+	 *
+	 * @param[in] buffer Buffer read from the sensor
+	 * @param[out] timestamp_ns System uptime in nanoseconds
+	 *
+	 * @return 0 on success or negative error code
+	 */
+	int (*get_timestamp)(const uint8_t *buffer, uint64_t *timestamp_ns);
+
+	/**
+	 * @brief Get the shift of the decoded values of a channel
+	 *
+	 * @param[in] buffer Buffer read from the sensor
+	 * @param[in] channel Channel to decode
+	 * @param[out] shift Shift of the q31 values of @p channel
+	 *
+	 * @return 0 on success
+	 * @return -ENOTSUP if @p channel is not in @p buffer
+	 */
+	int (*get_shift)(const uint8_t *buffer, enum sensor_channel channel, int8_t *shift);
+
+	/**
+	 * @brief Decode the values of a channel for a batch of frames
+	 *
+	 * Decoding starts at the frame @p fit points to, and @p fit is moved
+	 * past the decoded frames so a buffer can be decoded in several calls.
+	 * Start with @p fit set to 0.
+	 *
+	 * @param[in] buffer Buffer read from the sensor
+	 * @param[in] channel Channel to decode, *_XYZ channels give 3 values per
+	 *            frame
+	 * @param[in,out] fit Frame iterator
+	 * @param[in] max_count Maximum number of frames to decode
+	 * @param[out] values Decoded values
+	 *
+	 * @return Number of frames decoded, 0 once all are
+	 * @return -ENOTSUP if @p channel is not in @p buffer
+	 */
+	int (*decode)(const uint8_t *buffer, enum sensor_channel channel, uint32_t *fit,
+		      uint16_t max_count, q31_t *values);
+};
+
+/**
+ * @typedef sensor_submit_t
+ * @brief Callback API for reading a sensor asynchronously
+ *
+ * The driver reads the channels of the struct sensor_read_config of the
+ * iodev into the buffer of the RTIO_OP_RX submission, encoded for its
+ * decoder, and completes the submission with rtio_sqe_ok() or
+ * rtio_sqe_err(). It must not block.
+ */
+typedef void (*sensor_submit_t)(const struct device *dev, const struct rtio_sqe *sqe,
+				struct rtio *r);
+
+/**
+ * @typedef sensor_get_decoder_t
+ * @brief Callback API for getting the decoder of a sensor
+ *
+ * See sensor_get_decoder() for argument description
+ */
+typedef int (*sensor_get_decoder_t)(const struct device *dev,
+				    const struct sensor_decoder_api **decoder);
+
+#endif /* CONFIG_SENSOR_ASYNC_API */
+
 __subsystem struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_attr_get_t attr_get;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+#ifdef CONFIG_SENSOR_ASYNC_API
+	sensor_submit_t submit;
+	sensor_get_decoder_t get_decoder;
+#endif
 };
 
 /**
@@ -839,6 +935,110 @@ struct sensor_info {
 #define SENSOR_DEVICE_DT_INST_DEFINE(inst, ...)				\
 	SENSOR_DEVICE_DT_DEFINE(DT_DRV_INST(inst), __VA_ARGS__)
 
+#if defined(CONFIG_SENSOR_ASYNC_API) || defined(__DOXYGEN__)
+
+/**
+ * @brief Channels of a sensor read through an iodev
+ */
+struct sensor_read_config {
+	/** Sensor to read */
+	const struct device *sensor;
+	/** Channels to read */
+	const enum sensor_channel *channels;
+	/** Number of channels */
+	size_t count;
+};
+
+/** @brief RTIO iodev API for reading sensors */
+extern const struct rtio_iodev_api sensor_iodev_api;
+
+/**
+ * @brief Define an iodev reading channels of a sensor
+ *
+ * A read submission to the iodev fills its buffer with frames of the given
+ * channels, to be decoded with the decoder of the sensor. Drivers without
+ * native support are read with sensor_sample_fetch() and
+ * sensor_channel_get() on the RTIO work queue, into a generic encoding.
+ *
+ * @param name Name of the iodev
+ * @param dt_node Devicetree node of the sensor
+ * @param ... Channels to read, SENSOR_CHAN_ALL is not supported
+ */
+#define SENSOR_DT_READ_IODEV(name, dt_node, ...)					\
+	static const enum sensor_channel _CONCAT(__channel_array_, name)[] = {		\
+		__VA_ARGS__								\
+	};										\
+	static const struct sensor_read_config _CONCAT(__sensor_read_config_, name) = {	\
+		.sensor = DEVICE_DT_GET(dt_node),					\
+		.channels = _CONCAT(__channel_array_, name),				\
+		.count = ARRAY_SIZE(_CONCAT(__channel_array_, name)),			\
+	};										\
+	RTIO_IODEV_DEFINE(name, &sensor_iodev_api, 1,					\
+			  (void *)&_CONCAT(__sensor_read_config_, name))
+
+/**
+ * @brief Read a sensor through an iodev and wait for the frames
+ *
+ * Convenience wrapper which submits a single read to @p ctx and waits for
+ * it. To read sensors asynchronously, submit reads of the iodev with
+ * rtio_sqe_prep_read(), rtio_sqe_prep_read_with_pool(), or stream them with
+ * rtio_sqe_prep_read_multishot().
+ *
+ * @param iodev Iodev defined with SENSOR_DT_READ_IODEV()
+ * @param ctx RTIO context, with no submission in flight
+ * @param buf Buffer to read the frames into
+ * @param buf_len Size of @p buf
+ *
+ * @return 0 on success or negative error code
+ */
+int sensor_read(const struct rtio_iodev *iodev, struct rtio *ctx, uint8_t *buf, size_t buf_len);
+
+/**
+ * @brief Get the decoder of the frames read from a sensor
+ *
+ * @param dev Sensor device
+ * @param decoder Set to the decoder
+ *
+ * @return 0 on success or negative error code
+ */
+int sensor_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+
+/**
+ * @brief Number of decoded values per frame for a channel
+ *
+ * @param channel Sensor channel
+ *
+ * @return 3 for *_XYZ channels, 1 otherwise
+ */
+static inline int sensor_channel_num_values(enum sensor_channel channel)
+{
+	switch (channel) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_GYRO_XYZ:
+	case SENSOR_CHAN_MAGN_XYZ:
+		return 3;
+	default:
+		return 1;
+	}
+}
+
+/**
+ * @brief Convert a decoded q31 value to integer micro units
+ *
+ * @param value Decoded value
+ * @param shift Shift of the channel, see sensor_decoder_api::get_shift
+ *
+ * @return The converted value.
+ */
+static inline int64_t sensor_q31_to_micro(q31_t value, int8_t shift)
+{
+	int64_t micro = (int64_t)value * 1000000;
+
+	return (shift < 31) ? micro / (INT64_C(1) << (31 - shift)) : micro << (shift - 31);
+}
+
+#endif /* CONFIG_SENSOR_ASYNC_API */
+
 /**
  * @brief Helper function for converting struct sensor_value to integer milli units.
  *
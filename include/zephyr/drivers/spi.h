@@ -25,6 +25,9 @@
 #include <zephyr/dt-bindings/spi/spi.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
+#ifdef CONFIG_SPI_RTIO
+#include <zephyr/rtio/rtio.h>
+#endif /* CONFIG_SPI_RTIO */
 
 #ifdef __cplusplus
 extern "C" {
@@ -488,6 +491,20 @@ typedef int (*spi_api_io_async)(const struct device *dev,
 typedef int (*spi_api_release)(const struct device *dev,
 			       const struct spi_config *config);
 
+#ifdef CONFIG_SPI_RTIO
+/**
+ * @typedef spi_api_iodev_submit
+ * @brief Callback API for submitting work to a SPI device with RTIO
+ *
+ * The driver performs the submission on behalf of the iodev defined with
+ * SPI_DT_IODEV_DEFINE() and completes it with rtio_sqe_ok() or
+ * rtio_sqe_err().
+ */
+typedef void (*spi_api_iodev_submit)(const struct device *dev,
+				     const struct spi_config *config,
+				     const struct rtio_sqe *sqe,
+				     struct rtio *r);
+#endif /* CONFIG_SPI_RTIO */
 
 /**
  * @brief SPI driver API
@@ -498,6 +515,9 @@ __subsystem struct spi_driver_api {
 #ifdef CONFIG_SPI_ASYNC
 	spi_api_io_async transceive_async;
 #endif /* CONFIG_SPI_ASYNC */
+#ifdef CONFIG_SPI_RTIO
+	spi_api_iodev_submit iodev_submit;
+#endif /* CONFIG_SPI_RTIO */
 	spi_api_release release;
 };
 
@@ -926,6 +946,67 @@ static inline int spi_release_dt(const struct spi_dt_spec *spec)
 	return spi_release(spec->bus, &spec->config);
 }
 
+#if defined(CONFIG_SPI_RTIO) || defined(__DOXYGEN__)
+
+/** @brief RTIO iodev API for devices on a SPI bus */
+extern const struct rtio_iodev_api spi_iodev_api;
+
+/**
+ * @brief Define an iodev for a given dt node on the bus
+ *
+ * Submissions to the iodev are performed by the bus driver if it supports
+ * RTIO, or with blocking calls on the RTIO work queue otherwise. Supported
+ * operations are RTIO_OP_RX, RTIO_OP_TX, RTIO_OP_TXRX and
+ * RTIO_OP_TX_THEN_RX, each one a transfer with chip select asserted.
+ *
+ * @param name Name of the iodev
+ * @param node_id Devicetree node identifier
+ * @param operation_ SPI operational mode
+ * @param delay_ Chip select delay in microseconds
+ */
+#define SPI_DT_IODEV_DEFINE(name, node_id, operation_, delay_)			\
+	static const struct spi_dt_spec _spi_dt_spec_##name =			\
+		SPI_DT_SPEC_GET(node_id, operation_, delay_);			\
+	RTIO_IODEV_DEFINE(name, &spi_iodev_api, 1, (void *)&_spi_dt_spec_##name)
+
+/**
+ * @brief Validate that the SPI bus of an iodev is ready.
+ *
+ * @param iodev SPI iodev defined with SPI_DT_IODEV_DEFINE
+ *
+ * @retval true if the SPI bus is ready for use.
+ * @retval false if the SPI bus is not ready for use.
+ */
+static inline bool spi_is_ready_iodev(const struct rtio_iodev *iodev)
+{
+	const struct spi_dt_spec *spec = iodev->data;
+
+	return spi_is_ready_dt(spec);
+}
+
+/**
+ * @brief Perform a submission with a blocking transceive function
+ *
+ * Converts the buffers of the submission to buffer sets for @p io. Meant
+ * for drivers implementing spi_driver_api::iodev_submit with a synchronous
+ * transfer function.
+ *
+ * @param dev SPI device
+ * @param config SPI configuration
+ * @param sqe Submission to perform
+ * @param io Transceive function
+ *
+ * @retval 0 If successful
+ * @retval -ENOTSUP The operation is not supported.
+ * @retval -errno Error returned by @p io.
+ */
+int spi_rtio_sqe_transceive(const struct device *dev,
+			    const struct spi_config *config,
+			    const struct rtio_sqe *sqe,
+			    spi_api_io io);
+
+#endif /* CONFIG_SPI_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
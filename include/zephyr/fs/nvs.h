@@ -58,6 +58,17 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_LOOKUP_INDEX
+	uint32_t lookup_index_addr[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	uint16_t lookup_index_id[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	bool lookup_index_full;
+#endif
+#if CONFIG_NVS_GC_INCREMENTAL
+	uint32_t gc_addr;
+#endif
+#if CONFIG_NVS_GC_BACKGROUND
+	struct k_work gc_work;
+#endif
 };
 
 /**
@@ -168,6 +179,25 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Perform one step of incremental garbage collection: move one valid entry out
+ * of the oldest sector, or erase that sector once all its valid entries have
+ * been moved. Steps are performed until CONFIG_NVS_GC_RESERVE_SECTORS sectors
+ * are erased ahead of the write sector, so that a write closing a sector does
+ * not have to garbage collect one. Each step holds the file system lock for at
+ * most one entry move or one sector erase.
+ *
+ * @param fs Pointer to file system
+ * @retval 0 A step was performed, there may be more to do
+ * @retval -EALREADY The reserve of erased sectors is complete
+ * @retval -ENOSPC The next entry to move does not fit in the write sector, it is
+ * moved by the garbage collection of the write that closes the sector
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs);
+
 /**
  * @}
  */
@@ -3358,6 +3358,79 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+/** @brief Start a pool of work queues.
+ *
+ * This initializes and starts @p num_queues work queues with one thread
+ * each.  When the number of queues matches the number of CPUs and
+ * CONFIG_SCHED_CPU_MASK is enabled, each thread is pinned to its own CPU.
+ *
+ * Work is submitted to the queue returned by k_work_queue_pool_get() using
+ * the regular work API.  A queue thread with no pending work takes work
+ * pending on other queues of the pool, so a handler may run on any thread
+ * of the pool.  A work item is still never run concurrently with itself, and
+ * cancel and flush operations keep their guarantees.  Different work items
+ * are however processed in parallel and their order is not preserved.
+ *
+ * Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param pool pointer to the pool structure.
+ *
+ * @param queues array of @p num_queues queue structures.
+ *
+ * @param num_queues number of queues, at least one.
+ *
+ * @param stacks stack array of the threads, defined with
+ * K_THREAD_STACK_ARRAY_DEFINE() with @p num_queues elements of @p stack_size.
+ *
+ * @param stack_size size of each thread stack area, in bytes.
+ *
+ * @param prio initial thread priority.
+ *
+ * @param cfg optional additional configuration parameters, applied to all
+ * the queues.  Pass @c NULL if not required.
+ */
+void k_work_queue_pool_start(struct k_work_q_pool *pool,
+			     struct k_work_q *queues,
+			     uint32_t num_queues,
+			     k_thread_stack_t *stacks,
+			     size_t stack_size,
+			     int prio,
+			     const struct k_work_queue_config *cfg);
+
+/** @brief Get the queue of a pool to submit work to.
+ *
+ * This is the queue of the calling thread when it belongs to the pool, or
+ * the queue associated with the current CPU otherwise, so that work is
+ * spread over the pool without any shared state.  The returned queue can be
+ * passed to any work submission or scheduling function.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to a started pool.
+ *
+ * @return a queue of the pool.
+ */
+struct k_work_q *k_work_queue_pool_get(struct k_work_q_pool *pool);
+
+/** @brief Submit a work item to a pool of work queues.
+ *
+ * This is a wrapper for k_work_submit_to_queue() on the queue returned by
+ * k_work_queue_pool_get().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to a started pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return see k_work_submit_to_queue().
+ */
+static inline int k_work_submit_to_pool(struct k_work_q_pool *pool,
+					struct k_work *work)
+{
+	return k_work_submit_to_queue(k_work_queue_pool_get(pool), work);
+}
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3869,6 +3942,25 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Pool the queue belongs to, if any. */
+	struct k_work_q_pool *pool;
+#endif
+};
+
+/** @brief A pool of work queues balancing work between their threads.
+ *
+ * Each queue of the pool has its own thread and list of pending work.  A
+ * thread with no pending work steals the oldest work item pending on another
+ * queue of the pool.
+ */
+struct k_work_q_pool {
+	/* The queues of the pool. */
+	struct k_work_q *queues;
+
+	/* Number of queues. */
+	uint32_t num_queues;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -5129,12 +5221,24 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
  * @{
  */
 
+#ifdef CONFIG_HEAP_MAGAZINE
+/* Per-CPU cache of small free blocks in front of a k_heap */
+struct z_heap_magazine {
+	struct k_spinlock lock;
+	uint8_t count[CONFIG_HEAP_MAGAZINE_CLASSES];
+	void *blocks[CONFIG_HEAP_MAGAZINE_CLASSES][CONFIG_HEAP_MAGAZINE_DEPTH];
+};
+#endif
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_MAGAZINE
+	struct z_heap_magazine mag[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5210,6 +5314,22 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#if defined(CONFIG_HEAP_MAGAZINE) || defined(__DOXYGEN__)
+/**
+ * @brief Return the blocks cached in the magazines of a k_heap
+ *
+ * With CONFIG_HEAP_MAGAZINE, small blocks freed with k_heap_free()
+ * are kept in per-CPU magazines to serve later allocations without
+ * taking the heap lock.  To the underlying sys_heap, including its
+ * runtime statistics, those blocks are still allocated.  This call
+ * frees all of them back to the heap, e.g. before reading the heap
+ * statistics or when memory runs low.
+ *
+ * @param h Heap whose magazines are flushed
+ */
+void k_heap_magazine_flush(struct k_heap *h);
+#endif
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
@@ -123,6 +123,11 @@ struct _thread_base {
 	uint8_t cpu_mask;
 #endif
 
+#ifdef CONFIG_SCHED_PERCPU
+	/* CPU whose ready queue holds the thread, or that last ran it */
+	uint8_t runq_cpu;
+#endif
+
 	/* data returned by APIs */
 	void *swap_data;
 
@@ -256,6 +256,37 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/** @brief Statistics of a log message buffer. */
+struct log_buffer_stats {
+	/** Number of messages allocated. */
+	uint32_t allocated;
+
+	/** Number of messages dropped, not allocated or overwritten. */
+	uint32_t dropped;
+
+	/** Total number of cycles spent acquiring the buffer lock. */
+	uint64_t lock_wait;
+
+	/** Maximum number of cycles spent acquiring the buffer lock once. */
+	uint32_t lock_wait_max;
+};
+
+/**
+ * @brief Get statistics of the message buffer of a CPU.
+ *
+ * Requires CONFIG_LOG_BUFFER_STATS option. Without
+ * CONFIG_LOG_PERCPU_BUFFERS, all CPUs use the buffer of CPU 0.
+ *
+ * @param[in]  cpu   CPU index.
+ * @param[out] stats Statistics.
+ *
+ * @retval -EINVAL if logging mode does not use the buffer or the CPU has no
+ * buffer.
+ * @retval -ENOTSUP if instrumentation is not enabled.
+ * @retval 0 successfully collected statistics.
+ */
+int log_buffer_stats_get(uint32_t cpu, struct log_buffer_stats *stats);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
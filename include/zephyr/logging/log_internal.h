@@ -132,12 +132,21 @@ void z_log_msg_free(union log_msg_generic *msg);
  */
 bool z_log_msg_pending(void);
 
+/** @brief Count a message dropped from a buffer in the buffer statistics.
+ *
+ * @param buffer Buffer from which the message is dropped.
+ */
+void z_log_buffer_dropped(const struct mpsc_pbuf_buffer *buffer);
+
 static inline void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 				     const union mpsc_pbuf_generic *item)
 {
-	ARG_UNUSED(buffer);
 	ARG_UNUSED(item);
 
+	if (IS_ENABLED(CONFIG_LOG_BUFFER_STATS)) {
+		z_log_buffer_dropped(buffer);
+	}
+
 	z_log_dropped(true);
 }
 
@@ -11,6 +11,8 @@
 #ifndef ZEPHYR_INCLUDE_NET_LOOPBACK_H_
 #define ZEPHYR_INCLUDE_NET_LOOPBACK_H_
 
+#include <zephyr/types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,6 +35,17 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+/**
+ * @brief Set the time it takes for a packet to be received
+ *
+ * @param[in] delay_ms Delay in milliseconds, 0 to deliver packets at once
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_delay(uint32_t delay_ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
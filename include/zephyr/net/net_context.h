@@ -115,6 +115,47 @@ typedef void (*net_context_send_cb_t)(struct net_context *context,
 				      int status,
 				      void *user_data);
 
+struct net_context_zc_tx;
+
+/**
+ * @typedef net_context_zc_tx_cb_t
+ * @brief Zero-copy send completion callback.
+ *
+ * @details Called once all the data queued with net_context_send_zc() has
+ * been acknowledged by the peer, or when the connection is torn down before
+ * that. The callback is called from the TCP stack with the connection
+ * locked, so it must not call back into the network stack for the same
+ * context.
+ *
+ * @param context The context the data was queued to.
+ * @param tx The descriptor given to net_context_send_zc().
+ * @param status 0 if the data was acknowledged, < 0 if the connection was
+ * closed before that.
+ */
+typedef void (*net_context_zc_tx_cb_t)(struct net_context *context,
+				       struct net_context_zc_tx *tx,
+				       int status);
+
+/**
+ * @brief Zero-copy send descriptor.
+ *
+ * @details Tracks one chunk of data queued with net_context_send_zc(). The
+ * descriptor is owned by the stack until its callback has been called.
+ */
+struct net_context_zc_tx {
+	/** Internal list node */
+	sys_snode_t node;
+
+	/** Internal, bytes to be acknowledged before completion */
+	size_t pending;
+
+	/** Completion callback, must be set by the caller */
+	net_context_zc_tx_cb_t cb;
+
+	/** Caller private data */
+	void *user_data;
+};
+
 /**
  * @typedef net_tcp_accept_cb_t
  * @brief Accept callback
@@ -282,6 +323,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** epoll registrations watching this socket */
+	sys_slist_t epoll_items;
+#endif
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1000,6 +1046,32 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Queue network buffers to a TCP connection without copying.
+ *
+ * @details The buffer chain @a frags is appended as is to the send queue of
+ * the connection and the outgoing segments reference its data instead of
+ * copying it. On success the stack takes over the reference to @a frags
+ * and releases each fragment once its data has been acknowledged; the
+ * callback in @a tx is called when all of the data is acknowledged. The
+ * data of fragments allocated with net_buf_alloc_with_data() must stay
+ * valid until then. On failure the caller keeps ownership of @a frags and
+ * @a tx is not used.
+ *
+ * Only available if CONFIG_NET_TCP_SEND_ZC is enabled.
+ *
+ * @param context The TCP context to use.
+ * @param frags The data to send.
+ * @param tx Completion descriptor, with the callback set.
+ *
+ * @return number of bytes queued on success, -EAGAIN if the send window is
+ * full, -ENOBUFS if no segment could be allocated, a negative errno
+ * otherwise.
+ */
+int net_context_send_zc(struct net_context *context,
+			struct net_buf *frags,
+			struct net_context_zc_tx *tx);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -163,6 +163,14 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Congestion window in bytes of the connection that changed it last. */
+	net_stats_t cwnd;
+
+	/** Slow start threshold in bytes of the connection that changed it
+	 * last.
+	 */
+	net_stats_t ssthresh;
 };
 
 /**
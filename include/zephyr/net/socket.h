@@ -437,6 +437,94 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Zero-copy receive descriptor
+ *
+ * Describes data received with zsock_recv_zc(). The data is not copied,
+ * @a iov points directly into the network buffers holding it, which
+ * stay reserved until zsock_recv_zc_release() is called.
+ */
+struct zsock_zc_rx {
+	/** Fragment array provided by the caller, filled by zsock_recv_zc() */
+	struct iovec *iov;
+	/** In: number of entries in @a iov. Out: number of entries used */
+	size_t iovlen;
+	/** Number of bytes described by @a iov */
+	size_t len;
+	/** Network packet holding the data, internal */
+	void *pkt;
+};
+
+/**
+ * @brief Receive data from a stream socket without copying it
+ *
+ * @details
+ * Works like zsock_recv() on a connected SOCK_STREAM socket, but instead
+ * of copying the data into a user buffer, the fragments of the network
+ * buffers holding it are described in @a rx. At most @a rx->iovlen
+ * fragments of a single received packet are returned per call, any
+ * remaining data is returned by the next call. The TCP receive window
+ * is only reopened when the buffers are given back with
+ * zsock_recv_zc_release(), so holding on to them throttles the peer.
+ *
+ * Only @c ZSOCK_MSG_DONTWAIT is supported in @a flags. The call is
+ * available with :kconfig:option:`CONFIG_NET_SOCKETS_RECV_ZC` and
+ * cannot be used from user mode threads, or with TLS and offloaded
+ * sockets.
+ *
+ * @param sock Socket to receive from
+ * @param rx Zero-copy descriptor, @a iov and @a iovlen set by the caller
+ * @param flags Receive flags
+ *
+ * @return Number of bytes described in @a rx, 0 at end of stream, or -1
+ *         with errno set on error.
+ */
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_rx *rx, int flags);
+
+/**
+ * @brief Release data received with zsock_recv_zc()
+ *
+ * @details
+ * Gives the network buffers described by @a rx back to the stack and
+ * updates the TCP receive window accordingly. Every successful
+ * zsock_recv_zc() call returning data must be paired with a release,
+ * also if the socket has been closed in between.
+ *
+ * @param sock Socket the data was received from
+ * @param rx Zero-copy descriptor filled by zsock_recv_zc()
+ *
+ * @return 0 on success, -1 with errno set if the socket is not valid
+ *         anymore (the buffers are released nevertheless).
+ */
+int zsock_recv_zc_release(int sock, struct zsock_zc_rx *rx);
+
+struct net_buf;
+struct net_context_zc_tx;
+
+/**
+ * @brief Send network buffers on a stream socket without copying
+ *
+ * @details
+ * Queues the buffer chain @a frags to the TCP connection of the socket
+ * as is, see net_context_send_zc(). On success the stack owns @a frags
+ * and calls the callback in @a tx once the peer has acknowledged all of
+ * the data, or with a negative status if the connection goes away first.
+ * The whole chain is queued at once: a blocking socket waits for room in
+ * the send window, a non-blocking one fails with EAGAIN. On failure the
+ * caller keeps ownership of @a frags. The API is only available to
+ * supervisor mode threads and needs
+ * :kconfig:option:`CONFIG_NET_TCP_SEND_ZC`.
+ *
+ * @param sock Connected stream socket
+ * @param frags Data to send
+ * @param tx Completion descriptor, with the callback set
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ *
+ * @return Number of bytes queued, or -1 with errno set on error.
+ */
+ssize_t zsock_send_zc(int sock, struct net_buf *frags,
+		      struct net_context_zc_tx *tx, int flags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -467,6 +555,94 @@ __syscall int zsock_fcntl(int sock, int cmd, int flags);
  */
 __syscall int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout);
 
+/* ZSOCK_EPOLL* values are compatible with Linux */
+/** zsock_epoll: Socket is readable */
+#define ZSOCK_EPOLLIN ZSOCK_POLLIN
+/** zsock_epoll: Socket is writable */
+#define ZSOCK_EPOLLOUT ZSOCK_POLLOUT
+/** zsock_epoll: Error condition (always reported) */
+#define ZSOCK_EPOLLERR ZSOCK_POLLERR
+/** zsock_epoll: Peer closed the connection (always reported) */
+#define ZSOCK_EPOLLHUP ZSOCK_POLLHUP
+/** zsock_epoll: Report each readiness change only once */
+#define ZSOCK_EPOLLET BIT(31)
+/** zsock_epoll: Disable the registration after one report */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+
+/** zsock_epoll_ctl: Register a socket */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Unregister a socket */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a registered socket */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** Caller data returned with an epoll event */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** epoll registration and result entry */
+struct zsock_epoll_event {
+	/** ZSOCK_EPOLL* event mask */
+	uint32_t events;
+	/** Returned as is by zsock_epoll_wait() */
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * An epoll instance keeps a persistent set of sockets to watch. The
+ * registered sockets notify the instance when they become ready, so
+ * zsock_epoll_wait() only looks at sockets which had activity instead of
+ * scanning all of them like zsock_poll(). Only native sockets can be
+ * registered. The instance is released with zsock_close(). The API is
+ * only available to supervisor mode threads and needs
+ * :kconfig:option:`CONFIG_NET_SOCKETS_EPOLL`.
+ *
+ * @param flags Must be 0
+ *
+ * @return File descriptor of the instance, or -1 with errno set.
+ */
+int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a socket of an epoll instance
+ *
+ * @details
+ * Registrations persist until they are removed or the socket is closed.
+ * Level triggered registrations are reported by every
+ * zsock_epoll_wait() call for as long as the socket is ready,
+ * ZSOCK_EPOLLET registrations only once per readiness change.
+ *
+ * @param epfd epoll instance
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL
+ * @param fd Socket
+ * @param event Events of interest and caller data, ignored for
+ *        ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for registered sockets to become ready
+ *
+ * @param epfd epoll instance
+ * @param events Array filled with the ready sockets
+ * @param maxevents Size of @a events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of entries filled in @a events, 0 on timeout, or -1
+ *         with errno set.
+ */
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout);
+
 /**
  * @brief Get various socket options
  *
@@ -989,6 +1165,8 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Congestion control algorithm, "reno" or "cubic" */
+#define TCP_CONGESTION 13
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
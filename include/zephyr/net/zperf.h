@@ -37,6 +37,7 @@ struct zperf_upload_params {
 	struct {
 		uint8_t tos;
 		int tcp_nodelay;
+		int tcp_zerocopy;
 	} options;
 };
 
@@ -35,6 +35,7 @@
 #include <zephyr/rtio/rtio_spsc.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mem_blocks.h>
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 
@@ -99,10 +100,83 @@ struct rtio_iodev;
  */
 #define RTIO_SQE_CHAINED BIT(0)
 
+/**
+ * @brief The buffer of the read is allocated from the memory pool of the RTIO
+ * context.
+ *
+ * The buffer is allocated when the submission is performed, only if the
+ * submission is a read with no buffer. The buffer_len of the submission gives
+ * the size to allocate. The buffer is handed over with the completion, see
+ * rtio_cqe_get_mempool_buffer(), and must then be freed with
+ * rtio_release_buffer(). It is freed by the executor if the read fails.
+ *
+ * The memory pool is only accessible to supervisor threads, submissions with
+ * this flag copied in from user mode are rejected.
+ */
+#define RTIO_SQE_MEMPOOL_BUFFER BIT(1)
+
+/**
+ * @brief The submission stays armed and completes once per event.
+ *
+ * After each successful completion the executor hands the submission to the
+ * iodev again, with a new buffer if it uses the memory pool, until it is
+ * cancelled with rtio_sqe_cancel() or fails. The iodev must not complete the
+ * submission from within its submit call, and should implement the cancel
+ * call of its API so that cancelling does not wait for the next event. A
+ * multishot submission cannot be chained. Until it is cancelled, the
+ * submissions queued after it are not released, and with the concurrent
+ * executor neither are their tasks.
+ */
+#define RTIO_SQE_MULTISHOT BIT(2)
+
+/**
+ * @brief The submission is cancelled, set by the executor on rtio_sqe_cancel().
+ */
+#define RTIO_SQE_CANCELED BIT(3)
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* The executor allocated the buffer of the read from the memory pool */
+#define Z_RTIO_SQE_MEMPOOL_ALLOCATED BIT(15)
+
+/**
+ * @endcond
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @brief RTIO CQE Flags
+ * @defgroup rtio_cqe_flags RTIO CQE Flags
+ * @ingroup rtio_api
+ * @{
+ */
+
+/**
+ * @brief The completion holds a buffer allocated from the memory pool.
+ */
+#define RTIO_CQE_FLAG_MEMPOOL_BUFFER BIT(0)
+
 /**
  * @}
  */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Location of a memory pool buffer in the flags of a completion */
+#define RTIO_CQE_FLAG_MEMPOOL_BLK_IDX GENMASK(19, 8)
+#define RTIO_CQE_FLAG_MEMPOOL_BLK_CNT GENMASK(31, 20)
+
+/**
+ * @endcond
+ */
+
 /**
  * @brief A submission queue event
  */
@@ -125,11 +199,32 @@ struct rtio_sqe {
 	void *userdata;
 
 	union {
+		/** OP_TX, OP_RX */
 		struct {
 			uint32_t buf_len; /**< Length of buffer */
 
 			uint8_t *buf; /**< Buffer to use*/
 		};
+
+		/** OP_TXRX */
+		struct {
+			uint32_t txrx_buf_len; /**< Length of both buffers */
+
+			uint8_t *tx_buf; /**< Buffer to transmit */
+
+			uint8_t *rx_buf; /**< Buffer to receive into */
+		};
+
+		/** OP_TX_THEN_RX */
+		struct {
+			uint16_t wr_buf_len; /**< Length of buffer to write */
+
+			uint16_t rd_buf_len; /**< Length of buffer to read */
+
+			uint8_t *wr_buf; /**< Buffer to write first */
+
+			uint8_t *rd_buf; /**< Buffer to read into next */
+		};
 	};
 };
 
@@ -150,6 +245,7 @@ struct rtio_sq {
 struct rtio_cqe {
 	int32_t result; /**< Result from operation */
 	void *userdata; /**< Associated userdata with operation */
+	uint32_t flags; /**< Flags associated with the operation */
 };
 
 /**
@@ -185,6 +281,14 @@ struct rtio_executor_api {
 	 * @brief SQE fails to complete
 	 */
 	void (*err)(struct rtio *r, const struct rtio_sqe *sqe, int result);
+
+	/**
+	 * @brief Cancel a SQE
+	 *
+	 * Marks the SQE cancelled and, if its iodev drops it, completes it
+	 * with -ECANCELED.
+	 */
+	int (*cancel)(struct rtio *r, struct rtio_sqe *sqe);
 };
 
 /**
@@ -255,6 +359,11 @@ struct rtio {
 
 	/* Completion queue */
 	struct rtio_cq *cq;
+
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	/* Memory pool for read buffers, may be NULL */
+	struct sys_mem_blocks *block_pool;
+#endif
 };
 
 /**
@@ -271,6 +380,16 @@ struct rtio_iodev_api {
 	void (*submit)(const struct rtio_sqe *sqe,
 		       struct rtio *r);
 
+	/**
+	 * @brief Cancel a submission handed to the iodev, optional
+	 *
+	 * Called when a submission the iodev is working on is cancelled. The
+	 * iodev either drops it and returns 0, the executor then completes it
+	 * with -ECANCELED, or returns a negative errno code and completes it
+	 * as usual.
+	 */
+	int (*cancel)(const struct rtio_sqe *sqe, struct rtio *r);
+
 	/**
 	 * TODO some form of transactional piece is missing here
 	 * where we wish to "transact" on an iodev with multiple requests
@@ -323,6 +442,15 @@ struct rtio_iodev {
 /** An operation that transmits (writes) */
 #define RTIO_OP_TX 2
 
+/** An operation that transmits and receives at the same time (full duplex) */
+#define RTIO_OP_TXRX 3
+
+/**
+ * An operation that transmits then receives as a single bus transaction,
+ * such as writing a register address then reading the register.
+ */
+#define RTIO_OP_TX_THEN_RX 4
+
 /**
  * @brief Prepare a nop (no op) submission
  */
@@ -371,6 +499,87 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a transceive op submission
+ *
+ * Transmits @p tx_buf while receiving into @p rx_buf, both of @p buf_len
+ * bytes, on a full duplex bus.
+ */
+static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
+					    const struct rtio_iodev *iodev,
+					    int8_t prio,
+					    uint8_t *tx_buf,
+					    uint8_t *rx_buf,
+					    uint32_t buf_len,
+					    void *userdata)
+{
+	sqe->op = RTIO_OP_TXRX;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->txrx_buf_len = buf_len;
+	sqe->tx_buf = tx_buf;
+	sqe->rx_buf = rx_buf;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a write then read op submission
+ *
+ * Writes @p wr_buf then reads into @p rd_buf without releasing the bus in
+ * between, e.g. with a repeated start on I2C or with chip select held on SPI.
+ */
+static inline void rtio_sqe_prep_write_read(struct rtio_sqe *sqe,
+					    const struct rtio_iodev *iodev,
+					    int8_t prio,
+					    uint8_t *wr_buf,
+					    uint16_t wr_len,
+					    uint8_t *rd_buf,
+					    uint16_t rd_len,
+					    void *userdata)
+{
+	sqe->op = RTIO_OP_TX_THEN_RX;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->wr_buf_len = wr_len;
+	sqe->rd_buf_len = rd_len;
+	sqe->wr_buf = wr_buf;
+	sqe->rd_buf = rd_buf;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a read op submission with a buffer from the memory pool
+ *
+ * A buffer of at least @p len bytes is allocated from the memory pool of the
+ * RTIO context when the read is performed, see RTIO_SQE_MEMPOOL_BUFFER.
+ */
+static inline void rtio_sqe_prep_read_with_pool(struct rtio_sqe *sqe,
+						const struct rtio_iodev *iodev,
+						int8_t prio,
+						uint32_t len,
+						void *userdata)
+{
+	rtio_sqe_prep_read(sqe, iodev, prio, NULL, len, userdata);
+	sqe->flags |= RTIO_SQE_MEMPOOL_BUFFER;
+}
+
+/**
+ * @brief Prepare a multishot read op submission with buffers from the memory
+ * pool
+ *
+ * Each event is read into a new buffer of at least @p len bytes from the
+ * memory pool of the RTIO context, see RTIO_SQE_MULTISHOT.
+ */
+static inline void rtio_sqe_prep_read_multishot(struct rtio_sqe *sqe,
+						const struct rtio_iodev *iodev,
+						int8_t prio,
+						uint32_t len,
+						void *userdata)
+{
+	rtio_sqe_prep_read_with_pool(sqe, iodev, prio, len, userdata);
+	sqe->flags |= RTIO_SQE_MULTISHOT;
+}
+
 /**
  * @brief Statically define and initialize a fixed length submission queue.
  *
@@ -424,6 +633,34 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
  * @param cq_sz Size of the completion queue, must be power of 2
  */
 #define RTIO_DEFINE(name, exec, sq_sz, cq_sz)	\
+	Z_RTIO_DEFINE(name, exec, sq_sz, cq_sz, NULL)
+
+/**
+ * @brief Statically define and initialize an RTIO context with a memory pool
+ *
+ * The memory pool provides the buffers of reads submitted with
+ * RTIO_SQE_MEMPOOL_BUFFER, so that many requests in flight share the memory
+ * rather than each one owning a buffer of the largest size.
+ *
+ * @param name Name of the RTIO
+ * @param exec Symbol for rtio_executor (pointer)
+ * @param sq_sz Size of the submission queue, must be power of 2
+ * @param cq_sz Size of the completion queue, must be power of 2
+ * @param num_blks Number of blocks in the memory pool
+ * @param blk_size Size in bytes of each block, must be power of 2
+ * @param balign Alignment of the memory pool buffer, must be power of 2
+ */
+#define RTIO_DEFINE_WITH_MEMPOOL(name, exec, sq_sz, cq_sz, num_blks, blk_size, balign)	   \
+	BUILD_ASSERT((num_blks) <= FIELD_GET(RTIO_CQE_FLAG_MEMPOOL_BLK_IDX,		   \
+					     RTIO_CQE_FLAG_MEMPOOL_BLK_IDX) + 1,	   \
+		     "Too many blocks in the memory pool");				   \
+	SYS_MEM_BLOCKS_DEFINE_STATIC(_mempool_##name, blk_size, num_blks, balign);	   \
+	Z_RTIO_DEFINE(name, exec, sq_sz, cq_sz, &_mempool_##name)
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_RTIO_DEFINE(name, exec, sq_sz, cq_sz, pool)					   \
 	IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM,							   \
 		   (static K_SEM_DEFINE(_submit_sem_##name, 0, K_SEM_MAX_LIMIT)))		   \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,							   \
@@ -438,7 +675,11 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.consume_sem = &_consume_sem_##name,))	   \
 		.sq = (struct rtio_sq *const)&_sq_##name,					   \
 		.cq = (struct rtio_cq *const)&_cq_##name,                                          \
+		IF_ENABLED(CONFIG_RTIO_SYS_MEM_BLOCKS, (.block_pool = (pool),))			   \
 	};
+/**
+ * @endcond
+ */
 
 /**
  * @brief Set the executor of the rtio context
@@ -459,6 +700,25 @@ static inline void rtio_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
 	sqe->iodev->api->submit(sqe, r);
 }
 
+/**
+ * @brief Cancel a submission being worked on by an iodev
+ *
+ * @param sqe Submission handed to the iodev
+ * @param r RTIO context
+ *
+ * @retval 0 The iodev dropped the submission, it won't complete it
+ * @retval -ENOTSUP The iodev can't cancel submissions
+ * @retval -errno The iodev completes the submission as usual
+ */
+static inline int rtio_iodev_cancel(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	if (sqe->iodev == NULL || sqe->iodev->api->cancel == NULL) {
+		return -ENOTSUP;
+	}
+
+	return sqe->iodev->api->cancel(sqe, r);
+}
+
 /**
  * @brief Count of acquirable submission queue events
  *
@@ -565,6 +825,107 @@ static inline void rtio_cqe_release_all(struct rtio *r)
 	rtio_spsc_release_all(r->cq);
 }
 
+/**
+ * @brief Get the memory pool buffer of a completion
+ *
+ * The buffer must be freed with rtio_release_buffer() once processed, which
+ * may be after the completion is released.
+ *
+ * @param r RTIO context
+ * @param cqe Completion of a read submitted with RTIO_SQE_MEMPOOL_BUFFER
+ * @param buf Set to the buffer
+ * @param buf_len Set to the length of the buffer, rounded up to the block size
+ *
+ * @retval 0 success
+ * @retval -EINVAL the completion holds no memory pool buffer
+ */
+static inline int rtio_cqe_get_mempool_buffer(const struct rtio *r,
+					      const struct rtio_cqe *cqe,
+					      uint8_t **buf, uint32_t *buf_len)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if (cqe->flags & RTIO_CQE_FLAG_MEMPOOL_BUFFER) {
+		uint32_t blk_idx = FIELD_GET(RTIO_CQE_FLAG_MEMPOOL_BLK_IDX, cqe->flags);
+		uint32_t blk_cnt = FIELD_GET(RTIO_CQE_FLAG_MEMPOOL_BLK_CNT, cqe->flags);
+		uint8_t shift = r->block_pool->blk_sz_shift;
+
+		*buf = r->block_pool->buffer + (blk_idx << shift);
+		*buf_len = blk_cnt << shift;
+
+		return 0;
+	}
+#else
+	ARG_UNUSED(r);
+	ARG_UNUSED(cqe);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(buf_len);
+#endif
+
+	return -EINVAL;
+}
+
+/**
+ * @brief Release a memory pool buffer to the RTIO context
+ *
+ * @param r RTIO context
+ * @param buf Buffer returned by rtio_cqe_get_mempool_buffer()
+ * @param buf_len Length returned by rtio_cqe_get_mempool_buffer()
+ */
+static inline void rtio_release_buffer(struct rtio *r, void *buf, uint32_t buf_len)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	size_t blk_cnt = buf_len >> r->block_pool->blk_sz_shift;
+
+	(void)sys_mem_blocks_free_contiguous(r->block_pool, buf, blk_cnt);
+#else
+	ARG_UNUSED(r);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(buf_len);
+#endif
+}
+
+
+/**
+ * @brief Cancel a submission
+ *
+ * A submission which has not been handed to its iodev yet completes with
+ * -ECANCELED instead, failing the rest of its chain. One already handed to
+ * its iodev completes with -ECANCELED right away if the iodev drops it, see
+ * rtio_iodev_api::cancel, otherwise the next time the iodev completes it,
+ * which ends a multishot submission. No completion follows the one with
+ * -ECANCELED.
+ *
+ * The submission is released once completed, its slot may then be reused
+ * by another submission and it must not be cancelled anymore.
+ *
+ * @param r RTIO context
+ * @param sqe Submission acquired from the submission queue of @p r
+ *
+ * @retval 0 success
+ * @retval -EINVAL @p sqe is not a submission pending in the queue of @p r
+ * @retval -ENOTSUP the executor can't cancel submissions
+ */
+static inline int rtio_sqe_cancel(struct rtio *r, struct rtio_sqe *sqe)
+{
+	struct rtio_sq *sq = r->sq;
+	unsigned long out = atomic_get(&sq->_spsc.out);
+	unsigned long pending = atomic_get(&sq->_spsc.in) + sq->_spsc.acquire - out;
+
+	if (sqe < &sq->buffer[0] || sqe > &sq->buffer[sq->_spsc.mask]) {
+		return -EINVAL;
+	}
+
+	/* Only submissions acquired and not released yet are pending */
+	if (z_rtio_spsc_mask(sq, (unsigned long)(sqe - &sq->buffer[0]) - out) >= pending) {
+		return -EINVAL;
+	}
+
+	if (r->executor->api->cancel == NULL) {
+		return -ENOTSUP;
+	}
+
+	return r->executor->api->cancel(r, sqe);
+}
 
 /**
  * @brief Inform the executor of a submission completion with success
@@ -594,6 +955,155 @@ static inline void rtio_sqe_err(struct rtio *r, const struct rtio_sqe *sqe, int
 	r->executor->api->err(r, sqe, result);
 }
 
+/**
+ * @brief Allocate the memory pool buffer of a submission if it needs one
+ *
+ * Called by the executor before the submission is handed to the iodev.
+ *
+ * @param r RTIO context
+ * @param sqe Submission to perform
+ *
+ * @retval 0 success, or no buffer needed
+ * @retval -EINVAL the RTIO context has no memory pool or nothing to read
+ * @retval -ENOMEM the memory pool is exhausted
+ */
+static inline int rtio_sqe_mempool_alloc(struct rtio *r, struct rtio_sqe *sqe)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	void *buf;
+	size_t blk_cnt;
+
+	if (!(sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) || sqe->op != RTIO_OP_RX ||
+	    sqe->buf != NULL) {
+		return 0;
+	}
+
+	if (r->block_pool == NULL || sqe->buf_len == 0) {
+		return -EINVAL;
+	}
+
+	blk_cnt = DIV_ROUND_UP(sqe->buf_len, BIT(r->block_pool->blk_sz_shift));
+	if (blk_cnt > FIELD_GET(RTIO_CQE_FLAG_MEMPOOL_BLK_CNT, RTIO_CQE_FLAG_MEMPOOL_BLK_CNT) ||
+	    sys_mem_blocks_alloc_contiguous(r->block_pool, blk_cnt, &buf) != 0) {
+		return -ENOMEM;
+	}
+
+	sqe->buf = buf;
+	sqe->flags |= Z_RTIO_SQE_MEMPOOL_ALLOCATED;
+#else
+	ARG_UNUSED(r);
+
+	if ((sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) && sqe->op == RTIO_OP_RX &&
+	    sqe->buf == NULL) {
+		return -EINVAL;
+	}
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Check that a submission can be handed to its iodev
+ *
+ * Called by the executor before the submission is handed to the iodev, this
+ * also allocates its memory pool buffer if needed.
+ *
+ * @param r RTIO context
+ * @param sqe Submission to perform
+ *
+ * @retval 0 success
+ * @retval -ECANCELED the submission is cancelled
+ * @retval -EINVAL the submission is invalid
+ * @retval -ENOMEM the memory pool is exhausted
+ */
+static inline int rtio_sqe_arm(struct rtio *r, struct rtio_sqe *sqe)
+{
+	/* Left over from a previous use of the queue entry */
+	sqe->flags &= ~Z_RTIO_SQE_MEMPOOL_ALLOCATED;
+
+	if (sqe->flags & RTIO_SQE_CANCELED) {
+		return -ECANCELED;
+	}
+
+	if ((sqe->flags & RTIO_SQE_MULTISHOT) && (sqe->flags & RTIO_SQE_CHAINED)) {
+		return -EINVAL;
+	}
+
+	return rtio_sqe_mempool_alloc(r, sqe);
+}
+
+/**
+ * @brief Free the memory pool buffer of a failed submission
+ *
+ * @param r RTIO context
+ * @param sqe Submission which failed
+ */
+static inline void rtio_sqe_mempool_free(struct rtio *r, const struct rtio_sqe *sqe)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if (sqe->flags & Z_RTIO_SQE_MEMPOOL_ALLOCATED) {
+		size_t blk_cnt = DIV_ROUND_UP(sqe->buf_len, BIT(r->block_pool->blk_sz_shift));
+
+		(void)sys_mem_blocks_free_contiguous(r->block_pool, sqe->buf, blk_cnt);
+	}
+#else
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+#endif
+}
+
+/**
+ * @brief Detach the memory pool buffer handed over with a completion
+ *
+ * Called by the executor before a multishot submission is handed to the
+ * iodev again, so a new buffer is allocated for the next event.
+ *
+ * @param r RTIO context
+ * @param sqe Multishot submission which succeeded
+ */
+static inline void rtio_sqe_mempool_detach(struct rtio *r, struct rtio_sqe *sqe)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if (sqe->flags & Z_RTIO_SQE_MEMPOOL_ALLOCATED) {
+		sqe->buf = NULL;
+		sqe->flags &= ~Z_RTIO_SQE_MEMPOOL_ALLOCATED;
+	}
+#else
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+#endif
+}
+
+/**
+ * @brief Compute the completion flags of a successful submission
+ *
+ * @param r RTIO context
+ * @param sqe Submission which succeeded
+ *
+ * @return Flags for rtio_cqe_submit()
+ */
+static inline uint32_t rtio_cqe_compute_flags(struct rtio *r, const struct rtio_sqe *sqe)
+{
+	uint32_t flags = 0;
+
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if (sqe->flags & Z_RTIO_SQE_MEMPOOL_ALLOCATED) {
+		uint8_t shift = r->block_pool->blk_sz_shift;
+		uint32_t blk_idx = (sqe->buf - r->block_pool->buffer) >> shift;
+		uint32_t blk_cnt = DIV_ROUND_UP(sqe->buf_len, BIT(shift));
+
+		flags = RTIO_CQE_FLAG_MEMPOOL_BUFFER |
+			FIELD_PREP(RTIO_CQE_FLAG_MEMPOOL_BLK_IDX, blk_idx) |
+			FIELD_PREP(RTIO_CQE_FLAG_MEMPOOL_BLK_CNT, blk_cnt);
+	}
+#else
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+#endif
+
+	return flags;
+}
+
 /**
  * Submit a completion queue event with a given result and userdata
  *
@@ -603,16 +1113,28 @@ static inline void rtio_sqe_err(struct rtio *r, const struct rtio_sqe *sqe, int
  * @param r RTIO context
  * @param result Integer result code (could be -errno)
  * @param userdata Userdata to pass along to completion
+ * @param flags Flags of the completion, see rtio_cqe_compute_flags()
  */
-static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata)
+static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata,
+				   uint32_t flags)
 {
 	struct rtio_cqe *cqe = rtio_spsc_acquire(r->cq);
 
 	if (cqe == NULL) {
+		struct rtio_cqe dropped = { .flags = flags };
+		uint8_t *buf;
+		uint32_t buf_len;
+
 		atomic_inc(&r->xcqcnt);
+
+		/* Nobody will own the buffer of a dropped completion */
+		if (rtio_cqe_get_mempool_buffer(r, &dropped, &buf, &buf_len) == 0) {
+			rtio_release_buffer(r, buf, buf_len);
+		}
 	} else {
 		cqe->result = result;
 		cqe->userdata = userdata;
+		cqe->flags = flags;
 		rtio_spsc_produce(r->cq);
 	}
 #ifdef CONFIG_RTIO_SUBMIT_SEM
@@ -52,6 +52,16 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result);
  */
 void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result);
 
+/**
+ * @brief Cancel a SQE
+ *
+ * @param r RTIO context to use
+ * @param sqe RTIO SQE to cancel
+ *
+ * @retval 0 always succeeds
+ */
+int rtio_concurrent_cancel(struct rtio *r, struct rtio_sqe *sqe);
+
 /**
  * @brief Concurrent Executor
  *
@@ -86,7 +96,8 @@ struct rtio_concurrent_executor {
 static const struct rtio_executor_api z_rtio_concurrent_api = {
 	.submit = rtio_concurrent_submit,
 	.ok = rtio_concurrent_ok,
-	.err = rtio_concurrent_err
+	.err = rtio_concurrent_err,
+	.cancel = rtio_concurrent_cancel
 };
 
 /**
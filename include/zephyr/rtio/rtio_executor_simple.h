@@ -51,11 +51,24 @@ void rtio_simple_ok(struct rtio *r, const struct rtio_sqe *sqe, int result);
  */
 void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result);
 
+/**
+ * @brief Cancel a SQE
+ *
+ * @param r RTIO context to use
+ * @param sqe RTIO SQE to cancel
+ *
+ * @retval 0 always succeeds
+ */
+int rtio_simple_cancel(struct rtio *r, struct rtio_sqe *sqe);
+
 /**
  * @brief Simple Executor
  */
 struct rtio_simple_executor {
 	struct rtio_executor ctx;
+
+	/* Lock around cancellation */
+	struct k_spinlock lock;
 };
 
 /**
@@ -64,7 +77,8 @@ struct rtio_simple_executor {
 static const struct rtio_executor_api z_rtio_simple_api = {
 	.submit = rtio_simple_submit,
 	.ok = rtio_simple_ok,
-	.err = rtio_simple_err
+	.err = rtio_simple_err,
+	.cancel = rtio_simple_cancel
 };
 
 /**
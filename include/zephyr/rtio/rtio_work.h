@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_RTIO_RTIO_WORK_H_
+#define ZEPHYR_INCLUDE_RTIO_RTIO_WORK_H_
+
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RTIO Work Queue
+ *
+ * Lets an iodev backed by a blocking driver API complete its submissions
+ * asynchronously, by running the blocking calls on a dedicated work queue
+ * rather than in the submitting context.
+ *
+ * @defgroup rtio_work RTIO Work Queue
+ * @ingroup rtio
+ * @{
+ */
+
+/**
+ * @brief Handler performing a submission with blocking calls
+ *
+ * The handler runs on the RTIO work queue and must complete the submission
+ * with rtio_sqe_ok() or rtio_sqe_err().
+ *
+ * @param sqe Submission to perform
+ * @param r RTIO context
+ */
+typedef void (*rtio_work_handler_t)(const struct rtio_sqe *sqe, struct rtio *r);
+
+/**
+ * @brief Perform a submission on the RTIO work queue
+ *
+ * Can be called from the submit function of an iodev, including from an
+ * ISR. Submissions are performed one at a time in submission order. If all
+ * CONFIG_RTIO_WORKQ_POOL_ITEMS requests are in use, the submission fails
+ * with -ENOMEM. The request of a submission is released once its handler
+ * returns, so the next submission of a chain needs a request of its own.
+ *
+ * @param sqe Submission to perform
+ * @param r RTIO context
+ * @param handler Handler performing the submission
+ */
+void rtio_work_submit(const struct rtio_sqe *sqe, struct rtio *r,
+		      rtio_work_handler_t handler);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_RTIO_RTIO_WORK_H_ */
@@ -324,6 +324,57 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+/**
+ * Start a settings transaction.
+ *
+ * Until @ref settings_transaction_commit or @ref settings_transaction_abort
+ * is called, the values saved by the calling thread with
+ * @ref settings_transaction_stage, @ref settings_save_one,
+ * @ref settings_delete or @ref settings_save are staged in RAM instead of
+ * being written to the storage. Other threads saving or loading settings
+ * wait for the transaction to end.
+ *
+ * @return 0 on success, -EALREADY if the calling thread has already started
+ * a transaction.
+ */
+int settings_transaction_begin(void);
+
+/**
+ * Stage a single serialized value in the transaction of the calling thread.
+ *
+ * A value staged before for the same name is replaced.
+ *
+ * @param name Name/key of the settings item.
+ * @param value Pointer to the value of the settings item, NULL to delete it.
+ * @param val_len Length of the value, 0 to delete the settings item.
+ *
+ * @return 0 on success, -EINVAL if the calling thread has not started a
+ * transaction, -ENOMEM if the value does not fit in
+ * CONFIG_SETTINGS_TRANSACTION_BUF_SIZE.
+ */
+int settings_transaction_stage(const char *name, const void *value,
+			       size_t val_len);
+
+/**
+ * Write the values staged in the transaction of the calling thread and end
+ * the transaction.
+ *
+ * The values are written in a single pass. With the NVS, FCB and file
+ * back-ends, either all of them or none of them are stored in case of a
+ * power loss during the commit.
+ *
+ * @return 0 on success, -EINVAL if the calling thread has not started a
+ * transaction, other non-zero values on failure. The transaction ends in
+ * all cases.
+ */
+int settings_transaction_commit(void);
+
+/**
+ * Drop the values staged in the transaction of the calling thread and end
+ * the transaction.
+ */
+void settings_transaction_abort(void);
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
@@ -447,8 +498,49 @@ struct settings_store_itf {
 	 *  - cs - Corresponding backend handler node
 	 */
 	void *(*csi_storage_get)(struct settings_store *cs);
+
+	int (*csi_save_batch)(struct settings_store *cs, const void *batch,
+			      size_t len);
+	/**< Save the key-value pairs of a transaction to storage, all of them
+	 * or none of them. Optional, @ref settings_store_itf::csi_save is
+	 * called for each pair if not provided.
+	 *
+	 * Parameters:
+	 *  - cs - Corresponding backend handler node
+	 *  - batch - Key-value pairs, read with @ref settings_batch_next
+	 *  - len - Length of batch in bytes.
+	 */
+};
+
+/**
+ * Key-value pair of a settings transaction.
+ */
+struct settings_batch_entry {
+	const char *name;
+	/**< Key in string format. */
+
+	const void *value;
+	/**< Binary value, NULL if the key is deleted. */
+
+	size_t val_len;
+	/**< Length of value in bytes, 0 if the key is deleted. */
 };
 
+/**
+ * Get the next key-value pair of a settings transaction.
+ *
+ * @param[in] batch Key-value pairs passed to
+ *                  @ref settings_store_itf::csi_save_batch.
+ * @param[in] len Length of batch in bytes.
+ * @param[in,out] off Offset of the next key-value pair, start from 0.
+ * @param[out] entry Key-value pair.
+ *
+ * @return 0 on success, -ENOENT if there are no more key-value pairs,
+ * -EINVAL if batch is malformed.
+ */
+int settings_batch_next(const void *batch, size_t len, size_t *off,
+			struct settings_batch_entry *entry);
+
 /**
  * Register a backend handler acting as source.
  *
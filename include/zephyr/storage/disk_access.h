@@ -29,6 +29,9 @@
  */
 
 #include <zephyr/drivers/disk.h>
+#ifdef CONFIG_DISK_CACHE
+#include <zephyr/storage/disk_cache.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Disk block cache API
+ */
+
+#ifndef ZEPHYR_INCLUDE_STORAGE_DISK_CACHE_H_
+#define ZEPHYR_INCLUDE_STORAGE_DISK_CACHE_H_
+
+/**
+ * @brief Disk Cache APIs
+ * @defgroup disk_cache_interface Disk Cache Interface
+ * @ingroup storage_apis
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Disk cache configuration
+ */
+struct disk_cache_config {
+	/**
+	 * Number of sectors read ahead, in the same device transaction, when
+	 * a read misses right after the previous one
+	 */
+	uint16_t read_ahead;
+	/**
+	 * Keep written sectors in the cache until they are evicted or the
+	 * cache is flushed, rather than writing them through
+	 */
+	bool write_back;
+};
+
+/**
+ * @brief Disk cache statistics
+ */
+struct disk_cache_stats {
+	/** Sectors read from the cache */
+	uint32_t hits;
+	/** Sectors missing from the cache */
+	uint32_t misses;
+	/** Read transactions to the device */
+	uint32_t device_reads;
+	/** Write transactions to the device */
+	uint32_t device_writes;
+};
+
+/** @cond INTERNAL_HIDDEN */
+struct disk_cache_entry {
+	uint32_t sector;
+	/* Value of disk_cache::tick when last used, 0 when empty */
+	uint32_t last_used;
+	bool dirty;
+};
+/** @endcond */
+
+/**
+ * @brief Disk cache
+ *
+ * Holds copies of sectors of a disk, each in a slot of the size of a
+ * sector. Define with DISK_CACHE_DEFINE(), the fields are internal.
+ */
+struct disk_cache {
+	struct disk_cache_entry *entries;
+	uint8_t *data;
+	uint16_t num_entries;
+	uint16_t sector_size;
+	struct disk_cache_config cfg;
+	struct disk_cache_stats stats;
+	struct k_mutex lock;
+	uint32_t sector_count;
+	/* Sector following the last read, to detect sequential reads */
+	uint32_t next_sector;
+	uint32_t tick;
+};
+
+/**
+ * @brief Statically define a disk cache
+ *
+ * @param name Name of the cache
+ * @param num_sectors Number of sectors the cache holds
+ * @param sector_sz Size in bytes of the sectors of the disks it is attached
+ *        to
+ */
+#define DISK_CACHE_DEFINE(name, num_sectors, sector_sz)					\
+	BUILD_ASSERT((num_sectors) > 0 && (num_sectors) <= UINT16_MAX,			\
+		     "Invalid number of sectors");					\
+	static struct disk_cache_entry _disk_cache_entries_##name[num_sectors];		\
+	static uint8_t _disk_cache_data_##name[(num_sectors) * (sector_sz)]		\
+		__aligned(sizeof(uint32_t));						\
+	static struct disk_cache name = {						\
+		.entries = _disk_cache_entries_##name,					\
+		.data = _disk_cache_data_##name,					\
+		.num_entries = (num_sectors),						\
+		.sector_size = (sector_sz),						\
+		.lock = Z_MUTEX_INITIALIZER(name.lock),					\
+	}
+
+/**
+ * @brief Attach a cache to a disk
+ *
+ * Reads and writes of the disk through the disk access API then go through
+ * the cache. Reads of more than half the cache go directly to the device.
+ * The cache is flushed by disk_access_ioctl() with DISK_IOCTL_CTRL_SYNC.
+ *
+ * If the disk has no ioctl operation, its sectors are assumed to be of the
+ * size of the cache and are not read ahead.
+ *
+ * @param[in] pdrv Disk name, the disk must be initialized
+ * @param[in] cache Cache, not attached to another disk
+ * @param[in] cfg Configuration of the cache for this disk
+ *
+ * @return 0 on success
+ * @return -EINVAL if the disk is unknown, already has a cache, or the sector
+ *         size of the cache does not match the disk
+ * @return other negative errno code if the disk geometry can't be read
+ */
+int disk_cache_attach(const char *pdrv, struct disk_cache *cache,
+		      const struct disk_cache_config *cfg);
+
+/**
+ * @brief Flush and detach the cache of a disk
+ *
+ * @param[in] pdrv Disk name
+ *
+ * @return 0 on success
+ * @return -EINVAL if the disk is unknown or has no cache
+ * @return other negative errno code if the flush fails, the cache stays
+ *         attached
+ */
+int disk_cache_detach(const char *pdrv);
+
+/**
+ * @brief Get the statistics of the cache of a disk
+ *
+ * @param[in] pdrv Disk name
+ * @param[out] stats Statistics since the cache was attached
+ *
+ * @return 0 on success, -EINVAL if the disk is unknown or has no cache
+ */
+int disk_cache_stats_get(const char *pdrv, struct disk_cache_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_STORAGE_DISK_CACHE_H_ */
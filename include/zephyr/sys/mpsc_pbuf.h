@@ -124,6 +124,14 @@ struct mpsc_pbuf_buffer {
 	/* Store max buffer usage. */
 	uint32_t max_usage;
 
+#ifdef CONFIG_MPSC_PBUF_LOCK_STATS
+	/* Total number of cycles spent acquiring the lock. */
+	uint64_t lock_wait;
+
+	/* Maximum number of cycles spent acquiring the lock. */
+	uint32_t lock_wait_max;
+#endif
+
 	struct k_sem sem;
 };
 
@@ -267,6 +275,20 @@ void mpsc_pbuf_get_utilization(struct mpsc_pbuf_buffer *buffer,
  * retval -ENOTSUP if Collecting utilization data is not supported.
  */
 int mpsc_pbuf_get_max_utilization(struct mpsc_pbuf_buffer *buffer, uint32_t *max);
+
+/** @brief Get the time spent acquiring the buffer lock.
+ *
+ * Requires CONFIG_MPSC_PBUF_LOCK_STATS option.
+ *
+ * @param[in]  buffer Buffer.
+ * @param[out] total  Total number of cycles spent acquiring the lock.
+ * @param[out] max    Maximum number of cycles spent acquiring the lock once.
+ *
+ * retval 0 if lock statistics collected successfully.
+ * retval -ENOTSUP if collecting lock statistics is not supported.
+ */
+int mpsc_pbuf_get_lock_stats(struct mpsc_pbuf_buffer *buffer, uint64_t *total,
+			     uint32_t *max);
 /**
  * @}
  */
@@ -0,0 +1,229 @@
+/* ring_buffer_mp.h: Lock-free multi-producer ring buffer API */
+
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RING_BUFFER_MP_H_
+#define ZEPHYR_INCLUDE_SYS_RING_BUFFER_MP_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bounded by the length field of the record header */
+#define RING_BUFFER_MP_MAX_SIZE 0x4000U
+
+/** Largest record (in bytes), bounded by the size field of the record header */
+#define RING_BUFFER_MP_MAX_RECORD 0xFFFFU
+
+#define RING_BUFFER_MP_SIZE_ASSERT_MSG \
+	"Size must be a power of two not above RING_BUFFER_MP_MAX_SIZE"
+
+/**
+ * @brief A structure to represent a multi-producer ring buffer
+ *
+ * The buffer holds records, each one a header word followed by the data.
+ * Indexes are free running and counted in words.
+ */
+struct ring_buf_mp {
+	atomic_t *buffer;
+	uint32_t size;
+	/* end of the claimed words, advanced by the producers */
+	atomic_t put_head;
+	/* end of the words released by the consumer */
+	atomic_t get_tail;
+	/* start of the next record, private to the consumer */
+	uint32_t get_head;
+	/* length in words of the record claimed by the consumer */
+	uint32_t get_claimed;
+};
+
+/**
+ * @defgroup ring_buffer_mp_apis Multi-producer Ring Buffer APIs
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @brief Define and initialize a multi-producer ring buffer.
+ *
+ * The storage is not placed in a no-init section as free space must read as
+ * zero.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_mp <name>; @endcode
+ *
+ * @param name   Name of the ring buffer.
+ * @param size_w Size of ring buffer (in words of sizeof(atomic_t) bytes),
+ *               a power of two.
+ */
+#define RING_BUF_MP_DECLARE(name, size_w) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(size_w) && \
+		     (size_w) <= RING_BUFFER_MP_MAX_SIZE, \
+		     RING_BUFFER_MP_SIZE_ASSERT_MSG); \
+	static atomic_t _ring_buffer_mp_data_##name[size_w]; \
+	struct ring_buf_mp name = { \
+		.buffer = _ring_buffer_mp_data_##name, \
+		.size = (size_w) \
+	}
+
+/**
+ * @brief Initialize a multi-producer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_MP_DECLARE.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Ring buffer size (in words), a power of two.
+ * @param data Ring buffer data area (atomic_t data[size]).
+ */
+static inline void ring_buf_mp_init(struct ring_buf_mp *buf, uint32_t size,
+				    atomic_t *data)
+{
+	__ASSERT(IS_POWER_OF_TWO(size) && size <= RING_BUFFER_MP_MAX_SIZE,
+		 RING_BUFFER_MP_SIZE_ASSERT_MSG);
+
+	memset(data, 0, size * sizeof(atomic_t));
+	buf->buffer = data;
+	buf->size = size;
+	atomic_set(&buf->put_head, 0);
+	atomic_set(&buf->get_tail, 0);
+	buf->get_head = 0;
+	buf->get_claimed = 0;
+}
+
+/**
+ * @brief Determine if a multi-producer ring buffer is empty.
+ *
+ * Space claimed by a producer but not yet finished counts as used.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+static inline bool ring_buf_mp_is_empty(struct ring_buf_mp *buf)
+{
+	return buf->get_head == (uint32_t)atomic_get(&buf->put_head);
+}
+
+/**
+ * @brief Return multi-producer ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes), including the record headers.
+ */
+static inline uint32_t ring_buf_mp_capacity_get(struct ring_buf_mp *buf)
+{
+	return buf->size * sizeof(atomic_t);
+}
+
+/**
+ * @brief Allocate a record for writing data to a multi-producer ring buffer.
+ *
+ * Counterpart of @ref ring_buf_put_claim which can be called concurrently
+ * from any number of threads and interrupts, without locking. The allocated
+ * area is contiguous and must be committed with @ref ring_buf_mp_put_finish.
+ *
+ * Records are read in the order of their allocation, so the consumer waits
+ * for a record which is allocated but not finished, while other producers
+ * can still allocate the remaining space.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer, aligned to sizeof(atomic_t).
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return @a size, or 0 if there is not enough free space.
+ */
+uint32_t ring_buf_mp_put_claim(struct ring_buf_mp *buf, uint8_t **data,
+			       uint32_t size);
+
+/**
+ * @brief Commit a record allocated with @ref ring_buf_mp_put_claim.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address returned by @ref ring_buf_mp_put_claim.
+ * @param size Number of valid bytes in the record, which can be lower than
+ *	       the allocated size. A record committed with 0 bytes is dropped.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the allocated size.
+ */
+int ring_buf_mp_put_finish(struct ring_buf_mp *buf, uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Write (copy) a record to a multi-producer ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @return @a size, or 0 if there is not enough free space.
+ */
+uint32_t ring_buf_mp_put(struct ring_buf_mp *buf, const uint8_t *data,
+			 uint32_t size);
+
+/**
+ * @brief Get the next record of a multi-producer ring buffer.
+ *
+ * There must be a single consumer, or consumers must be serialized. Once the
+ * data is processed, the record must be freed using
+ * @ref ring_buf_mp_get_finish before the next one is claimed.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ *
+ * @return Number of bytes in the record, or 0 if the ring buffer is empty or
+ *	   the next record is not finished yet.
+ */
+uint32_t ring_buf_mp_get_claim(struct ring_buf_mp *buf, uint8_t **data);
+
+/**
+ * @brief Free the record claimed with @ref ring_buf_mp_get_claim.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL No record is claimed.
+ */
+int ring_buf_mp_get_finish(struct ring_buf_mp *buf);
+
+/**
+ * @brief Read (copy) the next record of a multi-producer ring buffer.
+ *
+ * There must be a single consumer, or consumers must be serialized.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard data.
+ * @param size Size of the output buffer (in bytes).
+ *
+ * @return Number of bytes read.
+ * @retval -EAGAIN Ring buffer is empty or the next record is not finished.
+ * @retval -EMSGSIZE The record is larger than @a size, it is not removed.
+ */
+int ring_buf_mp_get(struct ring_buf_mp *buf, uint8_t *data, uint32_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RING_BUFFER_MP_H_ */
@@ -71,6 +71,9 @@ struct z_heap_stress_result {
 /**
  * @brief Get the runtime statistics of a sys_heap
  *
+ * With CONFIG_HEAP_MAGAZINE, the blocks cached in the magazines of a
+ * k_heap count as allocated, see k_heap_magazine_flush().
+ *
  * @param heap Pointer to specified sys_heap
  * @param stats_t Pointer to struct to copy statistics into
  * @return -EINVAL if null pointers, otherwise 0
@@ -20,6 +20,28 @@ extern "C" {
  * @{
  */
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+/**
+ * @brief Lock-free access state of a channel.
+ *
+ * The message is double buffered. A publisher writes the buffer readers are not using and
+ * then makes it the current one, readers copy the current buffer and retry if it was
+ * overwritten meanwhile.
+ */
+struct zbus_channel_seqlock {
+	/** Twice the number of completed publications, plus one while a publication is in
+	 * progress.
+	 */
+	atomic_t seq;
+
+	/** Serializes the publishers, which can run in threads and ISRs. */
+	struct k_spinlock lock;
+
+	/** Second message buffer. */
+	void *const message;
+};
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 /**
  * @brief Type used to represent a channel.
  *
@@ -61,6 +83,13 @@ struct zbus_channel {
 	sys_slist_t *runtime_observers;
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE  */
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+	/** Lock-free access state. Only set for channels defined with
+	 * ZBUS_CHAN_SEQLOCK_DEFINE, whose message is published and read without the mutex.
+	 */
+	struct zbus_channel_seqlock *const seqlock;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 	/** Channel observer list. Represents the channel's observers list, it can be empty or
 	 * have listeners and subscribers mixed in any sequence.
 	 */
@@ -77,7 +106,8 @@ struct zbus_channel {
  * field of the structure. The listeners have a callback function that is executed by the
  * bus with the index of the changed channel as argument when the notification is sent.
  * The subscribers have a message queue where the bus enqueues the index of the changed
- * channel when a notification is sent.
+ * channel when a notification is sent. The message subscribers have a FIFO where the bus
+ * enqueues a copy of the channel's message when a notification is sent.
  *
  * @see zbus_obs_set_enable function to properly change the observer's enabled field.
  *
@@ -94,6 +124,11 @@ struct zbus_observer {
 
 	/** Observer callback function. It turns the observer into a listener. */
 	void (*const callback)(const struct zbus_channel *chan);
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+	/** Observer message FIFO. It turns the observer into a message subscriber. */
+	struct k_fifo *const message_fifo;
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -134,6 +169,12 @@ struct zbus_observer {
 #define ZBUS_RUNTIME_OBSERVERS_LIST_INIT(_slist_name) /* No runtime observers */
 #endif
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+#define ZBUS_CHANNEL_SEQLOCK_INIT(_seqlock) .seqlock = (_seqlock),
+#else
+#define ZBUS_CHANNEL_SEQLOCK_INIT(_seqlock)
+#endif
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS)
 #define _ZBUS_STRUCT_DECLARE(_type, _name) STRUCT_SECTION_ITERABLE(_type, _name)
 #else
@@ -147,6 +188,34 @@ struct zbus_observer {
 #define ZBUS_REF(_value) &(_value)
 
 k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
+
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+/* Buffer holding the last message published before the given sequence value */
+static inline void *_zbus_seqlock_msg(const struct zbus_channel *chan, atomic_val_t seq)
+{
+	return ((seq >> 1) & 1) ? chan->seqlock->message : chan->message;
+}
+#endif
+
+#define _ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val,       \
+			  _seqlock)                                                          \
+	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
+	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
+	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
+	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), _observers)                            \
+	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
+	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), _observers) NULL};                             \
+	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
+		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
+		.message_size = sizeof(_type),	               /* Message size */            \
+		.user_data = _user_data,		       /* User data */               \
+		.message = &_CONCAT(_zbus_message_, _name),    /* Reference to the message */\
+		.validator = (_validator),		       /* Validator function */      \
+		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
+		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
+			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
+		ZBUS_CHANNEL_SEQLOCK_INIT(_seqlock)            /* Lock-free access state */  \
+		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
 /** @endcond */
 
 /**
@@ -192,22 +261,39 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
  * @param _init_val The message initialization.
  */
 #define ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val)        \
-	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
-	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
-	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
-	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), _observers)                            \
-	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
-	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), _observers) NULL};                             \
-	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
-		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
-		.message_size = sizeof(_type),	               /* Message size */            \
-		.user_data = _user_data,		       /* User data */               \
-		.message = &_CONCAT(_zbus_message_, _name),    /* Reference to the message */\
-		.validator = (_validator),		       /* Validator function */      \
-		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
-		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
-			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
-		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val, NULL)
+
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+/**
+ * @brief Zbus lock-free channel definition.
+ *
+ * This macro defines a channel that can be published and read from threads and ISRs without
+ * taking the channel's mutex. Publishers are serialized by a spinlock held only while the
+ * message is copied, and readers never block: zbus_chan_read retries when the message
+ * changed while it was being copied. The message is stored twice, so only two publications
+ * completing during a single read make the reader retry.
+ *
+ * Lock-free channels cannot be claimed and do not support runtime observers. Listeners get
+ * the last published message with zbus_chan_const_msg, which a concurrent publication can
+ * change, so a listener needing a consistent message should use zbus_chan_read instead.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list. The sequence indicates the priority of the observer. The
+ * first the highest priority.
+ * @param _init_val The message initialization.
+ *
+ * @see ZBUS_CHAN_DEFINE
+ */
+#define ZBUS_CHAN_SEQLOCK_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val) \
+	static _type _CONCAT(_zbus_message_alt_, _name) = _init_val;                         \
+	static struct zbus_channel_seqlock _CONCAT(_zbus_seqlock_, _name) = {                \
+		.message = &_CONCAT(_zbus_message_alt_, _name)};                             \
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val,       \
+			  &_CONCAT(_zbus_seqlock_, _name))
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
 
 /**
  * @brief Initialize a message.
@@ -241,6 +327,29 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
 					       .enabled = true,                                    \
 				       .queue = &_zbus_observer_queue_##_name, .callback = NULL}
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+/**
+ * @brief Define and initialize a message subscriber.
+ *
+ * This macro defines an observer of message subscriber type. It defines a FIFO where the
+ * message subscriber will receive its own copy of every message published to the channels it
+ * observes, so no message is lost when the subscriber is slower than the publishers. The
+ * copies come from a net_buf pool shared by all the message subscribers, the message is
+ * copied once per publication and its buffer is reference counted among the subscribers.
+ *
+ * @param[in] _name The message subscriber's name.
+ *
+ * @see zbus_sub_wait_msg
+ */
+#define ZBUS_MSG_SUBSCRIBER_DEFINE(_name)                                                          \
+	K_FIFO_DEFINE(_zbus_observer_fifo_##_name);                                                \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       .enabled = true,                                    \
+				       .queue = NULL, .callback = NULL,                            \
+				       .message_fifo = &_zbus_observer_fifo_##_name}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 /**
  * @brief Define and initialize a listener.
  *
@@ -274,9 +383,13 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
  * observers could not receive the notification.
  * @retval -EBUSY The channel is busy.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -ENOMEM No buffer was available to copy the message for a message subscriber.
  * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
  * observer, or the function context is invalid (inside an ISR). The function only returns this
  * value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ *
+ * @note Lock-free channels can also be published from ISRs, the timeout is then ignored and
+ * subscribers are notified without waiting.
  */
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout);
 
@@ -296,6 +409,9 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
  * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ *
+ * @note Lock-free channels can also be read from ISRs. The read is retried while the message
+ * changes under the reader, -EAGAIN is returned if that still happens once the timeout expired.
  */
 int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeout);
 
@@ -317,6 +433,7 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
  * @retval 0 Channel claimed.
  * @retval -EBUSY The channel is busy.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -ENOTSUP The channel is a lock-free channel.
  * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
  * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
  */
@@ -335,6 +452,7 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout);
  * @retval 0 Channel finished.
  * @retval -EPERM The channel was claimed by other thread.
  * @retval -EINVAL The channel's mutex is not locked.
+ * @retval -ENOTSUP The channel is a lock-free channel.
  * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
  * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
  */
@@ -354,6 +472,7 @@ int zbus_chan_finish(const struct zbus_channel *chan);
  * @retval -EPERM The current thread does not own the channel.
  * @retval -EBUSY The channel's mutex returned without waiting.
  * @retval -EAGAIN Timeout to acquiring the channel's mutex.
+ * @retval -ENOMEM No buffer was available to copy the message for a message subscriber.
  * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
  * observer, or the function context is invalid (inside an ISR). The function only returns this
  * value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
@@ -417,6 +536,12 @@ static inline const void *zbus_chan_const_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (chan->seqlock != NULL) {
+		return _zbus_seqlock_msg(chan, atomic_get(&chan->seqlock->seq));
+	}
+#endif
+
 	return chan->message;
 }
 
@@ -469,6 +594,7 @@ static inline void *zbus_chan_user_data(const struct zbus_channel *chan)
  * @retval -ENOMEM Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EINVAL Some parameter is invalid.
+ * @retval -ENOTSUP The channel is a lock-free channel.
  */
 int zbus_chan_add_obs(const struct zbus_channel *chan, const struct zbus_observer *obs,
 		      k_timeout_t timeout);
@@ -576,6 +702,30 @@ static inline const char *zbus_obs_name(const struct zbus_observer *obs)
 int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **chan,
 		  k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+/**
+ * @brief Wait for a channel message.
+ *
+ * This routine makes the message subscriber to wait for a message. The message comes with the
+ * reference of the channel it was published to, in the order the notifications were sent.
+ *
+ * @param[in] sub The message subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] msg Reference to the message where the routine copies the received message to.
+ * It must be as large as the channel's message.
+ * @param[in] timeout Waiting period for a message arrival,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting or waiting period timed out.
+ * @retval -EINVAL The observer is not a message subscriber.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
+		      k_timeout_t timeout);
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS) || defined(__DOXYGEN__)
 /**
  *
@@ -42,7 +42,7 @@ GEN_OFFSET_SYM(_cpu_t, fp_ctx);
 GEN_OFFSET_SYM(_kernel_t, idle);
 #endif
 
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PERCPU)
 GEN_OFFSET_SYM(_kernel_t, ready_q);
 #endif
 
@@ -9,12 +9,17 @@
 #include <zephyr/wait_q.h>
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
+#include <string.h>
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
 
+#ifdef CONFIG_HEAP_MAGAZINE
+	memset(h->mag, 0, sizeof(h->mag));
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
 
@@ -61,12 +66,183 @@ SYS_INIT_NAMED(statics_init_pre, statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_
 SYS_INIT_NAMED(statics_init_post, statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
+#ifdef CONFIG_HEAP_MAGAZINE
+/* Blocks moved between a magazine and the heap at once */
+#define MAG_BATCH (CONFIG_HEAP_MAGAZINE_DEPTH / 2)
+
+static inline size_t mag_class_size(int cls)
+{
+	return (size_t)16 << cls;
+}
+
+/* Smallest class serving an allocation, or -1 */
+static int mag_alloc_class(size_t bytes)
+{
+	for (int cls = 0; cls < CONFIG_HEAP_MAGAZINE_CLASSES; cls++) {
+		if (bytes <= mag_class_size(cls)) {
+			return cls;
+		}
+	}
+
+	return -1;
+}
+
+/* Class a freed block can be cached in, or -1.  Blocks more than
+ * twice as large as the largest class they fit are not cached, they
+ * would waste too much memory while serving small allocations.
+ */
+static int mag_free_class(size_t usable)
+{
+	for (int cls = CONFIG_HEAP_MAGAZINE_CLASSES - 1; cls >= 0; cls--) {
+		if (usable >= mag_class_size(cls)) {
+			return usable < 2 * mag_class_size(cls) ? cls : -1;
+		}
+	}
+
+	return -1;
+}
+
+/* Each magazine has its own lock, so using the magazine of another
+ * CPU after a migration is harmless; it is only slower.
+ */
+static inline struct z_heap_magazine *mag_get(struct k_heap *h)
+{
+	return &h->mag[arch_curr_cpu()->id];
+}
+
+/* Wake up the threads waiting for memory after blocks were returned
+ * to the heap, the heap lock must be held and is released.
+ */
+static void mag_unpend(struct k_heap *h, k_spinlock_key_t key)
+{
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+}
+
+static void *mag_alloc(struct k_heap *h, size_t bytes)
+{
+	struct z_heap_magazine *mag = mag_get(h);
+	int cls = mag_alloc_class(bytes);
+	k_spinlock_key_t key, hkey;
+	void *ret = NULL;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&mag->lock);
+
+	if (mag->count[cls] == 0U) {
+		hkey = k_spin_lock(&h->lock);
+
+		while (mag->count[cls] < MAG_BATCH) {
+			void *mem = sys_heap_alloc(&h->heap, mag_class_size(cls));
+
+			if (mem == NULL) {
+				break;
+			}
+
+			mag->blocks[cls][mag->count[cls]++] = mem;
+		}
+
+		k_spin_unlock(&h->lock, hkey);
+	}
+
+	if (mag->count[cls] != 0U) {
+		ret = mag->blocks[cls][--mag->count[cls]];
+	}
+
+	k_spin_unlock(&mag->lock, key);
+
+	return ret;
+}
+
+/* Returns false if the block has to be freed to the heap */
+static bool mag_free(struct k_heap *h, void *mem)
+{
+	struct z_heap_magazine *mag = mag_get(h);
+	int cls = mag_free_class(sys_heap_usable_size(&h->heap, mem));
+	void *flush[MAG_BATCH];
+	k_spinlock_key_t key;
+	int n = 0;
+
+	/* Waiters must be woken up by a free to the heap */
+	if ((cls < 0) || (z_waitq_head(&h->wait_q) != NULL)) {
+		return false;
+	}
+
+	key = k_spin_lock(&mag->lock);
+
+	if (mag->count[cls] == CONFIG_HEAP_MAGAZINE_DEPTH) {
+		/* Flush the blocks cached longest, keep the hot ones */
+		n = MAG_BATCH;
+		memcpy(flush, mag->blocks[cls], sizeof(flush));
+		memmove(mag->blocks[cls], &mag->blocks[cls][n],
+			(CONFIG_HEAP_MAGAZINE_DEPTH - n) * sizeof(void *));
+		mag->count[cls] -= n;
+	}
+
+	mag->blocks[cls][mag->count[cls]++] = mem;
+
+	k_spin_unlock(&mag->lock, key);
+
+	if (n != 0) {
+		key = k_spin_lock(&h->lock);
+
+		for (int i = 0; i < n; i++) {
+			sys_heap_free(&h->heap, flush[i]);
+		}
+
+		mag_unpend(h, key);
+	}
+
+	return true;
+}
+
+void k_heap_magazine_flush(struct k_heap *h)
+{
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		struct z_heap_magazine *mag = &h->mag[cpu];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+		k_spinlock_key_t hkey = k_spin_lock(&h->lock);
+
+		for (int cls = 0; cls < CONFIG_HEAP_MAGAZINE_CLASSES; cls++) {
+			while (mag->count[cls] != 0U) {
+				sys_heap_free(&h->heap,
+					      mag->blocks[cls][--mag->count[cls]]);
+			}
+		}
+
+		k_spin_unlock(&h->lock, hkey);
+		k_spin_unlock(&mag->lock, key);
+	}
+
+	mag_unpend(h, k_spin_lock(&h->lock));
+}
+#endif /* CONFIG_HEAP_MAGAZINE */
+
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	int64_t now, end = sys_clock_timeout_end_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_HEAP_MAGAZINE
+	bool flushed = false;
+
+	if (align <= sizeof(void *)) {
+		ret = mag_alloc(h, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+			return ret;
+		}
+	}
+#endif
+
 	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
 
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
@@ -80,6 +256,17 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_HEAP_MAGAZINE
+		/* Give the cached blocks back before failing or blocking */
+		if ((ret == NULL) && !flushed) {
+			flushed = true;
+			k_spin_unlock(&h->lock, key);
+			k_heap_magazine_flush(h);
+			key = k_spin_lock(&h->lock);
+			continue;
+		}
+#endif
+
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || ((end - now) <= 0)) {
@@ -120,6 +307,13 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_HEAP_MAGAZINE
+	if ((mem != NULL) && mag_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
@@ -200,7 +200,9 @@ static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
 
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_PERCPU)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 	int cpu, m = thread->base.cpu_mask;
 
 	/* Edge case: it's legal per the API to "make runnable" a
@@ -219,15 +221,63 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PERCPU)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_PERCPU
+static ALWAYS_INLINE bool cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif
+}
+
+/* Pick the CPU whose run queue a thread being made runnable goes to.
+ * An idle CPU the thread may run on is preferred as it can pick the
+ * thread up immediately.  Otherwise the thread stays on the CPU that
+ * last ran it (or requeues itself, for _current) to keep its cache
+ * footprint local.  Other CPUs steal from this queue when they have
+ * nothing better to run, see runq_best().
+ */
+static ALWAYS_INLINE int runq_select_cpu(struct k_thread *thread)
+{
+	int cpu = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+
+	if (thread == _current && cpu_allowed(thread, cpu)) {
+		return cpu;
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		/* CPUs not started yet have no current thread */
+		if (curr != NULL && cpu_allowed(thread, i) &&
+		    z_is_idle_thread_object(curr)) {
+			return i;
+		}
+	}
+
+	if (thread->base.runq_cpu < num_cpus &&
+	    cpu_allowed(thread, thread->base.runq_cpu)) {
+		return thread->base.runq_cpu;
+	}
+
+	return cpu;
+}
+#endif /* CONFIG_SCHED_PERCPU */
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_PERCPU
+	thread->base.runq_cpu = runq_select_cpu(thread);
+#endif
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -238,7 +288,33 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PERCPU
+	/* Take the best thread of the local queue, unless another CPU's
+	 * queue holds a thread we may run with a strictly higher
+	 * priority, in which case steal that one.  Ties stay local.
+	 */
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+	unsigned int num_cpus = arch_num_cpus();
+	int cpu = _current_cpu->id;
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *thread;
+
+		if (i == cpu) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if (thread != NULL && cpu_allowed(thread, cpu) &&
+		    (best == NULL || z_sched_prio_cmp(thread, best) > 0)) {
+			best = thread;
+		}
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -387,6 +463,11 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		dequeue_thread(thread);
 	}
 
+#ifdef CONFIG_SCHED_PERCPU
+	/* Not in any run queue now, remember where it runs */
+	thread->base.runq_cpu = _current_cpu->id;
+#endif
+
 	_current_cpu->swap_ok = false;
 	return thread;
 #endif
@@ -616,6 +697,38 @@ static void flag_ipi(void)
 #endif
 }
 
+/* True if another CPU would switch to the newly readied thread, i.e.
+ * if an IPI is needed to get it running there.  Without per-CPU run
+ * queues every ready operation raises the IPI, as before.
+ */
+static bool ready_needs_ipi(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_PERCPU
+	int currcpu = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if (i == currcpu || curr == NULL || !cpu_allowed(thread, i)) {
+			continue;
+		}
+
+		if (z_is_idle_thread_object(curr) ||
+		    ((is_preempt(curr) || is_metairq(thread)) &&
+		     z_sched_prio_cmp(thread, curr) > 0)) {
+			return true;
+		}
+	}
+
+	return false;
+#else
+	ARG_UNUSED(thread);
+
+	return true;
+#endif
+}
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -630,7 +743,9 @@ static void ready_thread(struct k_thread *thread)
 
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		if (ready_needs_ipi(thread)) {
+			flag_ipi();
+		}
 	}
 }
 
@@ -1286,7 +1401,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1296,7 +1411,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PERCPU)
 	unsigned int num_cpus = arch_num_cpus();
 
 	for (int i = 0; i < num_cpus; i++) {
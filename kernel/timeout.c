@@ -11,10 +11,13 @@
 #include <zephyr/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +39,348 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+/* Hierarchical timing wheel.  Each timeout stores its absolute
+ * expiration tick in dticks.  Level L has WHEEL_SLOTS slots, each
+ * covering BIT(WHEEL_BITS * L) ticks, and a timeout expiring less
+ * than BIT(WHEEL_BITS * (L + 1)) ticks after wheel_tick lives in level
+ * L.  When wheel_tick crosses a slot boundary of level L the slot is
+ * "cascaded", i.e. its timeouts are redistributed over the lower
+ * levels, so level 0 slots only ever hold timeouts expiring exactly at
+ * the tick they represent.  Timeouts too far in the future for the top
+ * level wait in a sorted overflow list.
+ *
+ * Adding and aborting a timeout are O(1).  The time to the earliest
+ * expiration (needed for tickless operation) is cached and only
+ * recomputed, by scanning one slot per level, after the earliest
+ * timeout was removed.  Empty stretches of time are skipped using
+ * the per-level slot bitmaps, so a long tickless idle period is
+ * announced without walking all the ticks in between.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_RANGE BIT64(WHEEL_BITS * WHEEL_LEVELS)
+
+BUILD_ASSERT(WHEEL_SLOTS <= 64, "slot bitmap is 64 bit wide");
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+/* Non-empty slots, the lists of empty slots are not initialized */
+static uint64_t wheel_map[WHEEL_LEVELS];
+
+static sys_dlist_t wheel_far = SYS_DLIST_STATIC_INIT(&wheel_far);
+
+/* Tick the wheel has been advanced to, runs ahead of curr_tick only
+ * while sys_clock_announce() looks for the next expired timeout
+ */
+static uint64_t wheel_tick;
+
+/* Cached earliest expiration tick, UINT64_MAX if none */
+static uint64_t wheel_first = UINT64_MAX;
+static bool wheel_first_valid = true;
+
+static inline uint64_t expiry(const struct _timeout *t)
+{
+	return (uint64_t)t->dticks;
+}
+
+/* First non-empty slot of a level at or after slot "from", circularly */
+static int wheel_next_slot(int level, unsigned int from)
+{
+	uint64_t map = wheel_map[level];
+
+	if (map == 0U) {
+		return -1;
+	}
+
+	map = (map >> from) | (map << ((WHEEL_SLOTS - from) & WHEEL_MASK));
+
+	return (from + u64_count_trailing_zeros(map)) & WHEEL_MASK;
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t delta;
+	int level = 0;
+	int slot;
+
+	if (expiry(to) < wheel_tick) {
+		to->dticks = wheel_tick;
+	}
+
+	delta = expiry(to) - wheel_tick;
+
+	if (delta >= WHEEL_RANGE) {
+		struct _timeout *t;
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&wheel_far, t, node) {
+			if (expiry(t) > expiry(to)) {
+				sys_dlist_insert(&t->node, &to->node);
+				return;
+			}
+		}
+
+		sys_dlist_append(&wheel_far, &to->node);
+		return;
+	}
+
+	while (delta >= BIT64(WHEEL_BITS * (level + 1))) {
+		level++;
+	}
+
+	slot = (expiry(to) >> (WHEEL_BITS * level)) & WHEEL_MASK;
+
+	if ((wheel_map[level] & BIT64(slot)) == 0U) {
+		sys_dlist_init(&wheel[level][slot]);
+		wheel_map[level] |= BIT64(slot);
+	}
+
+	sys_dlist_append(&wheel[level][slot], &to->node);
+}
+
+static void wheel_remove(struct _timeout *to)
+{
+	sys_dnode_t *node = &to->node;
+
+	/* Last node of a slot: both neighbors are the slot list head */
+	if ((node->next == node->prev) && (node->next != &wheel_far)) {
+		int idx = (sys_dlist_t *)node->next - &wheel[0][0];
+
+		wheel_map[idx / WHEEL_SLOTS] &= ~BIT64(idx % WHEEL_SLOTS);
+	}
+
+	sys_dlist_remove(node);
+
+	if (wheel_first_valid && (expiry(to) == wheel_first)) {
+		wheel_first_valid = false;
+	}
+}
+
+static uint64_t wheel_earliest(void)
+{
+	struct _timeout *t;
+
+	if (wheel_first_valid) {
+		return wheel_first;
+	}
+
+	wheel_first = UINT64_MAX;
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		unsigned int idx = (wheel_tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+		int slot;
+
+		/* Slot idx is due now in level 0, but holds the timeouts
+		 * of the next revolution in the upper levels
+		 */
+		slot = wheel_next_slot(level, level == 0 ? idx : (idx + 1) & WHEEL_MASK);
+		if (slot < 0) {
+			continue;
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&wheel[level][slot], t, node) {
+			wheel_first = MIN(wheel_first, expiry(t));
+		}
+	}
+
+	t = SYS_DLIST_PEEK_HEAD_CONTAINER(&wheel_far, t, node);
+	if (t != NULL) {
+		wheel_first = MIN(wheel_first, expiry(t));
+	}
+
+	wheel_first_valid = true;
+
+	return wheel_first;
+}
+
+/* Next tick after wheel_tick at which a level 0 slot expires, an upper
+ * level slot must be cascaded or overflow timeouts enter the wheel
+ */
+static uint64_t wheel_next_event(void)
+{
+	uint64_t next = UINT64_MAX;
+	struct _timeout *t;
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		unsigned int shift = WHEEL_BITS * level;
+		unsigned int idx = (wheel_tick >> shift) & WHEEL_MASK;
+		uint64_t steps;
+		int slot;
+
+		slot = wheel_next_slot(level, (idx + 1) & WHEEL_MASK);
+		if (slot < 0) {
+			continue;
+		}
+
+		steps = ((slot - idx - 1) & WHEEL_MASK) + 1;
+		next = MIN(next, ((wheel_tick >> shift) + steps) << shift);
+	}
+
+	t = SYS_DLIST_PEEK_HEAD_CONTAINER(&wheel_far, t, node);
+	if (t != NULL) {
+		next = MIN(next, MAX(expiry(t) - (WHEEL_RANGE - 1),
+				     wheel_tick + 1));
+	}
+
+	return next;
+}
+
+/* Redistribute the upper level slots starting at wheel_tick */
+static void wheel_cascade(void)
+{
+	struct _timeout *t;
+	sys_dnode_t *node;
+
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		unsigned int shift = WHEEL_BITS * level;
+		int slot = (wheel_tick >> shift) & WHEEL_MASK;
+		sys_dlist_t *list = &wheel[level][slot];
+
+		if (((wheel_tick & (BIT64(shift) - 1)) != 0U) ||
+		    ((wheel_map[level] & BIT64(slot)) == 0U)) {
+			continue;
+		}
+
+		wheel_map[level] &= ~BIT64(slot);
+
+		while ((node = sys_dlist_get(list)) != NULL) {
+			wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+
+	for (t = SYS_DLIST_PEEK_HEAD_CONTAINER(&wheel_far, t, node);
+	     (t != NULL) && (expiry(t) - wheel_tick < WHEEL_RANGE);
+	     t = SYS_DLIST_PEEK_HEAD_CONTAINER(&wheel_far, t, node)) {
+		sys_dlist_remove(&t->node);
+		wheel_insert(t);
+	}
+}
+
+/* Advance the wheel up to tick "end", stopping at the first tick that
+ * has an expired timeout.  Returns that timeout or NULL.
+ */
+static struct _timeout *wheel_advance(uint64_t end)
+{
+	for (;;) {
+		int slot = wheel_tick & WHEEL_MASK;
+		uint64_t next;
+
+		if ((wheel_map[0] & BIT64(slot)) != 0U) {
+			sys_dnode_t *node = sys_dlist_peek_head(&wheel[0][slot]);
+
+			return CONTAINER_OF(node, struct _timeout, node);
+		}
+
+		next = wheel_next_event();
+		if (next > end) {
+			wheel_tick = end;
+			return NULL;
+		}
+
+		wheel_tick = next;
+		wheel_cascade();
+	}
+}
+
+#ifdef CONFIG_ZTEST
+/* Move the wheel to another tick, keeping the remaining time of all
+ * pending timeouts
+ */
+static void wheel_rebase(uint64_t tick)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	int64_t shift = tick - wheel_tick;
+	sys_dnode_t *node;
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+			if ((wheel_map[level] & BIT64(slot)) == 0U) {
+				continue;
+			}
+
+			while ((node = sys_dlist_get(&wheel[level][slot])) != NULL) {
+				sys_dlist_append(&pending, node);
+			}
+		}
+
+		wheel_map[level] = 0U;
+	}
+
+	while ((node = sys_dlist_get(&wheel_far)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	wheel_tick = tick;
+	wheel_first_valid = false;
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks += shift;
+		wheel_insert(t);
+	}
+}
+#endif /* CONFIG_ZTEST */
+
+/* Queue a timeout expiring "ticks" after curr_tick, returns true if
+ * it is now the first one to expire
+ */
+static bool queue_add(struct _timeout *to, k_ticks_t ticks)
+{
+	uint64_t first = wheel_earliest();
+
+	to->dticks = curr_tick + ticks;
+	wheel_insert(to);
+
+	if (expiry(to) < first) {
+		wheel_first = expiry(to);
+		return true;
+	}
+
+	return false;
+}
+
+static void queue_remove(struct _timeout *to)
+{
+	wheel_remove(to);
+}
+
+static void queue_pop_expired(struct _timeout *to)
+{
+	wheel_remove(to);
+}
+
+/* Ticks from curr_tick until the timeout expires */
+static k_ticks_t queue_ticks(const struct _timeout *to)
+{
+	return expiry(to) - curr_tick;
+}
+
+static k_ticks_t queue_first_ticks(void)
+{
+	uint64_t first = wheel_earliest();
+
+	return first == UINT64_MAX ? K_TICKS_FOREVER : first - curr_tick;
+}
+
+/* First timeout expiring within "ticks" after curr_tick, or NULL */
+static struct _timeout *queue_expired(int32_t ticks)
+{
+	return wheel_advance(curr_tick + ticks);
+}
+
+/* All expired timeouts were handled, the rest of the announced ticks
+ * is accounted for by moving curr_tick
+ */
+static void queue_announced(int32_t ticks)
+{
+	ARG_UNUSED(ticks);
+}
+
+#else /* CONFIG_TIMEOUT_WHEEL */
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +404,81 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static bool queue_add(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+static void queue_remove(struct _timeout *to)
+{
+	remove_timeout(to);
+}
+
+/* curr_tick already moved to the expiration of the first timeout, so
+ * the following ones keep their delta
+ */
+static void queue_pop_expired(struct _timeout *to)
+{
+	to->dticks = 0;
+	remove_timeout(to);
+}
+
+static k_ticks_t queue_ticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static k_ticks_t queue_first_ticks(void)
+{
+	struct _timeout *to = first();
+
+	return to == NULL ? K_TICKS_FOREVER : to->dticks;
+}
+
+static struct _timeout *queue_expired(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	return (t != NULL) && (t->dticks <= ticks) ? t : NULL;
+}
+
+static void queue_announced(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -66,15 +486,15 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t first = queue_first_ticks();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((first == K_TICKS_FOREVER) ||
+	    ((int64_t)(first - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, first - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,31 +520,16 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first()) {
+		if (queue_add(to, ticks)) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -153,7 +558,7 @@ int z_abort_timeout(struct _timeout *to)
 
 	LOCKED(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
+			queue_remove(to);
 			ret = 0;
 		}
 	}
@@ -164,20 +569,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return queue_ticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -258,16 +654,15 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	struct _timeout *t = first();
+	struct _timeout *t;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+	for (t = queue_expired(announce_remaining);
+	     t != NULL;
+	     t = queue_expired(announce_remaining)) {
+		int dt = queue_ticks(t);
 
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		queue_pop_expired(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -275,9 +670,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
+	queue_announced(announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -386,7 +779,14 @@ uint64_t sys_clock_timeout_end_calc(k_timeout_t timeout)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_WHEEL
+	LOCKED(&timeout_lock) {
+		wheel_rebase(tick);
+		curr_tick = tick;
+	}
+#else
 	curr_tick = tick;
+#endif
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
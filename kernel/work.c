@@ -224,6 +224,16 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 
 	if (queue != NULL) {
 		rv = z_sched_wake(&queue->notifyq, 0, NULL);
+#ifdef CONFIG_WORKQUEUE_POOL
+		/* The queue thread is busy: wake an idle thread of the pool
+		 * so that it takes the work.
+		 */
+		if (!rv && (queue->pool != NULL)) {
+			for (uint32_t i = 0; !rv && (i < queue->pool->num_queues); i++) {
+				rv = z_sched_wake(&queue->pool->queues[i].notifyq, 0, NULL);
+			}
+		}
+#endif
 	}
 
 	return rv;
@@ -592,6 +602,71 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+static inline bool is_flusher(const struct k_work *work)
+{
+	return work->handler == handle_flush;
+}
+
+/* Take the oldest work item pending on another queue of the pool.
+ *
+ * Work that is running on the other queue is left in place to prevent
+ * handler re-entrancy.  Flushers queued behind the taken work move with it
+ * to the head of @p queue, so they complete once it has run.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue of the calling thread, which has no pending work.
+ *
+ * @return the node of the taken work, no longer on any list, or NULL.
+ */
+static sys_snode_t *pool_steal_locked(struct k_work_q *queue)
+{
+	struct k_work_q_pool *pool = queue->pool;
+	uint32_t idx = queue - pool->queues;
+
+	for (uint32_t i = 1; i < pool->num_queues; i++) {
+		struct k_work_q *victim = &pool->queues[(idx + i) % pool->num_queues];
+		sys_snode_t *prev = NULL;
+		sys_snode_t *node;
+		struct k_work *work = NULL;
+
+		SYS_SLIST_FOR_EACH_NODE(&victim->pending, node) {
+			work = CONTAINER_OF(node, struct k_work, node);
+			if (!is_flusher(work) &&
+			    !flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+				break;
+			}
+			prev = node;
+		}
+
+		if (node == NULL) {
+			continue;
+		}
+
+		sys_slist_remove(&victim->pending, prev, node);
+		work->queue = queue;
+
+		while (true) {
+			sys_snode_t *next = (prev != NULL) ? sys_slist_peek_next(prev)
+					    : sys_slist_peek_head(&victim->pending);
+
+			if ((next == NULL) ||
+			    !is_flusher(CONTAINER_OF(next, struct k_work, node))) {
+				break;
+			}
+
+			sys_slist_remove(&victim->pending, prev, next);
+			sys_slist_prepend(&queue->pending, next);
+		}
+
+		return node;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -609,6 +684,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
+#ifdef CONFIG_WORKQUEUE_POOL
+		if ((node == NULL) && (queue->pool != NULL)) {
+			node = pool_steal_locked(queue);
+		}
+#endif
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -703,19 +783,22 @@ void k_work_queue_init(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+/* Start a work queue thread, optionally pinned to a CPU.
+ *
+ * @param cpu the CPU to pin the thread to, or -1.
+ */
+static void work_queue_start(struct k_work_q *queue,
+			     k_thread_stack_t *stack,
+			     size_t stack_size,
+			     int prio,
+			     const struct k_work_queue_config *cfg,
+			     int cpu)
 {
 	__ASSERT_NO_MSG(queue);
 	__ASSERT_NO_MSG(stack);
 	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
 	uint32_t flags = K_WORK_QUEUE_STARTED;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
-
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
@@ -738,11 +821,84 @@ void k_work_queue_start(struct k_work_q *queue,
 		k_thread_name_set(&queue->thread, cfg->name);
 	}
 
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&queue->thread, cpu);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif
+
 	k_thread_start(&queue->thread);
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	work_queue_start(queue, stack, stack_size, prio, cfg, -1);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_pool_start(struct k_work_q_pool *pool,
+			     struct k_work_q *queues,
+			     uint32_t num_queues,
+			     k_thread_stack_t *stacks,
+			     size_t stack_size,
+			     int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(pool);
+	__ASSERT_NO_MSG(queues);
+	__ASSERT_NO_MSG(num_queues > 0U);
+
+	size_t stack_len = K_THREAD_STACK_LEN(stack_size);
+	bool pin = (num_queues == arch_num_cpus());
+
+	pool->queues = queues;
+	pool->num_queues = num_queues;
+
+	/* Attach all the queues before any thread starts stealing. */
+	for (uint32_t i = 0; i < num_queues; i++) {
+		k_work_queue_init(&queues[i]);
+		queues[i].pool = pool;
+	}
+
+	for (uint32_t i = 0; i < num_queues; i++) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, &queues[i]);
+
+		work_queue_start(&queues[i], &stacks[stack_len * i], stack_size,
+				 prio, cfg, pin ? (int)i : -1);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, &queues[i]);
+	}
+}
+
+struct k_work_q *k_work_queue_pool_get(struct k_work_q_pool *pool)
+{
+	__ASSERT_NO_MSG(pool);
+
+	if (!k_is_in_isr()) {
+		for (uint32_t i = 0; i < pool->num_queues; i++) {
+			if (_current == &pool->queues[i].thread) {
+				return &pool->queues[i];
+			}
+		}
+	}
+
+	/* The CPU may change once the thread is preempted, which only
+	 * affects the balance.
+	 */
+	return &pool->queues[arch_curr_cpu()->id % pool->num_queues];
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
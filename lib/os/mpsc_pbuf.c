@@ -25,6 +25,22 @@ static inline void mpsc_state_print(struct mpsc_pbuf_buffer *buffer)
 	}
 }
 
+static inline k_spinlock_key_t pbuf_lock(struct mpsc_pbuf_buffer *buffer)
+{
+#ifdef CONFIG_MPSC_PBUF_LOCK_STATS
+	uint32_t start = k_cycle_get_32();
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	uint32_t wait = k_cycle_get_32() - start;
+
+	buffer->lock_wait += wait;
+	buffer->lock_wait_max = MAX(buffer->lock_wait_max, wait);
+
+	return key;
+#else
+	return k_spin_lock(&buffer->lock);
+#endif
+}
+
 void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 		    const struct mpsc_pbuf_buffer_config *cfg)
 {
@@ -36,6 +52,10 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 	buffer->buf = cfg->buf;
 	buffer->size = cfg->size;
 	buffer->max_usage = 0;
+#ifdef CONFIG_MPSC_PBUF_LOCK_STATS
+	buffer->lock_wait = 0;
+	buffer->lock_wait_max = 0;
+#endif
 	buffer->flags = cfg->flags;
 
 	if (is_power_of_two(buffer->size)) {
@@ -296,7 +316,7 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_val = 0;
 
 	do {
-		key = k_spin_lock(&buffer->lock);
+		key = pbuf_lock(buffer);
 
 		if (tmp_wr_idx_shift) {
 			post_drop_action(buffer, tmp_wr_idx_val, tmp_wr_idx_shift);
@@ -352,7 +372,7 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 		k_spinlock_key_t key;
 		bool wrap;
 
-		key = k_spin_lock(&buffer->lock);
+		key = pbuf_lock(buffer);
 		if (tmp_wr_idx_shift) {
 			post_drop_action(buffer, tmp_wr_idx_val, tmp_wr_idx_shift);
 			tmp_wr_idx_shift = 0;
@@ -375,7 +395,7 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 
 			k_spin_unlock(&buffer->lock, key);
 			err = k_sem_take(&buffer->sem, timeout);
-			key = k_spin_lock(&buffer->lock);
+			key = pbuf_lock(buffer);
 			cont = (err == 0) ? true : false;
 		} else if (cont) {
 			tmp_wr_idx_val = buffer->tmp_wr_idx;
@@ -409,7 +429,7 @@ void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 {
 	uint32_t wlen = buffer->get_wlen(item);
 
-	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	k_spinlock_key_t key = pbuf_lock(buffer);
 
 	item->hdr.valid = 1;
 	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
@@ -434,7 +454,7 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 		uint32_t free_wlen;
 		bool wrap;
 
-		key = k_spin_lock(&buffer->lock);
+		key = pbuf_lock(buffer);
 
 		if (tmp_wr_idx_shift) {
 			post_drop_action(buffer, tmp_wr_idx_val, tmp_wr_idx_shift);
@@ -487,7 +507,7 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 		k_spinlock_key_t key;
 		bool wrap;
 
-		key = k_spin_lock(&buffer->lock);
+		key = pbuf_lock(buffer);
 
 		if (tmp_wr_idx_shift) {
 			post_drop_action(buffer, tmp_wr_idx_val, tmp_wr_idx_shift);
@@ -535,7 +555,7 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 		k_spinlock_key_t key;
 
 		cont = false;
-		key = k_spin_lock(&buffer->lock);
+		key = pbuf_lock(buffer);
 		(void)available(buffer, &a);
 		item = (union mpsc_pbuf_generic *)
 			&buffer->buf[buffer->tmp_rd_idx];
@@ -575,7 +595,7 @@ void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 		     const union mpsc_pbuf_generic *item)
 {
 	uint32_t wlen = buffer->get_wlen(item);
-	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	k_spinlock_key_t key = pbuf_lock(buffer);
 	union mpsc_pbuf_generic *witem = (union mpsc_pbuf_generic *)item;
 
 	witem->hdr.valid = 0;
@@ -630,3 +650,19 @@ int mpsc_pbuf_get_max_utilization(struct mpsc_pbuf_buffer *buffer, uint32_t *max
 	*max = buffer->max_usage * sizeof(int);
 	return 0;
 }
+
+int mpsc_pbuf_get_lock_stats(struct mpsc_pbuf_buffer *buffer, uint64_t *total,
+			     uint32_t *max)
+{
+#ifdef CONFIG_MPSC_PBUF_LOCK_STATS
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	*total = buffer->lock_wait;
+	*max = buffer->lock_wait_max;
+	k_spin_unlock(&buffer->lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
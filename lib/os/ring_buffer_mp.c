@@ -0,0 +1,199 @@
+/* ring_buffer_mp.c: Lock-free multi-producer ring buffer API */
+
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/ring_buffer_mp.h>
+#include <string.h>
+
+/*
+ * Each record starts with a header word:
+ * - bits 0-15: number of valid bytes,
+ * - bits 16-30: length of the record in words, header included,
+ * - bit 31: set once the record is finished.
+ *
+ * A producer writes the length when claiming the record and sets the valid
+ * bit when finishing it. Free space reads as zero, as the consumer clears
+ * every record it frees, so the consumer stops at the first word which is
+ * not a finished header. Records with no valid bytes are skipped, which is
+ * also how the end of the buffer is padded when a record would wrap.
+ */
+#define HDR_BYTES_MASK	0xFFFFU
+#define HDR_WORDS_SHIFT	16
+#define HDR_WORDS_MASK	0x7FFFU
+#define HDR_VALID	BIT(31)
+
+#define HDR(words, bytes) \
+	((atomic_val_t)(((uint32_t)(words) << HDR_WORDS_SHIFT) | (bytes)))
+
+static inline uint32_t hdr_words(uint32_t hdr)
+{
+	return (hdr >> HDR_WORDS_SHIFT) & HDR_WORDS_MASK;
+}
+
+static inline atomic_t *word_get(struct ring_buf_mp *buf, uint32_t idx)
+{
+	return &buf->buffer[idx & (buf->size - 1)];
+}
+
+uint32_t ring_buf_mp_put_claim(struct ring_buf_mp *buf, uint8_t **data,
+			       uint32_t size)
+{
+	uint32_t head, tail, words, pad, wrap;
+
+	if (size == 0 || size > RING_BUFFER_MP_MAX_RECORD) {
+		return 0;
+	}
+
+	words = 1 + DIV_ROUND_UP(size, sizeof(atomic_t));
+	if (words > buf->size) {
+		return 0;
+	}
+
+	do {
+		head = (uint32_t)atomic_get(&buf->put_head);
+		tail = (uint32_t)atomic_get(&buf->get_tail);
+
+		/* a record which does not fit before the end is moved to
+		 * the start of the buffer
+		 */
+		wrap = buf->size - (head & (buf->size - 1));
+		pad = (words > wrap) ? wrap : 0;
+
+		if (pad + words > buf->size - (head - tail)) {
+			return 0;
+		}
+	} while (!atomic_cas(&buf->put_head, (atomic_val_t)head,
+			     (atomic_val_t)(uint32_t)(head + pad + words)));
+
+	if (pad) {
+		atomic_set(word_get(buf, head), HDR(pad, 0) | HDR_VALID);
+		head += pad;
+	}
+
+	atomic_set(word_get(buf, head), HDR(words, 0));
+	*data = (uint8_t *)word_get(buf, head + 1);
+
+	return size;
+}
+
+int ring_buf_mp_put_finish(struct ring_buf_mp *buf, uint8_t *data,
+			   uint32_t size)
+{
+	atomic_t *hdr = (atomic_t *)data - 1;
+	uint32_t words = hdr_words((uint32_t)atomic_get(hdr));
+
+	__ASSERT_NO_MSG(hdr >= buf->buffer && hdr < &buf->buffer[buf->size]);
+
+	if (unlikely(size > (words - 1) * sizeof(atomic_t) ||
+		     size > RING_BUFFER_MP_MAX_RECORD)) {
+		return -EINVAL;
+	}
+
+	/* atomic_set() orders the data writes before the header */
+	atomic_set(hdr, HDR(words, size) | HDR_VALID);
+
+	return 0;
+}
+
+uint32_t ring_buf_mp_put(struct ring_buf_mp *buf, const uint8_t *data,
+			 uint32_t size)
+{
+	uint8_t *dst;
+	int err;
+
+	if (ring_buf_mp_put_claim(buf, &dst, size) == 0) {
+		return 0;
+	}
+
+	memcpy(dst, data, size);
+
+	err = ring_buf_mp_put_finish(buf, dst, size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return size;
+}
+
+/* Clear the words of the record at get_head and hand them to the producers */
+static void record_free(struct ring_buf_mp *buf, uint32_t words)
+{
+	uint32_t idx = buf->get_head & (buf->size - 1);
+
+	/* records never wrap */
+	memset(&buf->buffer[idx], 0, words * sizeof(atomic_t));
+
+	buf->get_head += words;
+	atomic_set(&buf->get_tail, (atomic_val_t)buf->get_head);
+}
+
+uint32_t ring_buf_mp_get_claim(struct ring_buf_mp *buf, uint8_t **data)
+{
+	uint32_t hdr;
+
+	__ASSERT(buf->get_claimed == 0, "Previous record not freed");
+
+	while (!ring_buf_mp_is_empty(buf)) {
+		hdr = (uint32_t)atomic_get(word_get(buf, buf->get_head));
+		if (!(hdr & HDR_VALID)) {
+			/* claimed but not finished yet */
+			return 0;
+		}
+
+		if ((hdr & HDR_BYTES_MASK) == 0) {
+			/* padding or dropped record */
+			record_free(buf, hdr_words(hdr));
+			continue;
+		}
+
+		buf->get_claimed = hdr_words(hdr);
+		*data = (uint8_t *)word_get(buf, buf->get_head + 1);
+
+		return hdr & HDR_BYTES_MASK;
+	}
+
+	return 0;
+}
+
+int ring_buf_mp_get_finish(struct ring_buf_mp *buf)
+{
+	if (unlikely(buf->get_claimed == 0)) {
+		return -EINVAL;
+	}
+
+	record_free(buf, buf->get_claimed);
+	buf->get_claimed = 0;
+
+	return 0;
+}
+
+int ring_buf_mp_get(struct ring_buf_mp *buf, uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t len;
+	int err;
+
+	len = ring_buf_mp_get_claim(buf, &src);
+	if (len == 0) {
+		return -EAGAIN;
+	}
+
+	if (data) {
+		if (len > size) {
+			/* leave the record in place */
+			buf->get_claimed = 0;
+			return -EMSGSIZE;
+		}
+
+		memcpy(data, src, len);
+	}
+
+	err = ring_buf_mp_get_finish(buf);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return len;
+}
@@ -11,7 +11,8 @@
 #include <zephyr/usb/usb_device.h>
 #include <zephyr/net/net_config.h>
 
-#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP) || \
+	defined(CONFIG_NET_LOOPBACK_SIMULATE_DELAY)
 #include <zephyr/net/loopback.h>
 #endif
 void main(void)
@@ -27,6 +28,10 @@ void main(void)
 	(void)net_config_init_app(NULL, "Initializing network");
 #endif /* CONFIG_USB_DEVICE_STACK */
 #ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP
-	loopback_set_packet_drop_ratio(1);
+	loopback_set_packet_drop_ratio(
+		CONFIG_NET_SAMPLE_LOOPBACK_DROP_PERCENT / 100.0f);
+#endif
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	loopback_set_packet_delay(CONFIG_NET_SAMPLE_LOOPBACK_DELAY_MS);
 #endif
 }
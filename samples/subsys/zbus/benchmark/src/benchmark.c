@@ -25,8 +25,17 @@ LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
 #define CONSUMER_STACK_SIZE (CONFIG_IDLE_STACK_SIZE + CONFIG_BM_MESSAGE_SIZE)
 #define PRODUCER_STACK_SIZE (CONFIG_MAIN_STACK_SIZE + CONFIG_BM_MESSAGE_SIZE)
 
-ZBUS_CHAN_DEFINE(bm_channel,		   /* Name */
-		 struct external_data_msg, /* Message type */
+/* Lock-free channels carry the message itself, regular channels a reference to it */
+#if defined(CONFIG_BM_SEQLOCK)
+#define BM_CHAN_DEFINE	 ZBUS_CHAN_SEQLOCK_DEFINE
+#define BM_CHAN_MSG_TYPE struct bm_msg
+#else
+#define BM_CHAN_DEFINE	 ZBUS_CHAN_DEFINE
+#define BM_CHAN_MSG_TYPE struct external_data_msg
+#endif
+
+BM_CHAN_DEFINE(bm_channel,	       /* Name */
+	       BM_CHAN_MSG_TYPE, /* Message type */
 
 		 NULL, /* Validator */
 		 NULL, /* User data */
@@ -53,8 +62,23 @@ ZBUS_CHAN_DEFINE(bm_channel,		   /* Name */
 );
 
 #define BYTES_TO_BE_SENT (256LLU * 1024LLU)
+#define LATENCY_SAMPLES	 256
 static atomic_t count;
 
+/* Regular channels must be claimed by the caller, except from listeners */
+static inline void bm_consume(const struct zbus_channel *chan, struct bm_msg *msg_received)
+{
+#if defined(CONFIG_BM_SEQLOCK)
+	zbus_chan_read(chan, msg_received, K_NO_WAIT);
+#else
+	const struct external_data_msg *actual_message_data = zbus_chan_const_msg(chan);
+
+	__ASSERT_NO_MSG(actual_message_data->reference != NULL);
+
+	memcpy(msg_received, actual_message_data->reference, sizeof(struct bm_msg));
+#endif
+}
+
 #if (CONFIG_BM_ASYNC == 1)
 ZBUS_SUBSCRIBER_DEFINE(s1, 4);
 #if (CONFIG_BM_ONE_TO >= 2LLU)
@@ -84,20 +108,19 @@ ZBUS_SUBSCRIBER_DEFINE(s16, 4);
 #define S_TASK(name)                                                                               \
 	void name##_task(void)                                                                     \
 	{                                                                                          \
-		struct external_data_msg *actual_message_data;                                     \
 		const struct zbus_channel *chan;                                                   \
 		struct bm_msg msg_received;                                                        \
                                                                                                    \
 		while (!zbus_sub_wait(&name, &chan, K_FOREVER)) {                                  \
-			zbus_chan_claim(chan, K_NO_WAIT);                                          \
-                                                                                                   \
-			actual_message_data = zbus_chan_msg(chan);                                 \
-			__ASSERT_NO_MSG(actual_message_data->reference != NULL);                   \
+			if (!IS_ENABLED(CONFIG_BM_SEQLOCK)) {                                      \
+				zbus_chan_claim(chan, K_NO_WAIT);                                  \
+			}                                                                          \
                                                                                                    \
-			memcpy(&msg_received, actual_message_data->reference,                      \
-			       sizeof(struct bm_msg));                                             \
+			bm_consume(chan, &msg_received);                                           \
                                                                                                    \
-			zbus_chan_finish(chan);                                                    \
+			if (!IS_ENABLED(CONFIG_BM_SEQLOCK)) {                                      \
+				zbus_chan_finish(chan);                                            \
+			}                                                                          \
                                                                                                    \
 			atomic_add(&count, CONFIG_BM_MESSAGE_SIZE);                                \
 		}                                                                                  \
@@ -163,27 +186,89 @@ ZBUS_LISTENER_DEFINE(s16, s_cb);
 static void s_cb(const struct zbus_channel *chan)
 {
 	struct bm_msg msg_received;
-	const struct external_data_msg *actual_message_data = zbus_chan_const_msg(chan);
 
-	memcpy(&msg_received, actual_message_data->reference, sizeof(struct bm_msg));
+	bm_consume(chan, &msg_received);
 
 	count += CONFIG_BM_MESSAGE_SIZE;
 }
 
 #endif /* CONFIG_BM_ASYNC */
 
+static void bm_publish(const struct bm_msg *msg)
+{
+#if defined(CONFIG_BM_SEQLOCK)
+	zbus_chan_pub(&bm_channel, msg, K_MSEC(200));
+#else
+	struct external_data_msg *actual_message_data;
+
+	zbus_chan_claim(&bm_channel, K_NO_WAIT);
+
+	actual_message_data = zbus_chan_msg(&bm_channel);
+
+	memcpy(actual_message_data->reference, msg, CONFIG_BM_MESSAGE_SIZE);
+
+	zbus_chan_finish(&bm_channel);
+
+	zbus_chan_notify(&bm_channel, K_MSEC(200));
+#endif
+}
+
+static void bm_enable_observers(int n)
+{
+	int i = 0;
+
+	for (const struct zbus_observer *const *obs = bm_channel.observers; *obs != NULL;
+	     ++obs, ++i) {
+		zbus_obs_set_enable((struct zbus_observer *)*obs, i < n);
+	}
+}
+
+/* Publication latency and throughput while the number of notified observers doubles */
+static void bm_latency(const struct bm_msg *msg)
+{
+	for (int n = 1; n <= CONFIG_BM_ONE_TO; n *= 2) {
+		uint32_t max_ns = 0;
+		uint64_t total_ns = 0;
+
+		bm_enable_observers(n);
+
+		for (int i = 0; i < LATENCY_SAMPLES; i++) {
+			uint32_t start_ns = GET_ARCH_TIME_NS();
+
+			bm_publish(msg);
+
+			uint32_t elapsed_ns = GET_ARCH_TIME_NS() - start_ns;
+
+			total_ns += elapsed_ns;
+			max_ns = MAX(max_ns, elapsed_ns);
+		}
+
+		if (total_ns == 0) {
+			total_ns = 1;
+		}
+
+		LOG_INF("Latency 1 to %d: avg %uns, max %uns, %llu msg/s", n,
+			(uint32_t)(total_ns / LATENCY_SAMPLES), max_ns,
+			(uint64_t)LATENCY_SAMPLES * NSEC_PER_SEC / total_ns);
+	}
+
+	bm_enable_observers(CONFIG_BM_ONE_TO);
+}
+
 static void producer_thread(void)
 {
 	LOG_INF("Benchmark 1 to %d: Dynamic memory, %sSYNC transmission and message size %u",
 		CONFIG_BM_ONE_TO, IS_ENABLED(CONFIG_BM_ASYNC) ? "A" : "", CONFIG_BM_MESSAGE_SIZE);
 
 	struct bm_msg msg;
-	struct external_data_msg *actual_message_data;
 
 	for (uint64_t i = (CONFIG_BM_MESSAGE_SIZE - 1); i > 0; --i) {
 		msg.bytes[i] = i;
 	}
 
+#if !defined(CONFIG_BM_SEQLOCK)
+	struct external_data_msg *actual_message_data;
+
 	zbus_chan_claim(&bm_channel, K_NO_WAIT);
 
 	actual_message_data = zbus_chan_msg(&bm_channel);
@@ -193,20 +278,13 @@ static void producer_thread(void)
 	__ASSERT_NO_MSG(actual_message_data->size > 0);
 
 	zbus_chan_finish(&bm_channel);
+#endif /* CONFIG_BM_SEQLOCK */
 
 	uint32_t start_ns = GET_ARCH_TIME_NS();
 
 	for (uint64_t internal_count = BYTES_TO_BE_SENT / CONFIG_BM_ONE_TO; internal_count > 0;
 	     internal_count -= CONFIG_BM_MESSAGE_SIZE) {
-		zbus_chan_claim(&bm_channel, K_NO_WAIT);
-
-		actual_message_data = zbus_chan_msg(&bm_channel);
-
-		memcpy(actual_message_data->reference, &msg, CONFIG_BM_MESSAGE_SIZE);
-
-		zbus_chan_finish(&bm_channel);
-
-		zbus_chan_notify(&bm_channel, K_MSEC(200));
+		bm_publish(&msg);
 	}
 
 	uint32_t end_ns = GET_ARCH_TIME_NS();
@@ -224,6 +302,8 @@ static void producer_thread(void)
 	LOG_INF("Average data rate: %llu.%lluMB/s", i, f);
 	LOG_INF("Duration: %u.%uus", duration / NSEC_PER_USEC, duration % NSEC_PER_USEC);
 
+	bm_latency(&msg);
+
 	printk("\n@%u\n", duration);
 }
 
@@ -445,8 +445,14 @@ class LogParserV1(LogParser):
     def parse_log_data(self, logdata, debug=False):
         """Parse binary log data and print the encoded log messages"""
         offset = 0
+        hdr_len = struct.calcsize(self.fmt_msg_type) + struct.calcsize(self.fmt_msg_hdr)
 
         while offset < len(logdata):
+            if not any(logdata[offset:offset + hdr_len]) and not any(logdata[offset:]):
+                # A message header is never all zeros, this is the unused
+                # end of a preallocated log file.
+                break
+
             # Get message type
             msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
             offset += struct.calcsize(self.fmt_msg_type)
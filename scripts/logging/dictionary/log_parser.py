@@ -14,6 +14,8 @@ log data and print the log messages.
 import argparse
 import binascii
 import logging
+import os
+import re
 import sys
 
 import dictionary_parser
@@ -31,7 +33,11 @@ def parse_args():
     argparser = argparse.ArgumentParser(allow_abbrev=False)
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile",
+                           help="Log Data file, or directory of rotated log files "
+                                "written by the file system backend")
+    argparser.add_argument("--prefix", default="log.",
+                           help="Name prefix of rotated log files (default: log.)")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
@@ -42,6 +48,38 @@ def parse_args():
     return argparser.parse_args()
 
 
+# Rotated files are numbered with 4 digits, wrapping around after 9999
+LOG_FILE_NUM_MAX = 10000
+
+
+def get_rotated_log_files(logdir, prefix):
+    """
+    Get the log files of the file system backend, from oldest to newest
+    """
+    pattern = re.compile(re.escape(prefix) + r"(\d{4})$")
+    files = {}
+
+    for name in os.listdir(logdir):
+        match = pattern.match(name)
+        if match and os.path.isfile(os.path.join(logdir, name)):
+            files[int(match.group(1))] = os.path.join(logdir, name)
+
+    nums = sorted(files)
+    if not nums:
+        return []
+
+    # Files are a contiguous range of numbers, modulo LOG_FILE_NUM_MAX.
+    # The oldest one follows the largest gap.
+    start = 0
+    gap = nums[0] + LOG_FILE_NUM_MAX - nums[-1]
+    for idx in range(1, len(nums)):
+        if nums[idx] - nums[idx - 1] > gap:
+            gap = nums[idx] - nums[idx - 1]
+            start = idx
+
+    return [files[num] for num in nums[start:] + nums[:start]]
+
+
 def read_log_file(args):
     """
     Read the log from file
@@ -118,10 +156,23 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
-    logdata = read_log_file(args)
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
-        sys.exit(1)
+    if os.path.isdir(args.logfile):
+        logfiles = get_rotated_log_files(args.logfile, args.prefix)
+        if not logfiles:
+            logger.error("ERROR: no log files in directory: %s, exiting...", args.logfile)
+            sys.exit(1)
+
+        logdata = []
+        for logfile in logfiles:
+            with open(logfile, "rb") as f:
+                logdata.append(f.read())
+    else:
+        logdata = read_log_file(args)
+        if logdata is None:
+            logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
+            sys.exit(1)
+
+        logdata = [logdata]
 
     log_parser = dictionary_parser.get_parser(database)
     if log_parser is not None:
@@ -132,7 +183,11 @@ def main():
         else:
             logger.debug("# Endianness: Big")
 
-        ret = log_parser.parse_log_data(logdata, debug=args.debug)
+        # Each rotated file starts with a complete message
+        ret = True
+        for data in logdata:
+            ret = log_parser.parse_log_data(data, debug=args.debug) and ret
+
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#include "disk_cache_priv.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -87,6 +89,16 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		struct disk_cache *cache = disk_cache_get(disk);
+
+		if (cache != NULL) {
+			rc = disk_cache_read(disk, cache, data_buf, start_sector,
+					     num_sector);
+			disk_cache_put(cache);
+			return rc;
+		}
+#endif
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
 	}
 
@@ -101,6 +113,16 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		struct disk_cache *cache = disk_cache_get(disk);
+
+		if (cache != NULL) {
+			rc = disk_cache_write(disk, cache, data_buf, start_sector,
+					      num_sector);
+			disk_cache_put(cache);
+			return rc;
+		}
+#endif
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
 	}
 
@@ -112,8 +134,26 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 	struct disk_info *disk = disk_access_get_di(pdrv);
 	int rc = -EINVAL;
 
-	if ((disk != NULL) && (disk->ops != NULL) &&
-				(disk->ops->ioctl != NULL)) {
+	if ((disk == NULL) || (disk->ops == NULL)) {
+		return rc;
+	}
+
+#ifdef CONFIG_DISK_CACHE
+	/* The cache is flushed even if the driver has nothing to sync */
+	if (cmd == DISK_IOCTL_CTRL_SYNC) {
+		struct disk_cache *cache = disk_cache_get(disk);
+
+		if (cache != NULL) {
+			rc = disk_cache_sync(disk, cache);
+			disk_cache_put(cache);
+			if ((rc < 0) || (disk->ops->ioctl == NULL)) {
+				return rc;
+			}
+		}
+	}
+#endif
+
+	if (disk->ops->ioctl != NULL) {
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
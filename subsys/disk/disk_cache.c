@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/storage/disk_cache.h>
+#include <errno.h>
+
+#include "disk_cache_priv.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(disk_cache);
+
+/*
+ * Each slot of the cache holds one sector. Slots are found by a linear
+ * search, the cache being small, and evicted by least recent use. A miss
+ * reads the missing sectors of the request, plus the read-ahead on
+ * sequential reads, into adjacent slots so that the device sees a single
+ * transaction. Dirty slots are never reused before they are written back.
+ *
+ * The lock of a cache is initialized when it is defined so that threads
+ * waiting on it when it is detached, and maybe attached again, are safe.
+ * They find out once they hold it, see disk_cache_get(). Attaching and
+ * detaching are serialized by attach_lock.
+ */
+
+static K_MUTEX_DEFINE(attach_lock);
+
+static inline uint8_t *slot_data(struct disk_cache *cache, int idx)
+{
+	return &cache->data[idx * cache->sector_size];
+}
+
+static inline bool slot_valid(struct disk_cache *cache, int idx)
+{
+	return cache->entries[idx].last_used != 0;
+}
+
+static void slot_touch(struct disk_cache *cache, int idx)
+{
+	if (++cache->tick == 0) {
+		/* Wrapped, age all the slots alike */
+		for (int i = 0; i < cache->num_entries; i++) {
+			if (slot_valid(cache, i)) {
+				cache->entries[i].last_used = 1;
+			}
+		}
+		cache->tick = 2;
+	}
+
+	cache->entries[idx].last_used = cache->tick;
+}
+
+static int slot_find(struct disk_cache *cache, uint32_t sector)
+{
+	for (int i = 0; i < cache->num_entries; i++) {
+		if (slot_valid(cache, i) && cache->entries[i].sector == sector) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static int device_read(struct disk_info *disk, struct disk_cache *cache,
+		       uint8_t *buf, uint32_t start, uint32_t num)
+{
+	cache->stats.device_reads++;
+
+	return disk->ops->read(disk, buf, start, num);
+}
+
+static int device_write(struct disk_info *disk, struct disk_cache *cache,
+			const uint8_t *buf, uint32_t start, uint32_t num)
+{
+	cache->stats.device_writes++;
+
+	return disk->ops->write(disk, buf, start, num);
+}
+
+/* Write back a dirty slot, along with the slots following it which hold the
+ * following sectors
+ */
+static int slot_flush(struct disk_info *disk, struct disk_cache *cache, int idx)
+{
+	struct disk_cache_entry *entries = cache->entries;
+	int count = 1;
+	int rc;
+
+	while (idx + count < cache->num_entries && slot_valid(cache, idx + count) &&
+	       entries[idx + count].dirty &&
+	       entries[idx + count].sector == entries[idx].sector + count) {
+		count++;
+	}
+
+	rc = device_write(disk, cache, slot_data(cache, idx), entries[idx].sector, count);
+	if (rc < 0) {
+		LOG_ERR("Failed to write back sector %u (%d)", entries[idx].sector, rc);
+		return rc;
+	}
+
+	for (int i = 0; i < count; i++) {
+		entries[idx + i].dirty = false;
+	}
+
+	return 0;
+}
+
+static int cache_flush(struct disk_info *disk, struct disk_cache *cache)
+{
+	int rc;
+
+	for (int i = 0; i < cache->num_entries; i++) {
+		if (slot_valid(cache, i) && cache->entries[i].dirty) {
+			rc = slot_flush(disk, cache, i);
+			if (rc < 0) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Find adjacent slots, none of them dirty, whose most recent use is the
+ * oldest
+ */
+static int slots_find_free(struct disk_cache *cache, uint32_t count)
+{
+	uint32_t best_used = UINT32_MAX;
+	int best = -1;
+
+	for (int i = 0; i + count <= cache->num_entries; i++) {
+		uint32_t newest = 0;
+		uint32_t j;
+
+		for (j = 0; j < count; j++) {
+			const struct disk_cache_entry *entry = &cache->entries[i + j];
+
+			if (slot_valid(cache, i + j) && entry->dirty) {
+				break;
+			}
+			newest = MAX(newest, entry->last_used);
+		}
+
+		if (j < count) {
+			/* Skip past the dirty slot */
+			i += j;
+			continue;
+		}
+
+		if (newest < best_used) {
+			best = i;
+			best_used = newest;
+			if (newest == 0) {
+				break;
+			}
+		}
+	}
+
+	return best;
+}
+
+/* Get a slot for a new sector, writing back the least recently used one if
+ * they are all dirty
+ */
+static int slot_evict(struct disk_info *disk, struct disk_cache *cache)
+{
+	int idx = slots_find_free(cache, 1);
+	int rc;
+
+	if (idx >= 0) {
+		return idx;
+	}
+
+	idx = 0;
+	for (int i = 1; i < cache->num_entries; i++) {
+		if (cache->entries[i].last_used < cache->entries[idx].last_used) {
+			idx = i;
+		}
+	}
+
+	rc = slot_flush(disk, cache, idx);
+
+	return (rc < 0) ? rc : idx;
+}
+
+/* Read sectors from the device into adjacent slots, fewer if there are not
+ * enough free ones
+ */
+static int cache_fetch(struct disk_info *disk, struct disk_cache *cache,
+		       uint32_t sector, uint32_t *count)
+{
+	int idx = (*count > 1) ? slots_find_free(cache, *count) : -1;
+	int rc;
+
+	if (idx < 0) {
+		*count = 1;
+		idx = slot_evict(disk, cache);
+		if (idx < 0) {
+			return idx;
+		}
+	}
+
+	for (uint32_t i = 0; i < *count; i++) {
+		cache->entries[idx + i].last_used = 0;
+	}
+
+	rc = device_read(disk, cache, slot_data(cache, idx), sector, *count);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (uint32_t i = 0; i < *count; i++) {
+		cache->entries[idx + i].sector = sector + i;
+		cache->entries[idx + i].dirty = false;
+		slot_touch(cache, idx + i);
+	}
+
+	return idx;
+}
+
+/* Read from the device, with the sectors modified in the cache */
+static int cache_read_direct(struct disk_info *disk, struct disk_cache *cache,
+			     uint8_t *buf, uint32_t start, uint32_t num)
+{
+	int rc;
+
+	rc = device_read(disk, cache, buf, start, num);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (int i = 0; i < cache->num_entries; i++) {
+		const struct disk_cache_entry *entry = &cache->entries[i];
+
+		if (slot_valid(cache, i) && entry->dirty &&
+		    entry->sector >= start && entry->sector - start < num) {
+			memcpy(&buf[(entry->sector - start) * cache->sector_size],
+			       slot_data(cache, i), cache->sector_size);
+		}
+	}
+
+	return 0;
+}
+
+struct disk_cache *disk_cache_get(struct disk_info *disk)
+{
+	struct disk_cache *cache = disk->cache;
+
+	/* Detached while waiting for the lock, try again with the new one */
+	while (cache != NULL) {
+		k_mutex_lock(&cache->lock, K_FOREVER);
+		if (disk->cache == cache) {
+			return cache;
+		}
+		k_mutex_unlock(&cache->lock);
+		cache = disk->cache;
+	}
+
+	return NULL;
+}
+
+void disk_cache_put(struct disk_cache *cache)
+{
+	k_mutex_unlock(&cache->lock);
+}
+
+int disk_cache_read(struct disk_info *disk, struct disk_cache *cache,
+		    uint8_t *data_buf, uint32_t start_sector, uint32_t num_sector)
+{
+	uint32_t max_fetch = MAX(cache->num_entries / 2, 1);
+	bool sequential;
+	int rc = 0;
+
+	sequential = (start_sector == cache->next_sector);
+	cache->next_sector = start_sector + num_sector;
+
+	if (num_sector > max_fetch) {
+		cache->stats.misses += num_sector;
+		return cache_read_direct(disk, cache, data_buf, start_sector, num_sector);
+	}
+
+	for (uint32_t i = 0; i < num_sector;) {
+		uint32_t sector = start_sector + i;
+		int idx = slot_find(cache, sector);
+		uint32_t count = 1;
+
+		if (idx < 0) {
+			uint32_t limit = num_sector - i;
+
+			if (sequential) {
+				limit += cache->cfg.read_ahead;
+			}
+			limit = MIN(limit, MIN(max_fetch, cache->sector_count - sector));
+
+			while (count < limit && slot_find(cache, sector + count) < 0) {
+				count++;
+			}
+
+			idx = cache_fetch(disk, cache, sector, &count);
+			if (idx < 0) {
+				rc = idx;
+				break;
+			}
+			cache->stats.misses += MIN(count, num_sector - i);
+		} else {
+			slot_touch(cache, idx);
+			cache->stats.hits++;
+		}
+
+		for (uint32_t j = 0; j < count && i < num_sector; j++, i++) {
+			memcpy(&data_buf[i * cache->sector_size], slot_data(cache, idx + j),
+			       cache->sector_size);
+		}
+	}
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, struct disk_cache *cache,
+		     const uint8_t *data_buf, uint32_t start_sector,
+		     uint32_t num_sector)
+{
+	int rc = 0;
+
+	if (!cache->cfg.write_back || num_sector > MAX(cache->num_entries / 2, 1)) {
+		/* Write through, updating the sectors already in the cache */
+		rc = device_write(disk, cache, data_buf, start_sector, num_sector);
+
+		for (int i = 0; i < cache->num_entries; i++) {
+			struct disk_cache_entry *entry = &cache->entries[i];
+
+			if (!slot_valid(cache, i) || entry->sector < start_sector ||
+			    entry->sector - start_sector >= num_sector) {
+				continue;
+			}
+
+			if (rc == 0) {
+				memcpy(slot_data(cache, i),
+				       &data_buf[(entry->sector - start_sector) *
+						 cache->sector_size],
+				       cache->sector_size);
+				entry->dirty = false;
+			} else if (!entry->dirty) {
+				/* The device content is unknown */
+				entry->last_used = 0;
+			}
+		}
+
+		return rc;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		int idx = slot_find(cache, start_sector + i);
+
+		if (idx < 0) {
+			idx = slot_evict(disk, cache);
+			if (idx < 0) {
+				rc = idx;
+				break;
+			}
+			cache->entries[idx].sector = start_sector + i;
+		}
+
+		memcpy(slot_data(cache, idx), &data_buf[i * cache->sector_size],
+		       cache->sector_size);
+		cache->entries[idx].dirty = true;
+		slot_touch(cache, idx);
+	}
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk, struct disk_cache *cache)
+{
+	return cache_flush(disk, cache);
+}
+
+/* Read the geometry of a disk, assuming the sector size of the cache if the
+ * driver can't tell
+ */
+static int disk_geometry_get(const char *pdrv, struct disk_info *disk,
+			     struct disk_cache *cache, uint32_t *sector_count)
+{
+	uint32_t sector_size;
+	int rc;
+
+	if (disk->ops == NULL || disk->ops->ioctl == NULL) {
+		*sector_count = 0;
+		return 0;
+	}
+
+	rc = disk_access_ioctl(pdrv, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (sector_size != cache->sector_size) {
+		LOG_ERR("Sector size %u of %s does not match the cache (%u)",
+			sector_size, pdrv, cache->sector_size);
+		return -EINVAL;
+	}
+
+	return disk_access_ioctl(pdrv, DISK_IOCTL_GET_SECTOR_COUNT, sector_count);
+}
+
+int disk_cache_attach(const char *pdrv, struct disk_cache *cache,
+		      const struct disk_cache_config *cfg)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	uint32_t sector_count;
+	int rc;
+
+	if (disk == NULL || cache == NULL || cfg == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&attach_lock, K_FOREVER);
+
+	if (disk->cache != NULL) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	rc = disk_geometry_get(pdrv, disk, cache, &sector_count);
+	if (rc < 0) {
+		goto out;
+	}
+
+	k_mutex_lock(&cache->lock, K_FOREVER);
+	memset(cache->entries, 0, cache->num_entries * sizeof(cache->entries[0]));
+	memset(&cache->stats, 0, sizeof(cache->stats));
+	cache->cfg = *cfg;
+	cache->next_sector = UINT32_MAX;
+	cache->tick = 0;
+
+	if (sector_count == 0) {
+		/* Without the end of the disk, only read what is asked for */
+		cache->cfg.read_ahead = 0;
+		sector_count = UINT32_MAX;
+	}
+	cache->sector_count = sector_count;
+
+	disk->cache = cache;
+	k_mutex_unlock(&cache->lock);
+
+	LOG_DBG("cache of %u sectors attached to %s", cache->num_entries, pdrv);
+
+out:
+	k_mutex_unlock(&attach_lock);
+
+	return rc;
+}
+
+int disk_cache_detach(const char *pdrv)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	struct disk_cache *cache;
+	int rc = -EINVAL;
+
+	if (disk == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&attach_lock, K_FOREVER);
+
+	cache = disk_cache_get(disk);
+	if (cache != NULL) {
+		rc = cache_flush(disk, cache);
+		if (rc == 0) {
+			disk->cache = NULL;
+		}
+		disk_cache_put(cache);
+	}
+
+	k_mutex_unlock(&attach_lock);
+
+	return rc;
+}
+
+int disk_cache_stats_get(const char *pdrv, struct disk_cache_stats *stats)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+	struct disk_cache *cache;
+
+	if (disk == NULL) {
+		return -EINVAL;
+	}
+
+	cache = disk_cache_get(disk);
+	if (cache == NULL) {
+		return -EINVAL;
+	}
+
+	*stats = cache->stats;
+	disk_cache_put(cache);
+
+	return 0;
+}
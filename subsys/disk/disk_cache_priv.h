@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_PRIV_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_PRIV_H_
+
+#include <zephyr/storage/disk_access.h>
+
+struct disk_cache;
+
+struct disk_info *disk_access_get_di(const char *name);
+
+/* Lock the cache attached to a disk, NULL if it has none. It stays attached
+ * until unlocked with disk_cache_put().
+ */
+struct disk_cache *disk_cache_get(struct disk_info *disk);
+void disk_cache_put(struct disk_cache *cache);
+
+/* Counterparts of the disk operations for disks with a cache attached,
+ * called with the cache locked
+ */
+int disk_cache_read(struct disk_info *disk, struct disk_cache *cache,
+		    uint8_t *data_buf, uint32_t start_sector, uint32_t num_sector);
+int disk_cache_write(struct disk_info *disk, struct disk_cache *cache,
+		     const uint8_t *data_buf, uint32_t start_sector,
+		     uint32_t num_sector);
+int disk_cache_sync(struct disk_info *disk, struct disk_cache *cache);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_PRIV_H_ */
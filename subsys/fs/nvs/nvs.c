@@ -88,6 +88,154 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+/*
+ * The lookup index is an open addressing hash table with linear probing.
+ * Unlike the lookup cache, it holds the address of the most recent ATE of
+ * every ID, as long as there is room for it.
+ */
+static inline size_t nvs_lookup_index_pos(uint16_t id)
+{
+	/* Multiplicative hash, spreading both sequential and strided IDs */
+	return (((uint32_t)id * 2654435761U) >> 16) % CONFIG_NVS_LOOKUP_INDEX_SIZE;
+}
+
+static inline size_t nvs_lookup_index_next(size_t pos)
+{
+	return (pos + 1) % CONFIG_NVS_LOOKUP_INDEX_SIZE;
+}
+
+/* Returns the slot holding id, the free slot where it would be stored, or
+ * CONFIG_NVS_LOOKUP_INDEX_SIZE if the index is full.
+ */
+static size_t nvs_lookup_index_find(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_lookup_index_pos(id);
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		if (fs->lookup_index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR ||
+		    fs->lookup_index_id[pos] == id) {
+			return pos;
+		}
+		pos = nvs_lookup_index_next(pos);
+	}
+
+	return CONFIG_NVS_LOOKUP_INDEX_SIZE;
+}
+
+/* Returns the address of the most recent ATE of id, NVS_LOOKUP_CACHE_NO_ADDR
+ * if there is none, or fs->ate_wra if the ATEs must be walked to find it.
+ */
+static uint32_t nvs_lookup_index_get(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_lookup_index_find(fs, id);
+
+	if (pos < CONFIG_NVS_LOOKUP_INDEX_SIZE &&
+	    fs->lookup_index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR) {
+		return fs->lookup_index_addr[pos];
+	}
+
+	return fs->lookup_index_full ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static void nvs_lookup_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr,
+				 bool replace)
+{
+	size_t pos = nvs_lookup_index_find(fs, id);
+
+	if (pos == CONFIG_NVS_LOOKUP_INDEX_SIZE) {
+		/* Until the next mount, IDs missing from the index may exist */
+		fs->lookup_index_full = true;
+		return;
+	}
+
+	if (fs->lookup_index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR) {
+		fs->lookup_index_id[pos] = id;
+	} else if (!replace) {
+		return;
+	}
+
+	fs->lookup_index_addr[pos] = addr;
+}
+
+/* Free a slot, moving back the following entries of its probe sequence */
+static void nvs_lookup_index_remove(struct nvs_fs *fs, size_t hole)
+{
+	size_t pos = hole;
+	size_t home;
+
+	for (size_t i = 1; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		pos = nvs_lookup_index_next(pos);
+		if (fs->lookup_index_addr[pos] == NVS_LOOKUP_CACHE_NO_ADDR) {
+			break;
+		}
+
+		/* The entry can fill the hole unless its home slot is
+		 * cyclically within (hole, pos].
+		 */
+		home = nvs_lookup_index_pos(fs->lookup_index_id[pos]);
+		if ((pos > hole) ? (home <= hole || home > pos) :
+				   (home <= hole && home > pos)) {
+			fs->lookup_index_id[hole] = fs->lookup_index_id[pos];
+			fs->lookup_index_addr[hole] = fs->lookup_index_addr[pos];
+			hole = pos;
+		}
+	}
+
+	fs->lookup_index_addr[hole] = NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static int nvs_lookup_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	memset(fs->lookup_index_addr, 0xff, sizeof(fs->lookup_index_addr));
+	fs->lookup_index_full = false;
+	addr = fs->ate_wra;
+
+	/* Walking from the newest ATE, the first one found for each ID is
+	 * the one to keep.
+	 */
+	while (true) {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate)) {
+			nvs_lookup_index_set(fs, ate.id, ate_addr, false);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_lookup_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t pos = 0;
+
+	while (pos < CONFIG_NVS_LOOKUP_INDEX_SIZE) {
+		if (fs->lookup_index_addr[pos] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->lookup_index_addr[pos] >> ADDR_SECT_SHIFT) == sector) {
+			/* Another entry may be moved to pos, check it again */
+			nvs_lookup_index_remove(fs, pos);
+			continue;
+		}
+		pos++;
+	}
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -172,6 +320,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (entry->id != 0xFFFF) {
+		nvs_lookup_index_set(fs, entry->id, fs->ate_wra, true);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -305,6 +458,17 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	nvs_lookup_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* the incremental gc has to start over if the sector is ever used
+	 * again
+	 */
+	if ((fs->gc_addr & ADDR_SECT_MASK) == addr) {
+		fs->gc_addr = NVS_LOOKUP_CACHE_NO_ADDR;
+	}
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -576,6 +740,91 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* find the address of the most recent ate with the given id, walking from the
+ * newest ate unless the lookup index knows it. If there is none, ate_addr is
+ * left at the oldest ate.
+ */
+static int nvs_latest_ate_addr(struct nvs_fs *fs, uint16_t id,
+			       uint32_t *ate_addr)
+{
+	int rc;
+	uint32_t wlk_addr;
+	struct nvs_ate wlk_ate;
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* The index is only complete once the file system is mounted */
+	if (fs->ready) {
+		*ate_addr = nvs_lookup_index_get(fs, id);
+		if (*ate_addr != fs->ate_wra) {
+			return 0;
+		}
+	}
+#endif
+
+	wlk_addr = fs->ate_wra;
+	do {
+		*ate_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	return 0;
+}
+
+/* an entry has to be kept by gc if its ate at ate_addr is the most recent one
+ * of the id, unless it is a deleted item. returns 1 if the entry has to be
+ * moved, 0 if not, errcode if error.
+ */
+static int nvs_gc_ate_live(struct nvs_fs *fs, uint32_t ate_addr,
+			   const struct nvs_ate *gc_ate)
+{
+	int rc;
+	uint32_t wlk_prev_addr;
+
+	if (!gc_ate->len) {
+		return 0;
+	}
+
+	rc = nvs_latest_ate_addr(fs, gc_ate->id, &wlk_prev_addr);
+	if (rc) {
+		return rc;
+	}
+
+	return (wlk_prev_addr == ate_addr) ? 1 : 0;
+}
+
+/* move the entry of the ate at ate_addr to the current write location */
+static int nvs_gc_move_ate(struct nvs_fs *fs, uint32_t ate_addr,
+			   struct nvs_ate *gc_ate)
+{
+	int rc;
+	uint32_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (ate_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -583,10 +832,10 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
+	bool sec_erased = false;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -603,6 +852,16 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		/* the sector might have been erased ahead by nvs_gc_step() */
+		rc = nvs_flash_cmp_const(fs, sec_addr,
+					 fs->flash_parameters->erase_value,
+					 fs->sector_size);
+		if (rc < 0) {
+			return rc;
+		}
+		sec_erased = (rc == 0);
+#endif
 		goto gc_done;
 	}
 
@@ -629,43 +888,14 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		if (rc) {
 			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+			rc = nvs_gc_move_ate(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
@@ -687,6 +917,10 @@ gc_done:
 		}
 	}
 
+	if (sec_erased) {
+		return 0;
+	}
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -893,6 +1127,11 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (!rc) {
+		rc = nvs_lookup_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -906,16 +1145,55 @@ end:
 	return rc;
 }
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+static K_THREAD_STACK_DEFINE(nvs_gc_stack, CONFIG_NVS_GC_BACKGROUND_STACK_SIZE);
+static struct k_work_q nvs_gc_work_q;
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+
+	/* one step at a time, so that writes only wait for the current one */
+	while (nvs_gc_step(fs) == 0) {
+		k_yield();
+	}
+}
+
+static int nvs_gc_work_q_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nvs_gc",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&nvs_gc_work_q, nvs_gc_stack,
+			   K_THREAD_STACK_SIZEOF(nvs_gc_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
+
 int nvs_clear(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr;
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -936,6 +1214,13 @@ int nvs_mount(struct nvs_fs *fs)
 	int rc;
 	struct flash_pages_info info;
 	size_t write_block_size;
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	/* the background gc of a previous mount must not run during startup */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
 
 	k_mutex_init(&fs->nvs_lock);
 
@@ -970,6 +1255,10 @@ int nvs_mount(struct nvs_fs *fs)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc_addr = NVS_LOOKUP_CACHE_NO_ADDR;
+#endif
+
 	rc = nvs_startup(fs);
 	if (rc) {
 		return rc;
@@ -978,6 +1267,10 @@ int nvs_mount(struct nvs_fs *fs)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	(void)k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+#endif
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -1015,15 +1308,22 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		return -EINVAL;
 	}
 
+	/* the lookup must not see a sector being collected in the background */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
 	/* find latest entry with same id */
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	wlk_addr = nvs_lookup_index_get(fs, id);
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
-			return rc;
+			goto end;
 		}
 		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
 			prev_found = true;
@@ -1045,20 +1345,22 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 				/* skip delete entry as it is already the
 				 * last one
 				 */
-				return 0;
+				rc = 0;
+				goto end;
 			}
 		} else if (len == wlk_ate.len) {
 			/* do not try to compare if lengths are not equal */
 			/* compare the data and if equal return 0 */
 			rc = nvs_flash_block_cmp(fs, rd_addr, data, len);
 			if (rc <= 0) {
-				return rc;
+				goto end;
 			}
 		}
 	} else {
 		/* skip delete entry for non-existing entry */
 		if (len == 0) {
-			return 0;
+			rc = 0;
+			goto end;
 		}
 	}
 
@@ -1068,8 +1370,6 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		required_space = data_size + ate_size;
 	}
 
-	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
-
 	gc_count = 0;
 	while (1) {
 		if (gc_count == fs->sector_count) {
@@ -1102,6 +1402,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		gc_count++;
 	}
 	rc = len;
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	(void)k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+#endif
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -1134,9 +1437,19 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+	/* a write or the background gc may move or erase the entry */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#elif defined(CONFIG_NVS_LOOKUP_INDEX)
+	wlk_addr = nvs_lookup_index_get(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
 		goto err;
@@ -1162,7 +1475,8 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	if (((wlk_addr == fs->ate_wra) && (wlk_ate.id != id)) ||
 	    (wlk_ate.len == 0U) || (cnt_his < cnt)) {
-		return -ENOENT;
+		rc = -ENOENT;
+		goto err;
 	}
 
 	rd_addr &= ADDR_SECT_MASK;
@@ -1172,9 +1486,10 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		goto err;
 	}
 
-	return wlk_ate.len;
+	rc = wlk_ate.len;
 
 err:
+	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
 
@@ -1240,3 +1555,134 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* find the sector to gc ahead of time: the oldest sector, following the empty
+ * sector after the write sector and the sectors that are already erased.
+ * returns -EALREADY if CONFIG_NVS_GC_RESERVE_SECTORS sectors are erased.
+ *
+ * The sector before the write sector is never erased ahead: nvs_startup()
+ * finds the write sector as the open sector following a closed sector.
+ */
+static int nvs_gc_step_sector(struct nvs_fs *fs, uint32_t *sec_addr)
+{
+	int rc;
+	struct nvs_ate close_ate;
+	uint32_t addr, next_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	addr = fs->ate_wra & ADDR_SECT_MASK;
+	nvs_sector_advance(fs, &addr);
+
+	for (int i = 0; i < CONFIG_NVS_GC_RESERVE_SECTORS; i++) {
+		nvs_sector_advance(fs, &addr);
+		next_addr = addr;
+		nvs_sector_advance(fs, &next_addr);
+		if ((addr == (fs->ate_wra & ADDR_SECT_MASK)) ||
+		    (next_addr == (fs->ate_wra & ADDR_SECT_MASK))) {
+			break;
+		}
+
+		rc = nvs_flash_ate_rd(fs, addr + fs->sector_size - ate_size,
+				      &close_ate);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_ate_cmp_const(&close_ate,
+				       fs->flash_parameters->erase_value);
+		if (rc) {
+			/* closed sector */
+			*sec_addr = addr;
+			return 0;
+		}
+	}
+
+	return -EALREADY;
+}
+
+int nvs_gc_step(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, close_addr;
+	size_t ate_size, required_space;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	rc = nvs_gc_step_sector(fs, &sec_addr);
+	if (rc) {
+		goto end;
+	}
+
+	close_addr = sec_addr + fs->sector_size - ate_size;
+
+	if ((fs->gc_addr & ADDR_SECT_MASK) != sec_addr) {
+		/* start from the most recent ate of the sector */
+		rc = nvs_flash_ate_rd(fs, close_addr, &close_ate);
+		if (rc) {
+			goto end;
+		}
+
+		fs->gc_addr = close_addr;
+		if (nvs_close_ate_valid(fs, &close_ate)) {
+			fs->gc_addr &= ADDR_SECT_MASK;
+			fs->gc_addr += close_ate.offset;
+		} else {
+			rc = nvs_recover_last_ate(fs, &fs->gc_addr);
+			if (rc) {
+				goto end;
+			}
+		}
+	}
+
+	if (fs->gc_addr == close_addr) {
+		/* all the entries have been moved */
+		LOG_DBG("Erasing sector %d ahead", sec_addr >> ADDR_SECT_SHIFT);
+		rc = nvs_flash_erase_sector(fs, sec_addr);
+		goto end;
+	}
+
+	rc = nvs_flash_ate_rd(fs, fs->gc_addr, &gc_ate);
+	if (rc) {
+		goto end;
+	}
+
+	if (nvs_ate_valid(fs, &gc_ate)) {
+		rc = nvs_gc_ate_live(fs, fs->gc_addr, &gc_ate);
+		if (rc < 0) {
+			goto end;
+		}
+
+		if (rc) {
+			/* leave space for a delete ate, as nvs_write() does */
+			required_space = nvs_al_size(fs, gc_ate.len) + ate_size;
+			if (fs->ate_wra < (fs->data_wra + required_space)) {
+				rc = -ENOSPC;
+				goto end;
+			}
+
+			rc = nvs_gc_move_ate(fs, fs->gc_addr, &gc_ate);
+			if (rc) {
+				goto end;
+			}
+		}
+	}
+
+	/* the oldest ate is the last one before the close ate */
+	fs->gc_addr += ate_size;
+	rc = 0;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif
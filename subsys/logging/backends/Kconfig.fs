@@ -58,4 +58,31 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_BATCH_SIZE
+	int "Write batch size"
+	default 0
+	range 0 LOG_BACKEND_FS_FILE_SIZE
+	depends on LOG_PROCESS_THREAD
+	help
+	  Size of the buffer (in bytes) in which log output is accumulated
+	  before it is written to the file. The buffer is written and the file
+	  synchronized once it is full or when the log processing thread has
+	  processed all pending messages, instead of for every output chunk.
+	  Messages are not split across files as long as they fit in the
+	  buffer, which keeps every file decodable on its own when the
+	  dictionary format is used. Buffered data is lost on panic.
+	  Set to 0 to disable batching.
+
+config LOG_BACKEND_FS_PREALLOCATE
+	bool "Preallocate log files"
+	help
+	  When enabled, each new log file is extended to
+	  LOG_BACKEND_FS_FILE_SIZE when it is created, so that the file system
+	  does not allocate space and update the file size on each write. This
+	  benefits FAT, which otherwise extends the cluster chain and the
+	  directory entry on every synchronization. It is not recommended on
+	  littlefs, where writing in the middle of a file copies its end. The
+	  unused end of a file reads as zeros. After a reboot, logging resumes
+	  in a new file.
+
 endif # LOG_BACKEND_FS
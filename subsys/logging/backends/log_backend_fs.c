@@ -413,6 +413,18 @@ static int allocate_new_file(struct fs_file_t *file)
 	++file_ctr;
 	newest = curr_file_num;
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_PREALLOCATE)) {
+		/* Zero filled, not every file system keeps the write
+		 * position when extending the file.
+		 */
+		rc = fs_truncate(file, CONFIG_LOG_BACKEND_FS_FILE_SIZE);
+		if (rc < 0) {
+			goto out;
+		}
+
+		rc = fs_seek(file, 0, FS_SEEK_SET);
+	}
+
 out:
 	return rc;
 }
@@ -451,8 +463,79 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+static uint8_t batch_buf[CONFIG_LOG_BACKEND_FS_BATCH_SIZE];
+static size_t batch_len;
+/* Start of the message being output. */
+static size_t batch_msg_start;
+
+static void batch_write(uint8_t *data, size_t length)
+{
+	int rc;
+
+	while (length > 0) {
+		rc = write_log_to_file(data, length, NULL);
+		length -= rc;
+		data += rc;
+	}
+}
+
+/* Write complete messages, keep the beginning of the current one. */
+static void batch_flush(bool all)
+{
+	size_t len = all ? batch_len : batch_msg_start;
+
+	if (len == 0) {
+		return;
+	}
+
+	batch_write(batch_buf, len);
+	batch_len -= len;
+	batch_msg_start = 0;
+	memmove(batch_buf, &batch_buf[len], batch_len);
+}
+
+static int batch_out(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (batch_len + length > sizeof(batch_buf)) {
+		batch_flush(false);
+	}
+
+	if (batch_len + length > sizeof(batch_buf)) {
+		/* Message larger than the buffer. */
+		batch_flush(true);
+		batch_write(data, length);
+
+		return length;
+	}
+
+	memcpy(&batch_buf[batch_len], data, length);
+	batch_len += length;
+
+	return length;
+}
+
+static void notify(const struct log_backend *const backend,
+		   enum log_backend_evt event,
+		   union log_backend_evt_arg *arg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(arg);
+
+	if (event == LOG_BACKEND_EVT_PROCESS_THREAD_DONE) {
+		batch_flush(true);
+	}
+}
+
+#define LOG_BACKEND_FS_OUT batch_out
+#else
+#define LOG_BACKEND_FS_OUT write_log_to_file
+#endif /* CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0 */
+
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
-LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+LOG_OUTPUT_DEFINE(log_output, LOG_BACKEND_FS_OUT, buf, MAX_FLASH_WRITE_SIZE);
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
@@ -460,6 +543,11 @@ static void log_backend_fs_init(const struct log_backend *const backend)
 
 static void panic(struct log_backend const *const backend)
 {
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+	/* Do not lose the messages logged before the panic. */
+	batch_flush(true);
+#endif
+
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
@@ -484,6 +572,10 @@ static void process(const struct log_backend *const backend,
 
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+	batch_msg_start = batch_len;
+#endif
+
 	log_output_func(&log_output, &msg->log, flags);
 }
 
@@ -499,6 +591,9 @@ static const struct log_backend_api log_backend_fs_api = {
 	.init = log_backend_fs_init,
 	.dropped = dropped,
 	.format_set = format_set,
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+	.notify = notify,
+#endif
 };
 
 LOG_BACKEND_DEFINE(log_backend_fs, log_backend_fs_api,
@@ -378,6 +378,19 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 
 	shell_print(sh, "\tMaximum usage: %u bytes", max);
 
+	if (IS_ENABLED(CONFIG_LOG_BUFFER_STATS)) {
+		struct log_buffer_stats stats;
+
+		for (uint32_t cpu = 0;
+		     log_buffer_stats_get(cpu, &stats) == 0; cpu++) {
+			shell_print(sh, "\tCPU %u: allocated %u, dropped %u, "
+				    "lock wait %llu cycles (max %u)",
+				    cpu, stats.allocated, stats.dropped,
+				    (unsigned long long)stats.lock_wait,
+				    stats.lock_wait_max);
+		}
+	}
+
 	return 0;
 }
 
@@ -112,15 +112,36 @@ static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
 static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+/* The buffer is split evenly between the CPUs. CPU 0 uses log_buffer, which
+ * is merged with the other CPUs and the links in timestamp order.
+ */
+#define LOG_CPU_BUFFERS CONFIG_MP_MAX_NUM_CPUS
+#define LOG_CPU_BUFFER_WLEN \
+	(ROUND_DOWN(CONFIG_LOG_BUFFER_SIZE / LOG_CPU_BUFFERS, Z_LOG_MSG2_ALIGNMENT) / \
+	 sizeof(int))
+
+static struct mpsc_pbuf_buffer cpu_log_buffer[LOG_CPU_BUFFERS - 1];
+static union log_msg_generic *cpu_log_msg[LOG_CPU_BUFFERS - 1];
+#else
+#define LOG_CPU_BUFFERS 1
+#define LOG_CPU_BUFFER_WLEN (CONFIG_LOG_BUFFER_SIZE / sizeof(int))
+#endif
+
+#ifdef CONFIG_LOG_BUFFER_STATS
+static atomic_t buffer_allocated_cnt[LOG_CPU_BUFFERS];
+static atomic_t buffer_dropped_cnt[LOG_CPU_BUFFERS];
+#endif
+
 static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_CPU_BUFFERS * LOG_CPU_BUFFER_WLEN];
 
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
 	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.size = LOG_CPU_BUFFER_WLEN,
 	.notify_drop = z_log_notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -583,21 +604,95 @@ void z_log_msg_init(void)
 {
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
+
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		config.buf += LOG_CPU_BUFFER_WLEN;
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+		cpu_log_msg[i] = NULL;
+	}
+#endif
+}
+
+static struct mpsc_pbuf_buffer *cpu_buffer_get(uint32_t cpu)
+{
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	return (cpu == 0) ? &log_buffer : &cpu_log_buffer[cpu - 1];
+#else
+	ARG_UNUSED(cpu);
+
+	return &log_buffer;
+#endif
+}
+
+#ifdef CONFIG_LOG_BUFFER_STATS
+/* Index of the CPU owning the buffer, or -1 if it belongs to a link. */
+static int cpu_buffer_idx(const struct mpsc_pbuf_buffer *buffer)
+{
+	for (uint32_t i = 0; i < LOG_CPU_BUFFERS; i++) {
+		if (buffer == cpu_buffer_get(i)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void z_log_buffer_dropped(const struct mpsc_pbuf_buffer *buffer)
+{
+	int idx = cpu_buffer_idx(buffer);
+
+	if (idx >= 0) {
+		atomic_inc(&buffer_dropped_cnt[idx]);
+	}
+}
+#endif /* CONFIG_LOG_BUFFER_STATS */
+
+/* Buffer of the current CPU. A thread moved to another CPU before it commits
+ * the message only contends with the producers of the former CPU.
+ */
+static struct mpsc_pbuf_buffer *local_buffer_get(void)
+{
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	return cpu_buffer_get(arch_curr_cpu()->id);
+#else
+	return &log_buffer;
+#endif
+}
+
+/* Buffer holding a message allocated with z_log_msg_alloc(). */
+static struct mpsc_pbuf_buffer *local_msg_buffer_get(const struct log_msg *msg)
+{
+	return cpu_buffer_get(((const uint32_t *)msg - buf32) / LOG_CPU_BUFFER_WLEN);
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 {
+	struct log_msg *msg;
+
 	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
 		return NULL;
 	}
 
-	return (struct log_msg *)mpsc_pbuf_alloc(buffer, wlen,
+	msg = (struct log_msg *)mpsc_pbuf_alloc(buffer, wlen,
 				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
+
+#ifdef CONFIG_LOG_BUFFER_STATS
+	int idx = cpu_buffer_idx(buffer);
+
+	if (idx >= 0) {
+		atomic_inc(msg ? &buffer_allocated_cnt[idx] : &buffer_dropped_cnt[idx]);
+	}
+#endif
+
+	return msg;
 }
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer_get(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -617,7 +712,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(local_msg_buffer_get(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -625,11 +720,32 @@ union log_msg_generic *z_log_msg_local_claim(void)
 	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+/* Keep the oldest of the message pending in the buffer and the messages seen so far. */
+static void oldest_msg_update(struct mpsc_pbuf_buffer *buffer, union log_msg_generic **pending,
+			      log_timestamp_t *t_min, union log_msg_generic ***chosen)
+{
+	if (*pending == NULL) {
+		*pending = (union log_msg_generic *)mpsc_pbuf_claim(buffer);
+	}
+
+	if (*pending) {
+		log_timestamp_t t = log_msg_get_timestamp(&(*pending)->log);
+
+		if (t < *t_min) {
+			*t_min = t;
+			*chosen = pending;
+			curr_log_buffer = buffer;
+		}
+	}
+}
+
+/* If there are buffers dedicated for each link or CPU, claim the oldest message (lowest
+ * timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
 	union log_msg_generic *msg = NULL;
-	struct log_msg_ptr *chosen;
+	union log_msg_generic **chosen = NULL;
 	log_timestamp_t t_min = sizeof(log_timestamp_t) > sizeof(uint32_t) ?
 				UINT64_MAX : UINT32_MAX;
 	int i = 0;
@@ -640,24 +756,19 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 
 		STRUCT_SECTION_GET(log_mpsc_pbuf, i, &buf);
 
-		if (msg_ptr->msg == NULL) {
-			msg_ptr->msg = (union log_msg_generic *)mpsc_pbuf_claim(&buf->buf);
-		}
-
-		if (msg_ptr->msg) {
-			log_timestamp_t t = log_msg_get_timestamp(&msg_ptr->msg->log);
-
-			if (t < t_min) {
-				t_min = t;
-				msg = msg_ptr->msg;
-				chosen = msg_ptr;
-				curr_log_buffer = &buf->buf;
-			}
-		}
+		oldest_msg_update(&buf->buf, &msg_ptr->msg, &t_min, &chosen);
 		i++;
 	}
 
-	if (msg) {
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	for (i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		oldest_msg_update(&cpu_log_buffer[i], &cpu_log_msg[i], &t_min, &chosen);
+	}
+#endif
+
+	if (chosen) {
+		msg = *chosen;
+
 		if (CONFIG_LOG_PROCESSING_LATENCY_US > 0) {
 			int32_t diff = t_min - (timestamp_func() - proc_latency);
 
@@ -678,7 +789,7 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 			}
 		}
 
-		(*chosen).msg = NULL;
+		*chosen = NULL;
 	}
 
 	if (t_min < prev_timestamp) {
@@ -697,7 +808,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) ||
+	    IS_ENABLED(CONFIG_LOG_PERCPU_BUFFERS)) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -726,9 +838,18 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	for (i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		if (cpu_log_msg[i] || msg_pending(&cpu_log_buffer[i])) {
+			return true;
+		}
+	}
+	i = 0;
+#else
 	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
+#endif
 
 	STRUCT_SECTION_FOREACH(log_msg_ptr, msg_ptr) {
 		struct log_mpsc_pbuf *buf;
@@ -753,7 +874,8 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 {
 	struct log_msg *log_msg = (struct log_msg *)data;
 	size_t wlen = ceiling_fraction(ROUND_UP(len, Z_LOG_MSG2_ALIGNMENT), sizeof(int));
-	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : &log_buffer;
+	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf :
+					       local_buffer_get();
 	struct log_msg *local_msg = msg_alloc(mpsc_pbuffer, wlen);
 
 	if (!local_msg) {
@@ -806,7 +928,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (uint32_t i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t size, now;
+
+		mpsc_pbuf_get_utilization(cpu_buffer_get(i), &size, &now);
+		*buf_size += size;
+		*usage += now;
+	}
 
 	return 0;
 }
@@ -819,7 +950,44 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	*max = 0;
+
+	/* With per-CPU buffers, report the sum of their maximum usage. */
+	for (uint32_t i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t cpu_max;
+		int err = mpsc_pbuf_get_max_utilization(cpu_buffer_get(i), &cpu_max);
+
+		if (err) {
+			return err;
+		}
+
+		*max += cpu_max;
+	}
+
+	return 0;
+}
+
+int log_buffer_stats_get(uint32_t cpu, struct log_buffer_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+		return -EINVAL;
+	}
+
+	if (cpu >= LOG_CPU_BUFFERS) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_LOG_BUFFER_STATS
+	stats->allocated = atomic_get(&buffer_allocated_cnt[cpu]);
+	stats->dropped = atomic_get(&buffer_dropped_cnt[cpu]);
+
+	return mpsc_pbuf_get_lock_stats(cpu_buffer_get(cpu), &stats->lock_wait,
+					&stats->lock_wait_max);
+#else
+	return -ENOTSUP;
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -64,6 +64,22 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+#define CONN_INDEX_BUCKETS CONFIG_NET_CONN_PORT_INDEX_BUCKETS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONN_INDEX_BUCKETS),
+	     "CONFIG_NET_CONN_PORT_INDEX_BUCKETS must be a power of two");
+
+/* UDP/TCP handlers bound to a local port, hashed by that port. Handlers
+ * not bound to a local port are kept in a separate wildcard list. Both are
+ * kept in registration order (newest first) like conn_used, so that the
+ * packet matching gives the same result as when walking conn_used.
+ */
+static sys_slist_t conn_index[CONN_INDEX_BUCKETS];
+static sys_slist_t conn_index_wildcard;
+static uint32_t conn_seq;
+#endif /* CONFIG_NET_CONN_PORT_INDEX */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -135,12 +151,64 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+/* Return the index list of handlers of the given family bound to local_port
+ * (in network byte order), or NULL if such handlers are not indexed.
+ */
+static sys_slist_t *conn_index_list(uint8_t family, uint16_t local_port)
+{
+	if (family != AF_INET && family != AF_INET6 && family != AF_UNSPEC) {
+		return NULL;
+	}
+
+	if (local_port == 0U) {
+		return &conn_index_wildcard;
+	}
+
+	return &conn_index[ntohs(local_port) & (CONN_INDEX_BUCKETS - 1)];
+}
+#endif /* CONFIG_NET_CONN_PORT_INDEX */
+
+/* Must be called with conn_lock held */
+static void conn_index_add(struct net_conn *conn)
+{
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	sys_slist_t *list;
+
+	list = conn_index_list(conn->family,
+			       net_sin(&conn->local_addr)->sin_port);
+	if (list) {
+		conn->seq = ++conn_seq;
+		sys_slist_prepend(list, &conn->index_node);
+	}
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* Must be called with conn_lock held */
+static void conn_index_remove(struct net_conn *conn)
+{
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	sys_slist_t *list;
+
+	list = conn_index_list(conn->family,
+			       net_sin(&conn->local_addr)->sin_port);
+	if (list) {
+		sys_slist_find_and_remove(list, &conn->index_node);
+	}
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_index_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -153,103 +221,136 @@ static void conn_set_unused(struct net_conn *conn)
 	k_mutex_unlock(&conn_lock);
 }
 
-/* Check if we already have identical connection handler installed. */
-static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
-					  const struct sockaddr *remote_addr,
-					  const struct sockaddr *local_addr,
-					  uint16_t remote_port,
-					  uint16_t local_port)
+/* Check if the handler is identical to the given parameters. */
+static bool conn_is_identical(struct net_conn *conn, uint16_t proto,
+			      uint8_t family,
+			      const struct sockaddr *remote_addr,
+			      const struct sockaddr *local_addr,
+			      uint16_t remote_port,
+			      uint16_t local_port)
 {
-	struct net_conn *conn;
-	struct net_conn *tmp;
-
-	k_mutex_lock(&conn_lock, K_FOREVER);
+	if (conn->proto != proto) {
+		return false;
+	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
-		if (conn->proto != proto) {
-			continue;
-		}
+	if (conn->family != family) {
+		return false;
+	}
 
-		if (conn->family != family) {
-			continue;
+	if (remote_addr) {
+		if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			return false;
 		}
 
-		if (remote_addr) {
-			if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
-				continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == AF_INET6 &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(remote_addr)->sin6_addr,
+				    &net_sin6(&conn->remote_addr)->
+							sin6_addr)) {
+				return false;
 			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    remote_addr->sa_family == AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conn->remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conn->remote_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   remote_addr->sa_family == AF_INET &&
-				   remote_addr->sa_family ==
-				   conn->remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conn->remote_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   remote_addr->sa_family == AF_INET &&
+			   remote_addr->sa_family ==
+			   conn->remote_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(remote_addr)->sin_addr,
+				    &net_sin(&conn->remote_addr)->
+							sin_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-			continue;
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		return false;
+	}
 
-		if (local_addr) {
-			if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
-				continue;
-			}
+	if (local_addr) {
+		if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			return false;
+		}
 
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    local_addr->sa_family == AF_INET6 &&
-			    local_addr->sa_family ==
-			    conn->local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conn->local_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   local_addr->sa_family == AF_INET &&
-				   local_addr->sa_family ==
-				   conn->local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conn->local_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    local_addr->sa_family == AF_INET6 &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(local_addr)->sin6_addr,
+				    &net_sin6(&conn->local_addr)->
+							sin6_addr)) {
+				return false;
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   local_addr->sa_family == AF_INET &&
+			   local_addr->sa_family ==
+			   conn->local_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(local_addr)->sin_addr,
+				    &net_sin(&conn->local_addr)->
+							sin_addr)) {
+				return false;
 			}
-		} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-			continue;
+		} else {
+			return false;
 		}
+	} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		return false;
+	}
 
-		if (net_sin(&conn->remote_addr)->sin_port !=
-		    htons(remote_port)) {
-			continue;
-		}
+	if (net_sin(&conn->remote_addr)->sin_port !=
+	    htons(remote_port)) {
+		return false;
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port !=
+	    htons(local_port)) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Check if we already have identical connection handler installed. */
+static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
+					  const struct sockaddr *remote_addr,
+					  const struct sockaddr *local_addr,
+					  uint16_t remote_port,
+					  uint16_t local_port)
+{
+	struct net_conn *conn;
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	sys_slist_t *list;
+#endif
 
-		if (net_sin(&conn->local_addr)->sin_port !=
-		    htons(local_port)) {
-			continue;
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	list = conn_index_list(family, htons(local_port));
+	if (list) {
+		SYS_SLIST_FOR_EACH_CONTAINER(list, conn, index_node) {
+			if (conn_is_identical(conn, proto, family, remote_addr,
+					      local_addr, remote_port,
+					      local_port)) {
+				k_mutex_unlock(&conn_lock);
+				return conn;
+			}
 		}
 
 		k_mutex_unlock(&conn_lock);
-		return conn;
+		return NULL;
+	}
+#endif /* CONFIG_NET_CONN_PORT_INDEX */
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+		if (conn_is_identical(conn, proto, family, remote_addr,
+				      local_addr, remote_port, local_port)) {
+			k_mutex_unlock(&conn_lock);
+			return conn;
+		}
 	}
 
 	k_mutex_unlock(&conn_lock);
@@ -397,6 +498,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_index_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -567,6 +669,89 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_OK;
 }
 
+/* Iterator over the handlers that are candidates for a received packet.
+ * With the port index, a UDP/TCP packet is only matched against the
+ * handlers bound to its destination port and the wildcard handlers. The
+ * two lists are merged in registration order so that the candidates are
+ * seen in the same order as in conn_used.
+ */
+struct conn_iter {
+	sys_snode_t *node;
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	sys_snode_t *port;
+	sys_snode_t *wildcard;
+	bool indexed;
+#endif
+};
+
+static struct net_conn *conn_iter_next(struct conn_iter *iter)
+{
+	struct net_conn *conn;
+
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	if (iter->indexed) {
+		struct net_conn *port = NULL;
+		struct net_conn *wildcard = NULL;
+
+		if (iter->port) {
+			port = CONTAINER_OF(iter->port, struct net_conn,
+					    index_node);
+		}
+
+		if (iter->wildcard) {
+			wildcard = CONTAINER_OF(iter->wildcard, struct net_conn,
+						index_node);
+		}
+
+		if (port && (!wildcard ||
+			     (int32_t)(port->seq - wildcard->seq) > 0)) {
+			iter->port = sys_slist_peek_next(iter->port);
+			return port;
+		}
+
+		if (wildcard) {
+			iter->wildcard = sys_slist_peek_next(iter->wildcard);
+		}
+
+		return wildcard;
+	}
+#endif /* CONFIG_NET_CONN_PORT_INDEX */
+
+	if (!iter->node) {
+		return NULL;
+	}
+
+	conn = CONTAINER_OF(iter->node, struct net_conn, node);
+	iter->node = sys_slist_peek_next(iter->node);
+
+	return conn;
+}
+
+static struct net_conn *conn_iter_first(struct conn_iter *iter,
+					uint8_t family, uint8_t proto,
+					uint16_t dst_port)
+{
+	iter->node = sys_slist_peek_head(&conn_used);
+
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	iter->indexed = (family == AF_INET || family == AF_INET6) &&
+		((IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+		 (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP));
+	if (iter->indexed) {
+		/* Port 0 is never bound, only wildcard handlers can match */
+		iter->port = dst_port == 0U ? NULL :
+			sys_slist_peek_head(conn_index_list(family, dst_port));
+		iter->wildcard = sys_slist_peek_head(&conn_index_wildcard);
+	}
+#else
+	ARG_UNUSED(family);
+	ARG_UNUSED(proto);
+	ARG_UNUSED(dst_port);
+#endif
+
+	return conn_iter_next(iter);
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -616,6 +801,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
+	struct conn_iter iter;
 	struct net_conn *conn;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
@@ -634,7 +820,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	for (conn = conn_iter_first(&iter, pkt_family, proto, dst_port);
+	     conn != NULL; conn = conn_iter_next(&iter)) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
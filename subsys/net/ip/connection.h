@@ -54,6 +54,14 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_PORT_INDEX)
+	/** Internal slist node for the local port index */
+	sys_snode_t index_node;
+
+	/** Registration order, used to keep the matching order */
+	uint32_t seq;
+#endif
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
@@ -1852,6 +1852,35 @@ unlock:
 	return ret;
 }
 
+int net_context_send_zc(struct net_context *context,
+			struct net_buf *frags,
+			struct net_context_zc_tx *tx)
+{
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SEND_ZC)) {
+		return -ENOTSUP;
+	}
+
+	if (!frags || !tx || !tx->cb) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (net_context_get_proto(context) != IPPROTO_TCP) {
+		ret = -EOPNOTSUPP;
+	} else if (net_context_get_state(context) != NET_CONTEXT_CONNECTED) {
+		ret = -ENOTCONN;
+	} else {
+		ret = net_tcp_queue_zc(context, frags, tx);
+	}
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 int net_context_sendmsg(struct net_context *context,
 			const struct msghdr *msghdr,
 			int flags,
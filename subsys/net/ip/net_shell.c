@@ -1291,6 +1291,11 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	PR("TCP cwnd       %u\tssthresh\t%u\n",
+	   GET_STAT(iface, tcp.cwnd),
+	   GET_STAT(iface, tcp.ssthresh));
+#endif
 #endif
 
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
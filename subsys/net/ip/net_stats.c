@@ -152,6 +152,11 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		NET_INFO("TCP cwnd       %u\tssthresh\t%u",
+			 GET_STAT(iface, tcp.cwnd),
+			 GET_STAT(iface, tcp.ssthresh));
+#endif
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
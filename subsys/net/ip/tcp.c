@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/rand32.h>
+#include <zephyr/sys/hash_function.h>
 
 #if defined(CONFIG_NET_TCP_ISN_RFC6528)
 #include <mbedtls/md5.h>
@@ -25,6 +26,9 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "net_stats.h"
 #include "net_private.h"
 #include "tcp_internal.h"
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+#include "sockets_internal.h"
+#endif
 
 #define ACK_TIMEOUT_MS CONFIG_NET_TCP_ACK_TIMEOUT
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
@@ -56,6 +60,34 @@ static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+#define TCP_CONN_HASH_BUCKETS CONFIG_NET_TCP_CONN_HASH_BUCKETS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(TCP_CONN_HASH_BUCKETS),
+	     "CONFIG_NET_TCP_CONN_HASH_BUCKETS must be a power of two");
+
+/* Connections hashed by their 4-tuple. Each bucket has its own lock so that
+ * lookups done by the RX path do not serialize with each other, or with
+ * connection setup and teardown happening in other buckets.
+ */
+static struct tcp_conn_bucket {
+	struct k_spinlock lock;
+	sys_slist_t conns;
+} tcp_conn_hash[TCP_CONN_HASH_BUCKETS];
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+static void tcp_zc_seg_destroy(struct net_buf *buf);
+
+/* Data-less buffers describing the payload of outgoing segments. Each one
+ * points into a fragment of the send_data queue and holds a reference to
+ * it in the user data, so the data stays around until the segment has
+ * been transmitted even if it is acknowledged in the meantime.
+ */
+NET_BUF_POOL_DEFINE(tcp_zc_seg_pool, CONFIG_NET_TCP_SEND_ZC_SEGMENT_BUFS, 0,
+		    sizeof(struct net_buf *), tcp_zc_seg_destroy);
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -69,16 +101,6 @@ static void tcp_out(struct tcp *conn, uint8_t flags);
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
 
-static uint32_t tcp_get_seq(struct net_buf *buf)
-{
-	return *(uint32_t *)net_buf_user_data(buf);
-}
-
-static void tcp_set_seq(struct net_buf *buf, uint32_t seq)
-{
-	*(uint32_t *)net_buf_user_data(buf) = seq;
-}
-
 static int tcp_pkt_linearize(struct net_pkt *pkt, size_t pos, size_t len)
 {
 	struct net_buf *buf, *first = pkt->cursor.buf, *second = first->frags;
@@ -222,6 +244,72 @@ static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+static uint32_t tcp_conn_hash_key(const union tcp_endpoint *local,
+				  const union tcp_endpoint *remote)
+{
+	size_t len = tcp_endpoint_len(local->sa.sa_family);
+	uint8_t key[2 * sizeof(union tcp_endpoint)];
+
+	memcpy(key, local, len);
+	memcpy(key + len, remote, len);
+
+	return sys_hash32_murmur3(key, 2 * len);
+}
+
+static struct tcp_conn_bucket *tcp_conn_bucket_get(uint32_t hash)
+{
+	return &tcp_conn_hash[hash & (TCP_CONN_HASH_BUCKETS - 1)];
+}
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
+/* Remove the connection from the lookup table, must be called before the
+ * endpoints of a hashed connection are changed or the connection is freed.
+ */
+static void tcp_conn_hash_del(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+
+	if (!conn->in_hash) {
+		return;
+	}
+
+	bucket = tcp_conn_bucket_get(conn->hash);
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_find_and_remove(&bucket->conns, &conn->hash_node);
+	conn->in_hash = false;
+	k_spin_unlock(&bucket->lock, key);
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* (Re)insert the connection into the lookup table, must be called whenever
+ * the src/dst endpoints of the connection have been set.
+ */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+
+	tcp_conn_hash_del(conn);
+
+	conn->hash = tcp_conn_hash_key(&conn->src, &conn->dst);
+	bucket = tcp_conn_bucket_get(conn->hash);
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_prepend(&bucket->conns, &conn->hash_node);
+	conn->in_hash = true;
+	k_spin_unlock(&bucket->lock, key);
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
 static const char *tcp_flags(uint8_t flags)
 {
 #define BUF_SIZE 25 /* 6 * 4 + 1 */
@@ -393,6 +481,47 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
+static void tcp_ooo_remove(struct tcp *conn, int first, int count)
+{
+	memmove(&conn->ooo[first], &conn->ooo[first + count],
+		(conn->ooo_count - first - count) * sizeof(conn->ooo[0]));
+	conn->ooo_count -= count;
+}
+
+/* Drop all queued out-of-order data */
+static void tcp_ooo_flush(struct tcp *conn)
+{
+	for (int i = 0; i < conn->ooo_count; i++) {
+		net_buf_unref(conn->ooo[i].buf);
+	}
+
+	conn->ooo_count = 0;
+}
+
+/* Account for len bytes of the send queue having been acknowledged (or
+ * dropped) and call the zero-copy completion callbacks that are due.
+ */
+static void tcp_zc_tx_complete(struct tcp *conn, size_t len, int status)
+{
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	struct net_context_zc_tx *tx, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn->zc_tx, tx, next, node) {
+		tx->pending -= MIN(tx->pending, len);
+		if (tx->pending > 0) {
+			continue;
+		}
+
+		sys_slist_find_and_remove(&conn->zc_tx, &tx->node);
+		tx->cb(conn->context, tx, status);
+	}
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(len);
+	ARG_UNUSED(status);
+#endif
+}
+
 
 static int tcp_conn_unref(struct tcp *conn)
 {
@@ -434,6 +563,8 @@ static int tcp_conn_unref(struct tcp *conn)
 		conn->context->conn_handler = NULL;
 	}
 
+	tcp_zc_tx_complete(conn, SIZE_MAX, -ECONNABORTED);
+
 	conn->context->tcp = NULL;
 
 	net_context_unref(conn->context);
@@ -443,15 +574,15 @@ static int tcp_conn_unref(struct tcp *conn)
 	k_work_cancel_delayable(&conn->send_data_timer);
 	tcp_pkt_unref(conn->send_data);
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-		tcp_pkt_unref(conn->queue_recv_data);
-	}
+	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
+	tcp_ooo_flush(conn);
 
 	(void)k_work_cancel_delayable(&conn->timewait_timer);
 	(void)k_work_cancel_delayable(&conn->fin_timer);
 	(void)k_work_cancel_delayable(&conn->persist_timer);
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 
+	tcp_conn_hash_del(conn);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 
 	memset(conn, 0, sizeof(*conn));
@@ -661,6 +792,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_perm_found = false;
+	recv_options->sack_count = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -709,6 +844,35 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count =
+				MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+				    NET_TCP_SACK_MAX_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_count; i++) {
+				uint8_t *blk = options + 2 +
+					       i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start = sys_get_be32(blk);
+				recv_options->sack[i].end = sys_get_be32(blk + 4);
+			}
+
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -770,60 +934,44 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 				     size_t len)
 {
+	struct tcphdr *th = th_get(pkt);
+	uint32_t expected_seq = th_seq(th) + len;
+	struct tcp_ooo_range *range = &conn->ooo[0];
 	size_t pending_len = 0;
+	uint32_t end_offset;
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
-	    !net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
-		 */
-		struct tcphdr *th = th_get(pkt);
-		uint32_t expected_seq = th_seq(th) + len;
-		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
-			}
+	if (conn->ooo_count == 0) {
+		return 0;
+	}
 
-			NET_DBG("Found pending data seq %u len %zd",
-				expected_seq, pending_len);
+	/* Drop the queued ranges the incoming data covers completely */
+	while (conn->ooo_count > 0 &&
+	       net_tcp_seq_cmp(range->seq + range->len, expected_seq) <= 0) {
+		net_buf_unref(range->buf);
+		tcp_ooo_remove(conn, 0, 1);
+	}
+
+	/* The first remaining range may continue the incoming data, the
+	 * ranges are never adjacent so the next one cannot.
+	 */
+	if (conn->ooo_count > 0 &&
+	    net_tcp_seq_cmp(range->seq, expected_seq) <= 0) {
+		end_offset = expected_seq - range->seq;
+		if (end_offset) {
+			net_pkt_remove_tail(pkt, end_offset);
+		}
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+		pending_len = range->len - end_offset;
 
-			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
+		NET_DBG("Found pending data seq %u len %zd",
+			expected_seq, pending_len);
 
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
+		net_buf_frag_add(pkt->buffer, range->buf);
+		tcp_ooo_remove(conn, 0, 1);
+	}
 
-			pending_len = 0;
-		}
+	if (conn->ooo_count == 0) {
+		k_work_cancel_delayable(&conn->recv_queue_timer);
 	}
 
 	return pending_len;
@@ -880,6 +1028,42 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Length of the TCP options of the next segment sent on the connection */
+static size_t tcp_options_size(struct tcp *conn)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		len += NET_TCP_MSS_SIZE;
+
+#if defined(CONFIG_NET_TCP_SACK)
+		/* SACK permitted, padded with two NOPs */
+		if (conn->sack_enabled) {
+			len += 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+		}
+#endif
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK blocks for the queued data, padded with two NOPs */
+	if (conn->sack_enabled && conn->ooo_count > 0) {
+		len += 2 * NET_TCP_NOP_SIZE + 2 +
+		       MIN(conn->ooo_count, NET_TCP_SACK_MAX_BLOCKS) *
+		       NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+
+	return len;
+}
+
+/* Payload of a full segment, the options sent with it taking room from
+ * the MSS
+ */
+static int tcp_seg_size(struct tcp *conn)
+{
+	return conn_mss(conn) - tcp_options_size(conn);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -895,11 +1079,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + tcp_options_size(conn) / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -960,6 +1140,53 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
+static int set_tcp_congestion(struct tcp *conn, const void *value,
+			      size_t len)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	const struct tcp_cc_ops *cc;
+
+	cc = tcp_cc_find(value, len);
+	if (!cc) {
+		return -ENOENT;
+	}
+
+	/* The window is kept, only the algorithm state starts over */
+	conn->cc = cc;
+	conn->cc->init(conn);
+
+	return 0;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOPROTOOPT;
+#endif
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	size_t name_len = strlen(conn->cc->name) + 1;
+
+	if (!len || *len < name_len) {
+		return -EINVAL;
+	}
+
+	memcpy(value, conn->cc->name, name_len);
+	*len = name_len;
+
+	return 0;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOPROTOOPT;
+#endif
+}
+
 static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
@@ -979,6 +1206,77 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static size_t tcp_sack_block_put(uint8_t *buf, struct tcp_ooo_range *range)
+{
+	sys_put_be32(range->seq, buf);
+	sys_put_be32(range->seq + range->len, buf + 4);
+
+	return NET_TCP_SACK_BLOCK_SIZE;
+}
+#endif
+
+static int net_tcp_set_sack_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	struct tcp_ooo_range *range;
+	size_t len = 0;
+	int recent = 0;
+	int count;
+
+	if (conn->send_options.mss_found && conn->sack_enabled) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (conn->sack_enabled && conn->ooo_count > 0) {
+		count = MIN(conn->ooo_count, NET_TCP_SACK_MAX_BLOCKS);
+
+		/* The first block must contain the most recently received
+		 * segment (RFC 2018), the rest follow in sequence order.
+		 */
+		for (int i = 0; i < conn->ooo_count; i++) {
+			range = &conn->ooo[i];
+
+			if (conn->ooo_recent - range->seq < range->len) {
+				recent = i;
+				break;
+			}
+		}
+
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_OPT;
+		opts[len++] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+		len += tcp_sack_block_put(&opts[len], &conn->ooo[recent]);
+		count--;
+
+		for (int i = 0; i < conn->ooo_count && count > 0; i++) {
+			if (i != recent) {
+				len += tcp_sack_block_put(&opts[len],
+							  &conn->ooo[i]);
+				count--;
+			}
+		}
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	return net_pkt_write(pkt, opts, len);
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1005,14 +1303,10 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	size_t alloc_len = sizeof(struct tcphdr) + tcp_options_size(conn);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1045,6 +1339,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	ret = net_tcp_set_sack_opt(conn, pkt);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1111,90 +1411,577 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
-static bool tcp_window_full(struct tcp *conn)
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+static void tcp_zc_seg_destroy(struct net_buf *buf)
+{
+	struct net_buf *frag = *(struct net_buf **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	net_buf_unref(frag);
+}
+
+/* Like tcp_pkt_peek() but the data is referenced instead of copied */
+static int tcp_pkt_slice(struct net_pkt *to, struct net_pkt *from, size_t pos,
+			 size_t len)
+{
+	struct net_buf *frag = from->buffer;
+	struct net_buf *seg;
+	size_t seg_len;
+
+	while (frag && pos >= frag->len) {
+		pos -= frag->len;
+		frag = frag->frags;
+	}
+
+	while (frag && len > 0) {
+		seg_len = MIN(len, frag->len - pos);
+
+		seg = net_buf_alloc_with_data(&tcp_zc_seg_pool,
+					      frag->data + pos, seg_len,
+					      K_NO_WAIT);
+		if (!seg) {
+			return -ENOBUFS;
+		}
+
+		*(struct net_buf **)net_buf_user_data(seg) = net_buf_ref(frag);
+		net_pkt_append_buffer(to, seg);
+
+		len -= seg_len;
+		pos = 0;
+		frag = frag->frags;
+	}
+
+	return len ? -EINVAL : 0;
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
+/* Remove len acknowledged bytes from the head of the send_data queue */
+static int tcp_send_data_ack(struct tcp *conn, size_t len)
+{
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	struct net_buf *frag = conn->send_data->buffer;
+
+	/* Outgoing segments may still reference the queued buffers, so they
+	 * are not pulled: only fully acknowledged buffers are released and
+	 * the acknowledged part of the first one is skipped when sending.
+	 */
+	if (len > net_pkt_get_len(conn->send_data) - conn->send_data_offset) {
+		return -EINVAL;
+	}
+
+	conn->send_data_offset += len;
+
+	while (frag && conn->send_data_offset >= frag->len) {
+		conn->send_data_offset -= frag->len;
+		frag = net_buf_frag_del(NULL, frag);
+	}
+
+	conn->send_data->buffer = frag;
+	net_pkt_cursor_init(conn->send_data);
+
+	return 0;
+#else
+	return tcp_pkt_pull(conn->send_data, len);
+#endif
+}
+
+static bool tcp_window_full(struct tcp *conn)
+{
+	bool window_full = (conn->send_data_total >= conn->send_win);
+
+	NET_DBG("conn: %p window_full=%hu", conn, window_full);
+
+	return window_full;
+}
+
+/* The send window opened, wake up the senders and epoll waiters */
+static void tcp_tx_sem_give(struct tcp *conn)
+{
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	if (k_sem_count_get(&conn->tx_sem) == 0 && conn->context != NULL) {
+		k_sem_give(&conn->tx_sem);
+		zsock_epoll_notify(conn->context);
+		return;
+	}
+#endif
+
+	k_sem_give(&conn->tx_sem);
+}
+
+/* How much data may be in flight, limited by the receive window of the
+ * peer and by the congestion window.
+ */
+static int tcp_send_window(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN(conn->send_win, conn->cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
+static int tcp_unsent_len(struct tcp *conn)
+{
+	int send_win = tcp_send_window(conn);
+	int unsent_len;
+
+	if (conn->unacked_len > conn->send_data_total) {
+		NET_ERR("total=%zu, unacked_len=%d",
+			conn->send_data_total, conn->unacked_len);
+		unsent_len = -ERANGE;
+		goto out;
+	}
+
+	unsent_len = conn->send_data_total - conn->unacked_len;
+	if (conn->unacked_len >= send_win) {
+		unsent_len = 0;
+	} else {
+		unsent_len = MIN(unsent_len, send_win - conn->unacked_len);
+	}
+ out:
+	NET_DBG("unsent_len=%d", unsent_len);
+
+	return unsent_len;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_remove(struct tcp *conn, int first, int count)
+{
+	memmove(&conn->sacked[first], &conn->sacked[first + count],
+		(conn->sacked_count - first - count) * sizeof(conn->sacked[0]));
+	conn->sacked_count -= count;
+}
+
+/* Add a block to the scoreboard, which is kept sorted and merged */
+static void tcp_sack_insert(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int first, last;
+
+	/* Blocks [first, last) overlap or touch the new one */
+	for (first = 0; first < conn->sacked_count; first++) {
+		if (net_tcp_seq_cmp(sacked[first].end, start) >= 0) {
+			break;
+		}
+	}
+
+	for (last = first; last < conn->sacked_count; last++) {
+		if (net_tcp_seq_cmp(sacked[last].start, end) > 0) {
+			break;
+		}
+	}
+
+	if (first < last) {
+		if (net_tcp_seq_cmp(sacked[first].start, start) < 0) {
+			start = sacked[first].start;
+		}
+
+		if (net_tcp_seq_cmp(sacked[last - 1].end, end) > 0) {
+			end = sacked[last - 1].end;
+		}
+
+		tcp_sack_remove(conn, first + 1, last - first - 1);
+	} else {
+		if (conn->sacked_count == ARRAY_SIZE(conn->sacked)) {
+			/* Holes are repaired from the lowest one up, so the
+			 * highest block is the least useful.
+			 */
+			if (first == conn->sacked_count) {
+				return;
+			}
+
+			conn->sacked_count--;
+		}
+
+		memmove(&sacked[first + 1], &sacked[first],
+			(conn->sacked_count - first) * sizeof(sacked[0]));
+		conn->sacked_count++;
+	}
+
+	sacked[first].start = start;
+	sacked[first].end = end;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Merge the SACK blocks of the last received segment to the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t high = conn->seq + conn->send_data_total;
+	struct tcp_sack_block *blk;
+
+	/* Nothing has been resent for the holes of a new scoreboard */
+	if (conn->sacked_count == 0) {
+		conn->sack_rexmit_next = conn->seq;
+	}
+
+	for (int i = 0; conn->sack_enabled && i < opts->sack_count; i++) {
+		blk = &opts->sack[i];
+
+		/* Ignore blocks which do not cover unacknowledged data */
+		if (net_tcp_seq_cmp(blk->start, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(blk->end, blk->start) <= 0 ||
+		    net_tcp_seq_cmp(blk->end, high) > 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, blk->start, blk->end);
+	}
+
+	opts->sack_count = 0;
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* Forget the blocks below the acknowledged sequence number */
+static void tcp_sack_prune(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	while (conn->sacked_count > 0 &&
+	       net_tcp_seq_cmp(conn->sacked[0].end, conn->seq) <= 0) {
+		tcp_sack_remove(conn, 0, 1);
+	}
+
+	if (conn->sacked_count > 0 &&
+	    net_tcp_seq_cmp(conn->sacked[0].start, conn->seq) < 0) {
+		conn->sacked[0].start = conn->seq;
+	}
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* Move unacked_len past the data the peer has selectively acknowledged
+ * and return how much, at most one segment, can be sent before the next
+ * such block.
+ */
+static int tcp_sack_skip(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	uint32_t pos;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		pos = conn->seq + conn->unacked_len;
+
+		if (net_tcp_seq_cmp(pos, conn->sacked[i].start) < 0) {
+			return MIN(conn->sacked[i].start - pos,
+				   tcp_seg_size(conn));
+		}
+
+		if (net_tcp_seq_cmp(pos, conn->sacked[i].end) < 0) {
+			conn->unacked_len = conn->sacked[i].end - conn->seq;
+		}
+	}
+#endif
+
+	return tcp_seg_size(conn);
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int max_len;
+	int len;
+	size_t pos = conn->unacked_len;
+	struct net_pkt *pkt;
+
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	pos += conn->send_data_offset;
+#endif
+
+	/* Do not send again what the peer already has */
+	max_len = tcp_sack_skip(conn);
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_window(conn) - conn->unacked_len,
+		   max_len);
+	if (len <= 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	/* Reference the queued data if possible, copy it otherwise */
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (pkt && tcp_pkt_slice(pkt, conn->send_data, pos, len) < 0) {
+		tcp_pkt_unref(pkt);
+		pkt = NULL;
+	}
+
+	if (pkt) {
+		goto send;
+	}
+#endif
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+send:
+#endif
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	if (ret == 0) {
+		conn->unacked_len += len;
+
+		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+			net_stats_update_tcp_resent(conn->iface, len);
+			net_stats_update_tcp_seg_rexmit(conn->iface);
+		} else {
+			net_stats_update_tcp_sent(conn->iface, len);
+			net_stats_update_tcp_seg_sent(conn->iface);
+		}
+	}
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	conn_send_data_dump(conn);
+
+ out:
+	return ret;
+}
+
+/* Retransmit the lowest hole in the scoreboard which has not been resent
+ * yet, once enough data above it has been selectively acknowledged for the
+ * hole to be considered lost (RFC 6675).
+ */
+static void tcp_sack_rexmit(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	int unacked_len = conn->unacked_len;
+	uint32_t next = conn->sack_rexmit_next;
+	uint32_t sacked_above = 0;
+	int hole = -1;
+
+	if (conn->sacked_count == 0 || conn->unacked_len == 0 ||
+	    conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(next, conn->seq) < 0) {
+		next = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (hole < 0) {
+			if (net_tcp_seq_cmp(next, conn->sacked[i].start) >= 0) {
+				if (net_tcp_seq_cmp(next, conn->sacked[i].end) < 0) {
+					next = conn->sacked[i].end;
+				}
+
+				continue;
+			}
+
+			/* The hole is [next, sacked[i].start) */
+			hole = i;
+		}
+
+		sacked_above += conn->sacked[i].end - conn->sacked[i].start;
+	}
+
+	if (hole < 0 ||
+	    (conn->sacked_count - hole < DUPLICATE_ACK_RETRANSMIT_TRHESHOLD &&
+	     sacked_above <= (DUPLICATE_ACK_RETRANSMIT_TRHESHOLD - 1) *
+			     conn_mss(conn))) {
+		return;
+	}
+
+	NET_DBG("conn: %p resend hole at %u", conn, next);
+
+	conn->unacked_len = next - conn->seq;
+
+	if (tcp_send_data(conn) == 0) {
+		conn->sack_rexmit_next = conn->seq + conn->unacked_len;
+	}
+
+	conn->unacked_len = unacked_len;
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* Resend the first unacknowledged segment */
+static void tcp_rexmit_head(struct tcp *conn)
+{
+	int unacked_len = conn->unacked_len;
+
+	conn->unacked_len = 0;
+
+	(void)tcp_send_data(conn);
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_rexmit_next = conn->seq + conn->unacked_len;
+#endif
+
+	/* Restore the current transmission */
+	conn->unacked_len = unacked_len;
+}
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Neither the congestion window nor the send window can exceed this
+ * without window scaling.
+ */
+#define TCP_CWND_MAX UINT16_MAX
+
+static void tcp_ca_update_stats(struct tcp *conn)
+{
+	conn->cwnd = CLAMP(conn->cwnd, conn_mss(conn), TCP_CWND_MAX);
+
+	net_stats_update_tcp_cwnd(conn->iface, conn->cwnd, conn->ssthresh);
+}
+#endif
+
+/* Called once the connection is established and the MSS is known */
+static void tcp_ca_init(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	uint16_t mss = conn_mss(conn);
+
+	/* Initial window (RFC 6928) */
+	conn->cwnd = MIN(10U * mss, MAX(2U * mss, 14600U));
+	conn->ssthresh = TCP_CWND_MAX;
+	conn->in_recovery = false;
+	conn->cc->init(conn);
+
+	tcp_ca_update_stats(conn);
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* New data was acknowledged, conn->seq and conn->unacked_len are
+ * already updated.
+ */
+static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked)
 {
-	bool window_full = (conn->send_data_total >= conn->send_win);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	uint16_t mss = conn_mss(conn);
+
+	if (conn->in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+			/* Full acknowledgment, deflate the window (RFC 6582) */
+			conn->cwnd = MIN(conn->ssthresh,
+					 MAX((uint32_t)conn->unacked_len, mss) + mss);
+			conn->in_recovery = false;
+		} else {
+			/* Partial acknowledgment, the segment after the acked
+			 * data was lost too.
+			 */
+			conn->cwnd -= MIN(conn->cwnd, acked);
+			if (acked >= mss) {
+				conn->cwnd += mss;
+			}
 
-	NET_DBG("conn: %p window_full=%hu", conn, window_full);
+#if defined(CONFIG_NET_TCP_SACK)
+			/* tcp_sack_rexmit() takes care of the holes */
+			if (conn->sacked_count == 0)
+#endif
+			{
+				tcp_rexmit_head(conn);
+			}
+		}
+	} else if (conn->cwnd < conn->ssthresh) {
+		/* Slow start, counting at most one segment per ACK */
+		conn->cwnd += MIN(acked, mss);
+	} else {
+		conn->cc->cong_avoid(conn, acked, mss);
+	}
 
-	return window_full;
+	tcp_ca_update_stats(conn);
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(acked);
+#endif
 }
 
-static int tcp_unsent_len(struct tcp *conn)
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* The third duplicate ACK arrived and the head is about to be resent */
+static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	int unsent_len;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	uint16_t mss = conn_mss(conn);
 
-	if (conn->unacked_len > conn->send_data_total) {
-		NET_ERR("total=%zu, unacked_len=%d",
-			conn->send_data_total, conn->unacked_len);
-		unsent_len = -ERANGE;
-		goto out;
+	if (conn->in_recovery) {
+		return;
 	}
 
-	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
-		unsent_len = 0;
-	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
-	}
- out:
-	NET_DBG("unsent_len=%d", unsent_len);
+	conn->ssthresh = conn->cc->ssthresh(conn, mss);
+	conn->cwnd = conn->ssthresh + DUPLICATE_ACK_RETRANSMIT_TRHESHOLD * mss;
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->in_recovery = true;
 
-	return unsent_len;
+	tcp_ca_update_stats(conn);
+#else
+	ARG_UNUSED(conn);
+#endif
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Another duplicate ACK during fast recovery, a segment has left the
+ * network so the window is inflated. Returns true if new data may be
+ * sent.
+ */
+static bool tcp_ca_dup_ack(struct tcp *conn)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
-
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (!conn->in_recovery) {
+		return false;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
-	}
+	conn->cwnd += conn_mss(conn);
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
-	}
+	tcp_ca_update_stats(conn);
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
-	if (ret == 0) {
-		conn->unacked_len += len;
+	return true;
+#else
+	ARG_UNUSED(conn);
 
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
-			net_stats_update_tcp_resent(conn->iface, len);
-			net_stats_update_tcp_seg_rexmit(conn->iface);
-		} else {
-			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
-		}
+	return false;
+#endif
+}
+#endif /* CONFIG_NET_TCP_FAST_RETRANSMIT */
+
+/* The retransmission timer expired with data in flight */
+static void tcp_ca_timeout(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (conn->unacked_len == 0) {
+		return;
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
+	/* Keep the threshold when the same data times out again
+	 * (RFC 5681, 3.1)
 	 */
-	tcp_pkt_unref(pkt);
+	if (conn->send_data_retries == 0) {
+		conn->ssthresh = conn->cc->ssthresh(conn, conn_mss(conn));
+	}
 
-	conn_send_data_dump(conn);
+	conn->cwnd = conn_mss(conn);
+	conn->in_recovery = false;
 
- out:
-	return ret;
+	tcp_ca_update_stats(conn);
+#else
+	ARG_UNUSED(conn);
+#endif
 }
 
 /* Send all queued but unsent data from the send_data packet by packet
@@ -1252,12 +2039,10 @@ static void tcp_cleanup_recv_queue(struct k_work *work)
 
 	k_mutex_lock(&conn->lock, K_FOREVER);
 
-	NET_DBG("Cleanup recv queue conn %p len %zd seq %u", conn,
-		net_pkt_get_len(conn->queue_recv_data),
-		tcp_get_seq(conn->queue_recv_data->buffer));
+	NET_DBG("Cleanup recv queue conn %p ranges %d", conn,
+		conn->ooo_count);
 
-	net_buf_unref(conn->queue_recv_data->buffer);
-	conn->queue_recv_data->buffer = NULL;
+	tcp_ooo_flush(conn);
 
 	k_mutex_unlock(&conn->lock);
 }
@@ -1280,6 +2065,8 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	tcp_ca_timeout(conn);
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1431,15 +2218,6 @@ static struct tcp *tcp_conn_alloc(struct net_context *context)
 
 	memset(conn, 0, sizeof(*conn));
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-		conn->queue_recv_data = tcp_rx_pkt_alloc(conn, 0);
-		if (conn->queue_recv_data == NULL) {
-			NET_ERR("Cannot allocate %s queue for conn %p", "recv",
-				conn);
-			goto fail;
-		}
-	}
-
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	if (conn->send_data == NULL) {
 		NET_ERR("Cannot allocate %s queue for conn %p", "send", conn);
@@ -1458,6 +2236,9 @@ static struct tcp *tcp_conn_alloc(struct net_context *context)
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	conn->dup_ack_cnt = 0;
 #endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	conn->cc = tcp_cc_default();
+#endif
 
 	/* Set the recv_win with the rcvbuf configured for the socket. */
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF) &&
@@ -1493,11 +2274,6 @@ out:
 	return conn;
 
 fail:
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->queue_recv_data) {
-		tcp_pkt_unref(conn->queue_recv_data);
-		conn->queue_recv_data = NULL;
-	}
-
 	k_mem_slab_free(&tcp_conns_slab, (void **)&conn);
 	return NULL;
 }
@@ -1524,36 +2300,54 @@ out:
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static bool tcp_conn_cmp(struct tcp *conn, union tcp_endpoint *local,
+			 union tcp_endpoint *remote)
 {
-	union tcp_endpoint ep_tmp;
-
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
-	}
-
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
-}
+	size_t len = tcp_endpoint_len(conn->src.sa.sa_family);
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
-{
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
+	return !memcmp(&conn->src, local, len) &&
+		!memcmp(&conn->dst, remote, len);
 }
 
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	bool found = false;
+	union tcp_endpoint local;
+	union tcp_endpoint remote;
 	struct tcp *conn;
-	struct tcp *tmp;
+	bool found = false;
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+	uint32_t hash;
+#endif
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
+	if (tcp_endpoint_set(&local, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&remote, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+	hash = tcp_conn_hash_key(&local, &remote);
+	bucket = tcp_conn_bucket_get(hash);
+
+	key = k_spin_lock(&bucket->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&bucket->conns, conn, hash_node) {
+		found = conn->hash == hash && tcp_conn_cmp(conn, &local, &remote);
+		if (found) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&bucket->lock, key);
+#else
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conns, conn, next) {
+		found = tcp_conn_cmp(conn, &local, &remote);
 		if (found) {
 			break;
 		}
 	}
+#endif /* CONFIG_NET_TCP_CONN_HASH */
 
 	return found ? conn : NULL;
 }
@@ -1592,6 +2386,9 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
 
 		conn->accepted_conn = conn_old;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		conn->cc = conn_old->cc;
+#endif
 	}
  in:
 	if (conn) {
@@ -1734,6 +2531,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr),
@@ -1806,165 +2605,122 @@ static bool tcp_validate_seq(struct tcp *conn, struct tcphdr *hdr)
 		(net_tcp_seq_cmp(th_seq(hdr), conn->ack + conn->recv_win) < 0);
 }
 
-static bool check_seq_list(struct net_buf *buf)
-{
-	struct net_buf *last = NULL;
-	struct net_buf *tmp = buf;
-	uint32_t seq;
-	uint32_t next_seq = 0;
-	bool result = true;
-
-	while (tmp) {
-		seq = tcp_get_seq(tmp);
-
-		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
-
-		if (last != NULL) {
-			if (next_seq != seq) {
-				result = false;
-			}
-		}
-
-		next_seq = seq + tmp->len;
-		last = tmp;
-		tmp = tmp->frags;
-	}
-	return result;
-}
-
+/* Queue out-of-order data. The queue is an array of ranges sorted by
+ * sequence number which neither overlap nor touch each other, so the new
+ * data is trimmed against and merged with the ranges around it.
+ */
 static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
-	uint32_t seq_start = seq;
-	bool inserted = false;
-	struct net_buf *tmp;
+	struct tcp_ooo_range *ooo = conn->ooo;
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
+	uint32_t start = seq;
+	uint32_t end = seq + len;
+	uint32_t range_end;
+	int first, last;
 
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
-	tmp = pkt->buffer;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Reported first in the SACK option of the next ACK */
+	conn->ooo_recent = seq;
+#endif
 
-	tcp_set_seq(tmp, seq);
-	seq += tmp->len;
-	tmp = tmp->frags;
+	/* Ranges [first, last) overlap or touch the new data */
+	for (first = 0; first < conn->ooo_count; first++) {
+		if (net_tcp_seq_cmp(ooo[first].seq + ooo[first].len, start) >= 0) {
+			break;
+		}
+	}
 
-	while (tmp) {
-		tcp_set_seq(tmp, seq);
-		seq += tmp->len;
-		tmp = tmp->frags;
+	for (last = first; last < conn->ooo_count; last++) {
+		if (net_tcp_seq_cmp(ooo[last].seq, end) > 0) {
+			break;
+		}
 	}
 
-	if (IS_ENABLED(CONFIG_NET_TCP_LOG_LEVEL_DBG)) {
-		NET_DBG("Queuing data: conn %p", conn);
+	if (first == last && conn->ooo_count == ARRAY_SIZE(conn->ooo)) {
+		/* Keep the data closest to the expected sequence number */
+		if (first == conn->ooo_count) {
+			NET_DBG("Cannot add new data to queue");
+			return;
+		}
+
+		conn->ooo_count--;
+		net_buf_unref(ooo[conn->ooo_count].buf);
 	}
 
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
+	if (first < last && net_tcp_seq_cmp(ooo[first].seq, start) <= 0) {
+		range_end = ooo[first].seq + ooo[first].len;
+		if (net_tcp_seq_cmp(range_end, end) >= 0) {
+			NET_DBG("Data already queued");
+			return;
+		}
 
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
+		/* Append the part of the new data not queued yet */
+		if (range_end != start) {
+			tcp_pkt_pull(pkt, range_end - start);
+		}
 
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = seq - pending_seq;
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
+		start = ooo[first].seq;
+		head = ooo[first].buf;
+		ooo[first].buf = NULL;
+	}
 
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data->buffer);
-				NET_DBG("Adding at before queue, end_offset %i, pending_len %zu",
-					end_offset, pending_len);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
+	if (first < last && ooo[last - 1].buf != NULL) {
+		range_end = ooo[last - 1].seq + ooo[last - 1].len;
+		if (net_tcp_seq_cmp(range_end, end) > 0) {
+			/* Prepend the part of the new data not queued yet */
+			if (end != ooo[last - 1].seq) {
+				net_pkt_remove_tail(pkt, end - ooo[last - 1].seq);
 			}
-		} else {
-			struct net_buf *last;
 
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
+			end = range_end;
+			tail = ooo[last - 1].buf;
+			ooo[last - 1].buf = NULL;
+		}
+	}
 
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
+	/* The new data replaces the ranges it covers completely */
+	for (int i = first; i < last; i++) {
+		if (ooo[i].buf != NULL) {
+			net_buf_unref(ooo[i].buf);
+		}
+	}
 
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_pkt_remove_tail(conn->queue_recv_data,
-								    end_offset);
-					}
+	if (head != NULL) {
+		net_buf_frag_add(head, pkt->buffer);
+	} else {
+		head = pkt->buffer;
+	}
 
-					/* Put new data after pending data */
-					NET_DBG("Adding at end of queue, start %i, end %i, len %zu",
-						start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data->buffer,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
-		}
+	if (tail != NULL) {
+		net_buf_frag_add(head, tail);
+	}
 
-		if (inserted) {
-			NET_DBG("All pending data: conn %p", conn);
-			if (check_seq_list(conn->queue_recv_data->buffer) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-			}
-		} else {
-			NET_DBG("Cannot add new data to queue");
-		}
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
+
+	if (first == last) {
+		memmove(&ooo[first + 1], &ooo[first],
+			(conn->ooo_count - first) * sizeof(ooo[0]));
+		conn->ooo_count++;
 	} else {
-		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
+		tcp_ooo_remove(conn, first + 1, last - first - 1);
 	}
 
-	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
+	ooo[first].buf = head;
+	ooo[first].seq = start;
+	ooo[first].len = end - start;
 
-		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
-			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
-				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
-		}
+	NET_DBG("Queued range %u len %u, %d ranges", start, end - start,
+		conn->ooo_count);
+
+	if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 	}
 }
 
@@ -2145,7 +2901,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (tcp_window_full(conn)) {
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
-			k_sem_give(&conn->tx_sem);
+			tcp_tx_sem_give(conn);
 		}
 	}
 
@@ -2155,6 +2911,9 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_enabled = conn->recv_options.sack_perm_found;
+#endif
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -2170,6 +2929,10 @@ next_state:
 						    ACK_TIMEOUT);
 			verdict = NET_OK;
 		} else {
+#if defined(CONFIG_NET_TCP_SACK)
+			/* Offer SACK, the SYN-ACK tells if the peer agrees */
+			conn->sack_enabled = true;
+#endif
 			conn->send_options.mss_found = true;
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
@@ -2182,6 +2945,7 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+			tcp_ca_init(conn);
 			next = TCP_ESTABLISHED;
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
@@ -2222,6 +2986,9 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_enabled = conn->recv_options.sack_perm_found;
+#endif
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -2235,6 +3002,7 @@ next_state:
 				verdict = NET_OK;
 			}
 
+			tcp_ca_init(conn);
 			next = TCP_ESTABLISHED;
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
@@ -2288,6 +3056,10 @@ next_state:
 			break;
 		}
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -2304,19 +3076,21 @@ next_state:
 				conn->dup_ack_cnt = 0;
 			}
 
-			/* Only do fast retransmit when not already in a resend state */
+			/* During fast recovery every further duplicate ACK
+			 * inflates the window, the threshold does not apply.
+			 */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
-			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
-
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+			    (len == 0) && (conn->send_data_total > 0) &&
+			    tcp_ca_dup_ack(conn)) {
+				(void)tcp_send_queued_data(conn);
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				   (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				/* Only do fast retransmit when not already in a resend state */
+				tcp_ca_fast_retransmit(conn);
+				tcp_rexmit_head(conn);
 			}
+
+			tcp_sack_rexmit(conn);
 		}
 #endif
 
@@ -2326,8 +3100,7 @@ next_state:
 			NET_DBG("conn: %p len_acked=%u", conn, len_acked);
 
 			if ((conn->send_data_total < len_acked) ||
-					(tcp_pkt_pull(conn->send_data,
-						      len_acked) < 0)) {
+					(tcp_send_data_ack(conn, len_acked) < 0)) {
 				NET_ERR("conn: %p, Invalid len_acked=%u "
 					"(total=%zu)", conn, len_acked,
 					conn->send_data_total);
@@ -2344,6 +3117,8 @@ next_state:
 #endif
 
 			conn->send_data_total -= len_acked;
+			tcp_zc_tx_complete(conn, len_acked, 0);
+
 			if (conn->unacked_len < len_acked) {
 				conn->unacked_len = 0;
 			} else {
@@ -2351,10 +3126,12 @@ next_state:
 			}
 
 			if (!tcp_window_full(conn)) {
-				k_sem_give(&conn->tx_sem);
+				tcp_tx_sem_give(conn);
 			}
 
 			conn_seq(conn, + len_acked);
+			tcp_sack_prune(conn);
+			tcp_ca_pkts_acked(conn, len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
 			conn_send_data_dump(conn);
@@ -2384,6 +3161,9 @@ next_state:
 				break;
 			}
 
+			/* Partial ACK during a recovery, resend the next hole */
+			tcp_sack_rexmit(conn);
+
 			ret = tcp_send_queued_data(conn);
 			if (ret < 0 && ret != -ENOBUFS) {
 				tcp_out(conn, RST);
@@ -2526,6 +3306,9 @@ next_state:
 
 		if (connection_ok) {
 			k_sem_give(&conn->connect_sem);
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+			zsock_epoll_notify(conn->context);
+#endif
 		}
 
 		goto next_state;
@@ -2775,6 +3558,98 @@ out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+/* net_context queues caller provided buffers for the TCP connection */
+int net_tcp_queue_zc(struct net_context *context, struct net_buf *frags,
+		     struct net_context_zc_tx *tx)
+{
+	struct tcp *conn = context->tcp;
+	struct net_buf *orig_buf = NULL;
+	size_t len;
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (tcp_window_full(conn)) {
+		/* See net_tcp_queue_data() */
+		if (conn->send_win != 0) {
+			(void)k_work_schedule_for_queue(&tcp_work_q,
+							&conn->send_data_timer,
+							K_NO_WAIT);
+		}
+
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	len = net_buf_frags_len(frags);
+
+	if (conn->send_data->buffer) {
+		orig_buf = net_buf_frag_last(conn->send_data->buffer);
+	}
+
+	net_pkt_append_buffer(conn->send_data, frags);
+	conn->send_data_total += len;
+	NET_DBG("conn: %p Queued %zu zero-copy bytes (total %zu)", conn, len,
+		conn->send_data_total);
+
+	/* Completes once everything up to the end of this chunk is acked */
+	tx->pending = conn->send_data_total;
+	sys_slist_append(&conn->zc_tx, &tx->node);
+
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		/* The data is owned by the connection now, the completion
+		 * callback reports the failure when the connection is
+		 * released.
+		 */
+		tcp_conn_close(conn, ret);
+		ret = len;
+		goto out;
+	}
+
+	if ((ret == -ENOBUFS) &&
+	    (conn->send_data_total < (conn->unacked_len + len))) {
+		/* Partly sent already, the rest goes out with the next ack */
+		ret = 0;
+	}
+
+	if (ret == -ENOBUFS) {
+		/* Give the buffers back to the caller, like
+		 * net_tcp_queue_data() does.
+		 */
+		sys_slist_find_and_remove(&conn->zc_tx, &tx->node);
+		conn->send_data_total -= len;
+
+		if (orig_buf) {
+			orig_buf->frags = NULL;
+		} else {
+			conn->send_data->buffer = NULL;
+		}
+
+		if (conn->send_data_total == 0) {
+			k_work_cancel_delayable(&conn->send_data_timer);
+		}
+
+		goto out;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	ret = len;
+out:
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
@@ -2891,6 +3766,8 @@ int net_tcp_connect(struct net_context *context,
 		goto out;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	/* Input of a (nonexistent) packet with no flags set will cause
 	 * a TCP connection to be established
 	 */
@@ -3074,6 +3951,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -3196,6 +4074,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -3383,6 +4262,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = set_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3408,6 +4290,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = get_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control algorithms. The common parts of the congestion
+ * control are in tcp.c, see struct tcp_cc_ops.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+static void newreno_init(struct tcp *conn)
+{
+	conn->cc_priv.newreno.bytes_acked = 0;
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn, uint16_t mss)
+{
+	/* Half of the data in flight (RFC 5681, equation 4) */
+	return MAX((uint32_t)conn->unacked_len / 2U, 2U * mss);
+}
+
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked, uint16_t mss)
+{
+	struct tcp_newreno *ca = &conn->cc_priv.newreno;
+
+	/* One segment per window of acknowledged data (RFC 5681, 3.1) */
+	ca->bytes_acked += acked;
+	if (ca->bytes_acked >= conn->cwnd) {
+		ca->bytes_acked -= conn->cwnd;
+		conn->cwnd += mss;
+	}
+}
+
+static const struct tcp_cc_ops tcp_newreno_ops = {
+	.name = "reno",
+	.init = newreno_init,
+	.ssthresh = newreno_ssthresh,
+	.cong_avoid = newreno_cong_avoid,
+};
+
+/* CUBIC (RFC 9438) with beta = 0.7 and C = 0.4. The window is kept in
+ * bytes and the time in milliseconds, so C * t^3 in segments becomes
+ * 4 * t^3 / 10^10.
+ */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+/* Longest time from the plateau the curve is evaluated for, ~17 min,
+ * which keeps 4 * t^3 within 64 bits.
+ */
+#define CUBIC_MAX_DELTA_MS (1U << 20)
+
+/* Integer cube root, rounded down */
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t x = 0;
+	uint64_t b;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		x <<= 1;
+		b = 3U * x * (x + 1U) + 1U;
+		if ((a >> s) >= b) {
+			a -= b << s;
+			x++;
+		}
+	}
+
+	return (uint32_t)x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	memset(&conn->cc_priv.cubic, 0, sizeof(conn->cc_priv.cubic));
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn, uint16_t mss)
+{
+	struct tcp_cubic *ca = &conn->cc_priv.cubic;
+
+	ca->epoch_start = 0;
+
+	/* Fast convergence, release bandwidth to new flows when the window
+	 * did not reach the previous maximum.
+	 */
+	if (conn->cwnd < ca->w_max) {
+		ca->w_max = (uint32_t)((uint64_t)conn->cwnd *
+				       (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+				       (2U * CUBIC_BETA_DEN));
+	} else {
+		ca->w_max = conn->cwnd;
+	}
+
+	return MAX(conn->cwnd / CUBIC_BETA_DEN * CUBIC_BETA_NUM, 2U * mss);
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked, uint16_t mss)
+{
+	struct tcp_cubic *ca = &conn->cc_priv.cubic;
+	int64_t now = k_uptime_get();
+	uint64_t target;
+	uint64_t delta;
+	uint64_t t;
+	uint64_t d;
+
+	if (ca->epoch_start == 0) {
+		ca->epoch_start = now;
+		ca->w_est = conn->cwnd;
+
+		if (conn->cwnd < ca->w_max) {
+			/* K = cbrt((W_max - cwnd) / C) */
+			ca->k = cubic_root((uint64_t)(ca->w_max - conn->cwnd) *
+					   2500000000ULL / mss);
+			ca->origin = ca->w_max;
+		} else {
+			ca->k = 0;
+			ca->origin = conn->cwnd;
+		}
+	}
+
+	t = now - ca->epoch_start;
+	d = (t > ca->k) ? t - ca->k : ca->k - t;
+	d = MIN(d, CUBIC_MAX_DELTA_MS);
+
+	/* C * d^3 in thousandths of a segment, then in bytes */
+	delta = 4U * d * d * d / 10000000U;
+	delta = delta * mss / 1000U;
+
+	if (t > ca->k) {
+		target = ca->origin + delta;
+	} else {
+		target = (ca->origin > delta) ? ca->origin - delta : 0;
+	}
+
+	/* Do not grow by more than half a window per round trip */
+	target = MIN(target, conn->cwnd + conn->cwnd / 2U);
+
+	/* Reno-friendly region, alpha = 3 * (1 - beta) / (1 + beta) */
+	ca->w_est += (uint32_t)((uint64_t)9U * acked * mss /
+				(17U * (uint64_t)conn->cwnd));
+	target = MAX(target, ca->w_est);
+
+	if (target > conn->cwnd) {
+		conn->cwnd += (uint32_t)((target - conn->cwnd) * acked /
+					 conn->cwnd);
+	}
+}
+
+static const struct tcp_cc_ops tcp_cubic_ops = {
+	.name = "cubic",
+	.init = cubic_init,
+	.ssthresh = cubic_ssthresh,
+	.cong_avoid = cubic_cong_avoid,
+};
+
+static const struct tcp_cc_ops *const tcp_cc_list[] = {
+	&tcp_newreno_ops,
+	&tcp_cubic_ops,
+};
+
+const struct tcp_cc_ops *tcp_cc_default(void)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL_DEFAULT_CUBIC)) {
+		return &tcp_cubic_ops;
+	}
+
+	return &tcp_newreno_ops;
+}
+
+/* The name does not need to be terminated, as with TCP_CONGESTION on
+ * other systems.
+ */
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len)
+{
+	len = strnlen(name, len);
+
+	for (int i = 0; i < ARRAY_SIZE(tcp_cc_list); i++) {
+		if (strlen(tcp_cc_list[i]->name) == len &&
+		    strncmp(tcp_cc_list[i]->name, name, len) == 0) {
+			return tcp_cc_list[i];
+		}
+	}
+
+	return NULL;
+}
@@ -32,6 +32,7 @@ extern "C" {
 
 enum tcp_conn_option {
 	TCP_OPT_NODELAY	= 1,
+	TCP_OPT_CONGESTION = 2,
 };
 
 /**
@@ -301,6 +302,31 @@ static inline int net_tcp_queue_data(struct net_context *context,
 }
 #endif
 
+/**
+ * @brief Enqueue a buffer chain for zero-copy transmission
+ *
+ * @param context TCP context
+ * @param frags Buffers holding the data, owned by the connection on success
+ * @param tx Completion descriptor, its callback is called once the data has
+ *        been acknowledged or the connection is released
+ *
+ * @return number of bytes queued if ok, < 0 if error
+ */
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+int net_tcp_queue_zc(struct net_context *context, struct net_buf *frags,
+		     struct net_context_zc_tx *tx);
+#else
+static inline int net_tcp_queue_zc(struct net_context *context,
+				   struct net_buf *frags,
+				   struct net_context_zc_tx *tx)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(frags);
+	ARG_UNUSED(tx);
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -208,28 +208,95 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Without timestamps, four SACK blocks fit in the TCP options */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
+/* Contiguous range of queued out-of-order data */
+struct tcp_ooo_range {
+	struct net_buf *buf;
+	uint32_t seq;
+	uint32_t len;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_count;
+	bool sack_perm_found : 1;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
 };
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Longest congestion control algorithm name, including the terminator */
+#define NET_TCP_CC_NAME_MAX 16
+
+struct tcp;
+
+/* Congestion control algorithm. Slow start, fast recovery and the
+ * reaction to a retransmission timeout are common to all algorithms and
+ * done in tcp.c, an algorithm decides how far the window is reduced
+ * after a loss and how it grows in congestion avoidance.
+ */
+struct tcp_cc_ops {
+	const char *name;
+	/* Reset the per connection state of the algorithm */
+	void (*init)(struct tcp *conn);
+	/* Return the slow start threshold to use after a loss */
+	uint32_t (*ssthresh)(struct tcp *conn, uint16_t mss);
+	/* Grow conn->cwnd in congestion avoidance, acked bytes were acked */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked, uint16_t mss);
+};
+
+struct tcp_newreno {
+	uint32_t bytes_acked; /* acked since the last window increase */
+};
+
+struct tcp_cubic {
+	int64_t epoch_start; /* uptime in ms when growth started, 0 if none */
+	uint32_t w_max; /* window before the last reduction */
+	uint32_t origin; /* window at the plateau of the cubic curve */
+	uint32_t k; /* ms from epoch_start until the plateau is reached */
+	uint32_t w_est; /* window Reno would have, in bytes */
+};
+
+const struct tcp_cc_ops *tcp_cc_default(void);
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len);
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+	sys_snode_t hash_node; /* entry in the 4-tuple lookup table */
+	uint32_t hash;
+#endif
 	struct net_context *context;
 	struct net_pkt *send_data;
-	struct net_pkt *queue_recv_data;
 	struct net_if *iface;
 	void *recv_user_data;
 	sys_slist_t send_queue;
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	sys_slist_t zc_tx; /* pending zero-copy send completions */
+#endif
 	union {
 		net_tcp_accept_cb_t accept_cb;
 		struct tcp *accepted_conn;
@@ -257,7 +324,30 @@ struct tcp { /* TCP connection */
 	};
 	union tcp_endpoint src;
 	union tcp_endpoint dst;
+	/* Queued out-of-order data, sorted by sequence number */
+	struct tcp_ooo_range ooo[CONFIG_NET_TCP_RECV_QUEUE_RANGES];
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Data above conn->seq the peer has selectively acknowledged */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+	uint32_t ooo_recent; /* seq of the most recently queued data */
+	uint32_t sack_rexmit_next; /* end of the data resent in this recovery */
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	const struct tcp_cc_ops *cc;
+	union {
+		struct tcp_newreno newreno;
+		struct tcp_cubic cubic;
+	} cc_priv;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover; /* highest seq sent when fast recovery started */
+#endif
+	uint8_t ooo_count;
 	size_t send_data_total;
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	size_t send_data_offset; /* acked bytes left in the first send_data buffer */
+#endif
 	size_t send_retries;
 	int unacked_len;
 	atomic_t ref_count;
@@ -280,6 +370,15 @@ struct tcp { /* TCP connection */
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+#if defined(CONFIG_NET_TCP_CONN_HASH)
+	bool in_hash : 1;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_enabled : 1; /* both ends agreed on SACK */
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	bool in_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
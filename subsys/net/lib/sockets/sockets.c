@@ -263,6 +263,8 @@ int zsock_close_ctx(struct net_context *ctx)
 
 	zsock_flush_queue(ctx);
 
+	zsock_epoll_ctx_closed(ctx);
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -354,6 +356,7 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		k_condvar_init(&new_ctx->cond.recv);
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		zsock_epoll_notify(parent);
 
 		/* TCP context is effectively owned by both application
 		 * and the stack: stack may detect that peer closed/aborted
@@ -413,6 +416,8 @@ static void zsock_received_cb(struct net_context *ctx,
 	k_fifo_put(&ctx->recv_q, pkt);
 
 unlock:
+	zsock_epoll_notify(ctx);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -434,6 +439,8 @@ int zsock_shutdown_ctx(struct net_context *ctx, int how)
 
 		zsock_flush_queue(ctx);
 
+		zsock_epoll_notify(ctx);
+
 		/* Let reader to wake if it was sleeping */
 		(void)k_condvar_signal(&ctx->cond.recv);
 	} else if (how == ZSOCK_SHUT_WR || how == ZSOCK_SHUT_RDWR) {
@@ -787,6 +794,82 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+static ssize_t zsock_send_zc_ctx(struct net_context *ctx,
+				 struct net_buf *frags,
+				 struct net_context_zc_tx *tx, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	uint64_t buf_timeout = 0;
+	int status;
+
+	if (net_context_get_type(ctx) != SOCK_STREAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_clock_timeout_end_calc(MAX_WAIT_BUFS);
+	}
+
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		status = net_context_send_zc(ctx, frags, tx);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+ssize_t zsock_send_zc(int sock, struct net_buf *frags,
+		      struct net_context_zc_tx *tx, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	ssize_t ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_send_zc_ctx(obj, frags, tx, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -1418,6 +1501,197 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_RECV_ZC)
+/* Describe up to rx->iovlen fragments of the data remaining in pkt,
+ * starting at its cursor. Returns the number of bytes described.
+ */
+static size_t recv_zc_fill(struct net_pkt *pkt, struct zsock_zc_rx *rx)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	size_t left = net_pkt_remaining_data(pkt);
+	size_t len = 0;
+	size_t n = 0;
+
+	while (buf != NULL && left > 0 && n < rx->iovlen) {
+		size_t frag_len = MIN(buf->len - (pos - buf->data), left);
+
+		if (frag_len > 0) {
+			rx->iov[n].iov_base = pos;
+			rx->iov[n].iov_len = frag_len;
+			n++;
+			len += frag_len;
+			left -= frag_len;
+		}
+
+		buf = buf->frags;
+		pos = buf ? buf->data : NULL;
+	}
+
+	rx->iovlen = n;
+
+	return len;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct zsock_zc_rx *rx, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int res;
+
+	if (net_context_get_type(ctx) != SOCK_STREAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	do {
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			rx->iovlen = 0;
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			res = zsock_wait_data(ctx, &timeout);
+			if (res < 0) {
+				errno = -res;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (pkt == NULL) {
+			if (sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			} else if (sock_is_eof(ctx)) {
+				rx->iovlen = 0;
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		len = recv_zc_fill(pkt, rx);
+		if (len > 0) {
+			bool overwrite = net_pkt_is_being_overwritten(pkt);
+
+			/* The application holds its own reference until
+			 * the data is released.
+			 */
+			rx->pkt = net_pkt_ref(pkt);
+			rx->len = len;
+
+			/* Skipping must not append to the packet */
+			net_pkt_set_overwrite(pkt, true);
+			net_pkt_skip(pkt, len);
+			net_pkt_set_overwrite(pkt, overwrite);
+		}
+
+		if (net_pkt_remaining_data(pkt) == 0) {
+			k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+				net_socket_update_tc_rx_time(pkt,
+							     k_cycle_get_32());
+			}
+
+			net_pkt_unref(pkt);
+		}
+	} while (len == 0);
+
+	return len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_rx *rx, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	ssize_t ret;
+
+	if (rx == NULL || rx->iov == NULL || rx->iovlen == 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	rx->pkt = NULL;
+	rx->len = 0;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zc_ctx(obj, rx, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+int zsock_recv_zc_release(int sock, struct zsock_zc_rx *rx)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+
+	if (rx == NULL || rx->pkt == NULL) {
+		return 0;
+	}
+
+	net_pkt_unref(rx->pkt);
+	rx->pkt = NULL;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable != &sock_fd_op_vtable) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (net_context_is_used(obj)) {
+		net_context_update_recv_wnd(obj, rx->len);
+	}
+
+	k_mutex_unlock(lock);
+
+	rx->len = 0;
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZC */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1884,6 +2158,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		case TCP_NODELAY:
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+				ret = net_tcp_get_option(ctx,
+							 TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno  = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 
 		break;
@@ -2182,6 +2471,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_set_option(ctx,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+				ret = net_tcp_set_option(ctx,
+							 TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno  = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 		break;
 
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* epoll style readiness notification for native sockets.
+ *
+ * Every registration is linked both to its epoll instance and to the
+ * net_context it watches. The socket layer calls zsock_epoll_notify()
+ * whenever data, a new connection, EOF or an error is queued to a
+ * context, which puts the registrations of that context on the ready list
+ * of their instance and raises the instance signal. zsock_epoll_wait()
+ * then only has to evaluate the sockets on the ready list. TCP notifies
+ * the context as well when it gets connected and when its send window
+ * opens, for ZSOCK_EPOLLOUT.
+ *
+ * Registrations are looked up by fd but also hold the context, so that a
+ * registration left on a fd which was reused by another socket is dropped
+ * rather than applied to the new socket.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/net/socket.h>
+
+#include "sockets_internal.h"
+#include "../../ip/tcp_internal.h"
+
+#define EPOLL_ALWAYS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+#define EPOLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT | EPOLL_ALWAYS)
+
+struct epoll_instance {
+	/* Registrations of this instance */
+	sys_slist_t items;
+	/* Registrations which may be ready, protected by ready_lock */
+	sys_dlist_t ready;
+	/* Raised when a registration is put on the ready list */
+	struct k_poll_signal signal;
+};
+
+struct epoll_item {
+	/* Entry in epoll_instance.items */
+	sys_snode_t node;
+	/* Entry in net_context.epoll_items */
+	sys_snode_t ctx_node;
+	/* Entry in epoll_instance.ready */
+	sys_dnode_t ready_node;
+	struct epoll_instance *ep;
+	struct net_context *ctx;
+	int fd;
+	struct zsock_epoll_event event;
+	/* Readiness found by the last evaluation */
+	uint32_t revents;
+	/* Disabled after a ZSOCK_EPOLLONESHOT report */
+	bool disabled;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(epoll_instances, sizeof(struct epoll_instance),
+			 CONFIG_NET_SOCKETS_EPOLL_MAX_INSTANCES, 4);
+K_MEM_SLAB_DEFINE_STATIC(epoll_items, sizeof(struct epoll_item),
+			 CONFIG_NET_SOCKETS_EPOLL_MAX_ITEMS, 4);
+
+/* Serializes registration changes and waits against socket close */
+static K_MUTEX_DEFINE(epoll_lock);
+
+/* Protects the ready lists and the per context registration lists, which
+ * are used from the network RX path.
+ */
+static struct k_spinlock ready_lock;
+
+static const struct socket_op_vtable epoll_fd_op_vtable;
+
+static bool epoll_uses_tx_sem(struct net_context *ctx)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       net_context_get_type(ctx) == SOCK_STREAM;
+}
+
+/* Same conditions as zsock_poll_update_ctx() */
+static uint32_t epoll_ctx_events(struct net_context *ctx)
+{
+	uint32_t revents = 0;
+
+	if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLIN;
+	}
+
+	if (!epoll_uses_tx_sem(ctx)) {
+		revents |= ZSOCK_EPOLLOUT;
+	} else if (!sock_is_eof(ctx) &&
+		   net_context_get_state(ctx) == NET_CONTEXT_CONNECTED &&
+		   k_sem_count_get(net_tcp_tx_sem_get(ctx)) > 0) {
+		revents |= ZSOCK_EPOLLOUT;
+	}
+
+	if (sock_is_error(ctx)) {
+		revents |= ZSOCK_EPOLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLHUP;
+	}
+
+	return revents;
+}
+
+static void epoll_mark_ready_locked(struct epoll_item *item)
+{
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&item->ep->ready, &item->ready_node);
+	}
+
+	k_poll_signal_raise(&item->ep->signal, 0);
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ready_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		epoll_mark_ready_locked(item);
+	}
+
+	k_spin_unlock(&ready_lock, key);
+}
+
+static void epoll_item_free(struct epoll_item *item)
+{
+	struct epoll_instance *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ready_lock);
+	sys_slist_find_and_remove(&item->ctx->epoll_items, &item->ctx_node);
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+	k_spin_unlock(&ready_lock, key);
+
+	sys_slist_find_and_remove(&ep->items, &item->node);
+
+	k_mem_slab_free(&epoll_items, (void **)&item);
+}
+
+void zsock_epoll_ctx_closed(struct net_context *ctx)
+{
+	struct epoll_item *item;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	/* Closing a socket removes it from all instances */
+	while ((item = SYS_SLIST_PEEK_HEAD_CONTAINER(&ctx->epoll_items, item,
+						     ctx_node)) != NULL) {
+		epoll_item_free(item);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+int zsock_epoll_create(int flags)
+{
+	struct epoll_instance *ep;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	if (k_mem_slab_alloc(&epoll_instances, (void **)&ep, K_NO_WAIT) != 0) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	sys_slist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	k_poll_signal_init(&ep->signal);
+
+	z_finalize_fd(fd, ep, (const struct fd_op_vtable *)&epoll_fd_op_vtable);
+
+	return fd;
+}
+
+static struct epoll_item *epoll_find(struct epoll_instance *ep, int fd,
+				     struct net_context *ctx)
+{
+	struct epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ep->items, item, node) {
+		if (item->fd != fd) {
+			continue;
+		}
+
+		/* The fd now refers to another socket */
+		if (item->ctx != ctx) {
+			epoll_item_free(item);
+			return NULL;
+		}
+
+		return item;
+	}
+
+	return NULL;
+}
+
+static void epoll_item_set(struct epoll_item *item,
+			   const struct zsock_epoll_event *event)
+{
+	k_spinlock_key_t key;
+
+	item->event = *event;
+	item->revents = 0;
+	item->disabled = false;
+
+	/* Let the next wait evaluate the current state */
+	key = k_spin_lock(&ready_lock);
+	epoll_mark_ready_locked(item);
+	k_spin_unlock(&ready_lock, key);
+}
+
+static struct net_context *epoll_ctx_get(int fd)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable, NULL);
+	if (ctx != NULL && vtable != &sock_fd_op_vtable.fd_vtable) {
+		return NULL;
+	}
+
+	return ctx;
+}
+
+static int epoll_add(struct epoll_instance *ep, int fd,
+		     const struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable, NULL);
+	if (ctx == NULL) {
+		return -EBADF;
+	}
+
+	if (vtable != &sock_fd_op_vtable.fd_vtable) {
+		return -EPERM;
+	}
+
+	if (epoll_find(ep, fd, ctx) != NULL) {
+		return -EEXIST;
+	}
+
+	if (k_mem_slab_alloc(&epoll_items, (void **)&item, K_NO_WAIT) != 0) {
+		return -ENOMEM;
+	}
+
+	memset(item, 0, sizeof(*item));
+	item->ep = ep;
+	item->ctx = ctx;
+	item->fd = fd;
+
+	sys_slist_append(&ep->items, &item->node);
+
+	key = k_spin_lock(&ready_lock);
+	sys_slist_append(&ctx->epoll_items, &item->ctx_node);
+	k_spin_unlock(&ready_lock, key);
+
+	epoll_item_set(item, event);
+
+	return 0;
+}
+
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	struct epoll_item *item;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)&epoll_fd_op_vtable,
+			  EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL &&
+	    (event == NULL ||
+	     (event->events & ~(EPOLL_EVENTS | ZSOCK_EPOLLET |
+				ZSOCK_EPOLLONESHOT)))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_add(ep, fd, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		item = epoll_find(ep, fd, epoll_ctx_get(fd));
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_set(item, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		item = epoll_find(ep, fd, epoll_ctx_get(fd));
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Report the ready sockets. Level triggered registrations which are still
+ * ready stay on the ready list, behind the ones not reported yet.
+ */
+static int epoll_collect(struct epoll_instance *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_item *item, *next;
+	sys_dlist_t keep;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+	uint32_t revents;
+	int n = 0;
+
+	sys_dlist_init(&keep);
+
+	key = k_spin_lock(&ready_lock);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->ready, item, next, ready_node) {
+		if (n == maxevents) {
+			break;
+		}
+
+		sys_dlist_remove(&item->ready_node);
+
+		item->revents = epoll_ctx_events(item->ctx);
+		if (item->disabled) {
+			continue;
+		}
+
+		revents = item->revents & (item->event.events | EPOLL_ALWAYS);
+		if (revents == 0) {
+			continue;
+		}
+
+		events[n].events = revents;
+		events[n].data = item->event.data;
+		n++;
+
+		if (item->event.events & ZSOCK_EPOLLONESHOT) {
+			item->disabled = true;
+		} else if (!(item->event.events & ZSOCK_EPOLLET)) {
+			sys_dlist_append(&keep, &item->ready_node);
+		}
+	}
+
+	while ((node = sys_dlist_get(&keep)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	k_spin_unlock(&ready_lock, key);
+
+	return n;
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	struct k_poll_event poll_event;
+	struct epoll_instance *ep;
+	k_timeout_t wait;
+	int64_t end;
+	int n;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)&epoll_fd_op_vtable,
+			  EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	wait = timeout < 0 ? K_FOREVER : K_MSEC(timeout);
+	end = sys_clock_timeout_end_calc(wait);
+
+	while (true) {
+		/* Reset before looking at the ready list so that no
+		 * notification is lost.
+		 */
+		k_poll_signal_reset(&ep->signal);
+		k_poll_event_init(&poll_event, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+
+		(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+		n = epoll_collect(ep, events, maxevents);
+		k_mutex_unlock(&epoll_lock);
+
+		if (n > 0 || K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			return n;
+		}
+
+		if (!K_TIMEOUT_EQ(wait, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				/* One last look without waiting */
+				wait = K_NO_WAIT;
+				continue;
+			}
+
+			wait = Z_TIMEOUT_TICKS(remaining);
+		}
+
+		(void)k_poll(&poll_event, 1, wait);
+	}
+}
+
+static int epoll_close(void *obj)
+{
+	struct epoll_instance *ep = obj;
+	struct epoll_item *item;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	while ((item = SYS_SLIST_PEEK_HEAD_CONTAINER(&ep->items, item,
+						     node)) != NULL) {
+		epoll_item_free(item);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	k_mem_slab_free(&epoll_instances, (void **)&ep);
+
+	return 0;
+}
+
+static ssize_t epoll_read(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_SET_LOCK:
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct socket_op_vtable epoll_fd_op_vtable = {
+	.fd_vtable = {
+		.read = epoll_read,
+		.write = epoll_write,
+		.close = epoll_close,
+		.ioctl = epoll_ioctl,
+	},
+};
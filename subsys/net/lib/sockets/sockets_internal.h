@@ -76,6 +76,25 @@ struct socket_op_vtable {
 			   socklen_t *addrlen);
 };
 
+extern const struct socket_op_vtable sock_fd_op_vtable;
+
 size_t msghdr_non_empty_iov_count(const struct msghdr *msg);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* Called when data, a connection, EOF or an error is queued to ctx */
+void zsock_epoll_notify(struct net_context *ctx);
+/* Called when ctx is closed, drops its epoll registrations */
+void zsock_epoll_ctx_closed(struct net_context *ctx);
+#else
+static inline void zsock_epoll_notify(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void zsock_epoll_ctx_closed(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif
+
 #endif /* _SOCKETS_INTERNAL_H_ */
@@ -680,6 +680,24 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'z':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -z option\n");
+				return -ENOEXEC;
+			}
+
+			if (!IS_ENABLED(CONFIG_NET_TCP_SEND_ZC)) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Zero-copy send needs "
+					      "CONFIG_NET_TCP_SEND_ZC\n");
+				return -ENOEXEC;
+			}
+
+			param.options.tcp_zerocopy = 1;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -853,6 +871,24 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'z':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -z option\n");
+				return -ENOEXEC;
+			}
+
+			if (!IS_ENABLED(CONFIG_NET_TCP_SEND_ZC)) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Zero-copy send needs "
+					      "CONFIG_NET_TCP_SEND_ZC\n");
+				return -ENOEXEC;
+			}
+
+			param.options.tcp_zerocopy = 1;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1146,6 +1182,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-z: Zero-copy send (needs CONFIG_NET_TCP_SEND_ZC)\n"
 		  "Example: tcp upload 192.0.2.2 1111 1 1K\n"
 		  "Example: tcp upload 2001:db8::2\n",
 		  cmd_tcp_upload),
@@ -1162,6 +1199,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "Example: tcp upload2 v6 1 1K\n"
 		  "Example: tcp upload2 v4\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-z: Zero-copy send (needs CONFIG_NET_TCP_SEND_ZC)\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
 		  "Default IPv6 address is " MY_IP6ADDR
 		  ", destination [" DST_IP6ADDR "]:" DEF_PORT_STR "\n"
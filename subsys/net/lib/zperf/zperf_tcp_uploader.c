@@ -12,6 +12,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 #include <errno.h>
 
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_context.h>
 #include <zephyr/net/zperf.h>
 
 #include "zperf_internal.h"
@@ -20,9 +21,69 @@ static char sample_packet[PACKET_SIZE_MAX];
 
 static struct zperf_async_upload_context tcp_async_upload_ctx;
 
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+/* Maximum number of zero-copy sends waiting to be acknowledged */
+#define ZC_TX_COUNT 16
+
+NET_BUF_POOL_DEFINE(zc_buf_pool, ZC_TX_COUNT, 0, 0, NULL);
+K_MEM_SLAB_DEFINE_STATIC(zc_tx_slab, sizeof(struct net_context_zc_tx),
+			 ZC_TX_COUNT, 4);
+
+static void zc_tx_done(struct net_context *context,
+		       struct net_context_zc_tx *tx, int status)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(status);
+
+	k_mem_slab_free(&zc_tx_slab, (void **)&tx);
+}
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+
+/* The buffers reference the sample packet directly, which never changes
+ * during the upload, so completion only recycles the descriptor.
+ */
+static int tcp_send_zc(int sock, unsigned int packet_size)
+{
+#if defined(CONFIG_NET_TCP_SEND_ZC)
+	struct net_context_zc_tx *tx;
+	struct net_buf *buf;
+	int ret;
+
+	if (k_mem_slab_alloc(&zc_tx_slab, (void **)&tx, K_FOREVER) != 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	buf = net_buf_alloc_with_data(&zc_buf_pool, sample_packet,
+				      packet_size, K_FOREVER);
+	if (buf == NULL) {
+		k_mem_slab_free(&zc_tx_slab, (void **)&tx);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	tx->cb = zc_tx_done;
+
+	ret = zsock_send_zc(sock, buf, tx, 0);
+	if (ret < 0) {
+		net_buf_unref(buf);
+		k_mem_slab_free(&zc_tx_slab, (void **)&tx);
+	}
+
+	return ret;
+#else
+	ARG_UNUSED(sock);
+	ARG_UNUSED(packet_size);
+
+	errno = ENOTSUP;
+	return -1;
+#endif /* CONFIG_NET_TCP_SEND_ZC */
+}
+
 static int tcp_upload(int sock,
 		      unsigned int duration_in_ms,
 		      unsigned int packet_size,
+		      bool zerocopy,
 		      struct zperf_results *results)
 {
 	int64_t duration = sys_clock_timeout_end_calc(K_MSEC(duration_in_ms));
@@ -51,7 +112,11 @@ static int tcp_upload(int sock,
 
 	do {
 		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		if (zerocopy) {
+			ret = tcp_send_zc(sock, packet_size);
+		} else {
+			ret = zsock_send(sock, sample_packet, packet_size, 0);
+		}
 		if (ret < 0) {
 			if (nb_errors == 0 && ret != -ENOMEM) {
 				NET_ERR("Failed to send the packet (%d)", errno);
@@ -132,7 +197,8 @@ int zperf_tcp_upload(const struct zperf_upload_params *param,
 		return -EINVAL;
 	}
 
-	ret = tcp_upload(sock, param->duration_ms, param->packet_size, result);
+	ret = tcp_upload(sock, param->duration_ms, param->packet_size,
+			 param->options.tcp_zerocopy, result);
 
 	zsock_close(sock);
 
@@ -31,6 +31,11 @@ LOG_MODULE_REGISTER(rtio_executor_concurrent, CONFIG_RTIO_LOG_LEVEL);
  * such that simple short for loops over task array are reasonably fast.
  *
  * A maximum of 65K submissions queue entries are possible.
+ *
+ * A multishot submission keeps its task until it is cancelled. As tasks and
+ * their submission queue entries are swept in order, tasks started after it
+ * are only freed once it is, and chains left without a task stay pending
+ * until then.
  */
 
 /**
@@ -91,21 +96,123 @@ static void conex_sweep(struct rtio *r, struct rtio_concurrent_executor *exc)
 	}
 }
 
+/**
+ * Complete the current sqe of a task with an error, failing the rest of its chain
+ */
+static void conex_task_fail(struct rtio *r, struct rtio_concurrent_executor *exc,
+			    uint16_t task_id, const struct rtio_sqe *sqe, int result)
+{
+	struct rtio_sqe *nsqe;
+
+	rtio_sqe_mempool_free(r, sqe);
+	rtio_cqe_submit(r, result, sqe->userdata, 0);
+
+	/* Fail the remaining sqe's in the chain */
+	if (sqe->flags & RTIO_SQE_CHAINED) {
+		nsqe = rtio_spsc_next(r->sq, sqe);
+		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
+			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata, 0);
+			nsqe = rtio_spsc_next(r->sq, nsqe);
+		}
+	}
+
+	/* Task is complete (failed) */
+	exc->task_status[task_id & exc->task_mask] |= CONEX_TASK_COMPLETE;
+}
+
+/**
+ * Hand the current sqe of a task to its iodev, with a buffer from the memory
+ * pool if it asks for one, unless it is cancelled
+ *
+ * @retval true The sqe was submitted
+ * @retval false The task failed
+ */
+static bool conex_task_submit(struct rtio *r, struct rtio_concurrent_executor *exc,
+			      uint16_t task_id, struct rtio_sqe *sqe)
+{
+	int err;
+
+	exc->task_cur[task_id & exc->task_mask] = sqe;
+
+	err = rtio_sqe_arm(r, sqe);
+	if (err != 0) {
+		conex_task_fail(r, exc, task_id, sqe, err);
+		return false;
+	}
+
+	rtio_iodev_submit(sqe, r);
+
+	return true;
+}
+
+static void conex_sweep_resume(struct rtio *r, struct rtio_concurrent_executor *exc);
+
 static void conex_resume(struct rtio *r, struct rtio_concurrent_executor *exc)
 {
+	bool failed = false;
+
 	/* In order resume tasks */
 	for (uint16_t task_id = exc->task_out; task_id < exc->task_in; task_id++) {
 		if (exc->task_status[task_id & exc->task_mask] & CONEX_TASK_SUSPENDED) {
 			LOG_INF("resuming suspended task %d", task_id);
-			exc->task_status[task_id] &= ~CONEX_TASK_SUSPENDED;
-			rtio_iodev_submit(exc->task_cur[task_id], r);
+			exc->task_status[task_id & exc->task_mask] &= ~CONEX_TASK_SUSPENDED;
+			failed |= !conex_task_submit(r, exc, task_id,
+						     exc->task_cur[task_id & exc->task_mask]);
+		}
+	}
+
+	/* Tasks failing to start produce no completion which would sweep them */
+	if (failed) {
+		conex_sweep_resume(r, exc);
+	}
+}
+
+/**
+ * Set up a task for each chain from the given sqe while tasks are free
+ *
+ * @return First sqe of the chains left pending, NULL if none
+ */
+static struct rtio_sqe *conex_start_tasks(struct rtio *r, struct rtio_concurrent_executor *exc,
+					  struct rtio_sqe *sqe)
+{
+	while (sqe != NULL && conex_task_free(exc)) {
+		LOG_INF("head SQE in chain %p", sqe);
+
+		/* Get the next task id if one exists */
+		uint16_t task_idx = conex_task_next(exc);
+
+		LOG_INF("setting up task %d", task_idx);
+
+		/* Setup task (yes this is it) */
+		exc->task_cur[task_idx & exc->task_mask] = sqe;
+		exc->task_status[task_idx & exc->task_mask] = CONEX_TASK_SUSPENDED;
+
+		LOG_INF("submitted sqe %p", sqe);
+		/* Go to the next sqe not in the current chain */
+		while (sqe != NULL && (sqe->flags & RTIO_SQE_CHAINED)) {
+			sqe = rtio_spsc_next(r->sq, sqe);
+		}
+
+		LOG_INF("tail SQE in chain %p", sqe);
+
+		/* SQE is the end of the previous chain */
+		if (sqe != NULL) {
+			sqe = rtio_spsc_next(r->sq, sqe);
 		}
 	}
+
+	return sqe;
 }
 
 static void conex_sweep_resume(struct rtio *r, struct rtio_concurrent_executor *exc)
 {
 	conex_sweep(r, exc);
+
+	/* Chains waiting for a free task, e.g. behind a multishot task */
+	if (exc->pending_sqe != NULL) {
+		exc->pending_sqe = conex_start_tasks(r, exc, exc->pending_sqe);
+	}
+
 	conex_resume(r, exc);
 }
 
@@ -124,65 +231,36 @@ int rtio_concurrent_submit(struct rtio *r)
 	struct rtio_concurrent_executor *exc =
 		(struct rtio_concurrent_executor *)r->executor;
 	struct rtio_sqe *sqe;
-	struct rtio_sqe *last_sqe;
 	k_spinlock_key_t key;
 
 	key = k_spin_lock(&exc->lock);
 
-	/* If never submitted before peek at the first item
-	 * otherwise start back up where the last submit call
-	 * left off
+	/* Start with the chains still pending from a previous submit call if
+	 * any. Otherwise if never submitted before peek at the first item,
+	 * or start back up where the last submit call left off
 	 */
-	if (exc->last_sqe == NULL) {
+	if (exc->pending_sqe != NULL) {
+		sqe = exc->pending_sqe;
+	} else if (exc->last_sqe == NULL) {
 		sqe = rtio_spsc_peek(r->sq);
 	} else {
 		/* Pickup from last submit call */
 		sqe = rtio_spsc_next(r->sq, exc->last_sqe);
 	}
 
-	last_sqe = sqe;
-	while (sqe != NULL && conex_task_free(exc)) {
-		LOG_INF("head SQE in chain %p", sqe);
-
-		/* Get the next task id if one exists */
-		uint16_t task_idx = conex_task_next(exc);
-
-		LOG_INF("setting up task %d", task_idx);
-
-		/* Setup task (yes this is it) */
-		exc->task_cur[task_idx] = sqe;
-		exc->task_status[task_idx] = CONEX_TASK_SUSPENDED;
-
-		LOG_INF("submitted sqe %p", sqe);
-		/* Go to the next sqe not in the current chain */
-		while (sqe != NULL && (sqe->flags & RTIO_SQE_CHAINED)) {
-			sqe = rtio_spsc_next(r->sq, sqe);
-		}
-
-		LOG_INF("tail SQE in chain %p", sqe);
-
-		last_sqe = sqe;
-
-		/* SQE is the end of the previous chain */
-		sqe = rtio_spsc_next(r->sq, sqe);
-	}
-
-	/* Out of available pointers, wait til others complete, note the
-	 * first pending submission queue. May be NULL if nothing is pending.
-	 */
-	exc->pending_sqe = sqe;
-
 	/**
 	 * Run through the queue until the last item
-	 * and take not of it
+	 * and take note of it for the next submit call
 	 */
-	while (sqe != NULL) {
-		last_sqe = sqe;
-		sqe = rtio_spsc_next(r->sq, sqe);
+	for (struct rtio_sqe *last_sqe = sqe; last_sqe != NULL;
+	     last_sqe = rtio_spsc_next(r->sq, last_sqe)) {
+		exc->last_sqe = last_sqe;
 	}
 
-	/* Note the last sqe for the next submit call */
-	exc->last_sqe = last_sqe;
+	/* Out of available pointers, wait til others complete, note the
+	 * first pending submission queue. May be NULL if nothing is pending.
+	 */
+	exc->pending_sqe = conex_start_tasks(r, exc, sqe);
 
 	/* Resume all suspended tasks */
 	conex_resume(r, exc);
@@ -210,19 +288,28 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
 	uint16_t task_id = conex_task_id(exc, sqe);
 
-	if (sqe->flags & RTIO_SQE_CHAINED) {
-		next_sqe = rtio_spsc_next(r->sq, sqe);
+	if (sqe->flags & RTIO_SQE_CANCELED) {
+		conex_task_fail(r, exc, task_id, sqe, -ECANCELED);
+		conex_sweep_resume(r, exc);
+		k_spin_unlock(&exc->lock, key);
+		return;
+	}
 
-		rtio_iodev_submit(next_sqe, r);
+	rtio_cqe_submit(r, result, sqe->userdata, rtio_cqe_compute_flags(r, sqe));
+
+	if (sqe->flags & RTIO_SQE_MULTISHOT) {
+		/* The task stays on this sqe and waits for the next event */
+		rtio_sqe_mempool_detach(r, (struct rtio_sqe *)sqe);
+		conex_task_submit(r, exc, task_id, (struct rtio_sqe *)sqe);
+	} else if (sqe->flags & RTIO_SQE_CHAINED) {
+		next_sqe = rtio_spsc_next(r->sq, sqe);
 
-		exc->task_cur[task_id] = next_sqe;
+		conex_task_submit(r, exc, task_id, next_sqe);
 	} else {
-		exc->task_status[task_id]  |= CONEX_TASK_COMPLETE;
+		exc->task_status[task_id & exc->task_mask] |= CONEX_TASK_COMPLETE;
 	}
 
 
@@ -240,7 +327,6 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
  */
 void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	struct rtio_sqe *nsqe;
 	k_spinlock_key_t key;
 	struct rtio_concurrent_executor *exc = (struct rtio_concurrent_executor *)r->executor;
 
@@ -254,25 +340,41 @@ void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
 	uint16_t task_id = conex_task_id(exc, sqe);
 
+	conex_task_fail(r, exc, task_id, sqe, result);
 
-	/* Fail the remaining sqe's in the chain */
-	if (sqe->flags & RTIO_SQE_CHAINED) {
-		nsqe = rtio_spsc_next(r->sq, sqe);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
-			nsqe = rtio_spsc_next(r->sq, nsqe);
-		}
-	}
+	conex_sweep_resume(r, exc);
 
-	/* Task is complete (failed) */
-	exc->task_status[task_id] |= CONEX_TASK_COMPLETE;
+	k_spin_unlock(&exc->lock, key);
+}
 
-	conex_sweep_resume(r, exc);
+/**
+ * @brief Cancel a submission, completing it now if its iodev drops it
+ */
+int rtio_concurrent_cancel(struct rtio *r, struct rtio_sqe *sqe)
+{
+	k_spinlock_key_t key;
+	struct rtio_concurrent_executor *exc = (struct rtio_concurrent_executor *)r->executor;
+	bool in_flight;
+
+	key = k_spin_lock(&exc->lock);
+
+	/* A started task neither suspended nor complete is with its iodev */
+	uint16_t task_id = conex_task_id(exc, sqe);
+
+	in_flight = task_id != exc->task_in &&
+		    !(exc->task_status[task_id & exc->task_mask] &
+		      (CONEX_TASK_COMPLETE | CONEX_TASK_SUSPENDED));
+	sqe->flags |= RTIO_SQE_CANCELED;
 
 	k_spin_unlock(&exc->lock, key);
+
+	/* Otherwise it fails when submitted or completed */
+	if (in_flight && rtio_iodev_cancel(sqe, r) == 0) {
+		rtio_concurrent_err(r, sqe, -ECANCELED);
+	}
+
+	return 0;
 }
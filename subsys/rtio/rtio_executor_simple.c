@@ -12,6 +12,22 @@
 LOG_MODULE_REGISTER(rtio_executor_simple, CONFIG_RTIO_LOG_LEVEL);
 
 
+/**
+ * @brief Hand a submission to its iodev, with a buffer from the memory pool
+ * if it asks for one
+ */
+static void rtio_simple_submit_sqe(struct rtio *r, struct rtio_sqe *sqe)
+{
+	int err = rtio_sqe_arm(r, sqe);
+
+	if (err != 0) {
+		rtio_simple_err(r, sqe, err);
+		return;
+	}
+
+	rtio_iodev_submit(sqe, r);
+}
+
 /**
  * @brief Submit submissions to simple executor
  *
@@ -27,10 +43,19 @@ int rtio_simple_submit(struct rtio *r)
 	/* TODO For each submission queue entry chain,
 	 * submit the chain to the first iodev
 	 */
-	struct rtio_sqe *sqe = rtio_spsc_consume(r->sq);
+	struct rtio_sqe *sqe;
+
+	/* A submission is in flight, the next one is submitted once it
+	 * completes. This holds until a multishot submission is cancelled,
+	 * see rtio_simple_cancel().
+	 */
+	if (r->sq->_spsc.consume != 0) {
+		return 0;
+	}
 
+	sqe = rtio_spsc_consume(r->sq);
 	if (sqe != NULL) {
-		rtio_iodev_submit(sqe, r);
+		rtio_simple_submit_sqe(r, sqe);
 	}
 
 	return 0;
@@ -42,9 +67,23 @@ int rtio_simple_submit(struct rtio *r)
 void rtio_simple_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
 	void *userdata = sqe->userdata;
+	uint32_t flags = rtio_cqe_compute_flags(r, sqe);
+
+	if (sqe->flags & RTIO_SQE_CANCELED) {
+		rtio_simple_err(r, sqe, -ECANCELED);
+		return;
+	}
+
+	if (sqe->flags & RTIO_SQE_MULTISHOT) {
+		/* Stay at the head of the queue and wait for the next event */
+		rtio_cqe_submit(r, result, userdata, flags);
+		rtio_sqe_mempool_detach(r, (struct rtio_sqe *)sqe);
+		rtio_simple_submit_sqe(r, (struct rtio_sqe *)sqe);
+		return;
+	}
 
 	rtio_spsc_release(r->sq);
-	rtio_cqe_submit(r, result, userdata);
+	rtio_cqe_submit(r, result, userdata, flags);
 	rtio_simple_submit(r);
 }
 
@@ -57,8 +96,9 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	void *userdata = sqe->userdata;
 	bool chained = sqe->flags & RTIO_SQE_CHAINED;
 
+	rtio_sqe_mempool_free(r, sqe);
 	rtio_spsc_release(r->sq);
-	rtio_cqe_submit(r, result, sqe->userdata);
+	rtio_cqe_submit(r, result, userdata, 0);
 
 	if (chained) {
 
@@ -66,12 +106,12 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
 			userdata = nsqe->userdata;
 			rtio_spsc_release(r->sq);
-			rtio_cqe_submit(r, -ECANCELED, userdata);
+			rtio_cqe_submit(r, -ECANCELED, userdata, 0);
 			nsqe = rtio_spsc_consume(r->sq);
 		}
 
 		if (nsqe != NULL) {
-			rtio_iodev_submit(nsqe, r);
+			rtio_simple_submit_sqe(r, nsqe);
 		}
 
 	} else {
@@ -79,3 +119,30 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 		rtio_simple_submit(r);
 	}
 }
+
+/**
+ * @brief Cancel a submission, completing it now if its iodev drops it
+ */
+int rtio_simple_cancel(struct rtio *r, struct rtio_sqe *sqe)
+{
+	struct rtio_simple_executor *exc = (struct rtio_simple_executor *)r->executor;
+	struct rtio_sq *sq = r->sq;
+	k_spinlock_key_t key;
+	bool in_flight;
+
+	key = k_spin_lock(&exc->lock);
+
+	/* Only the consumed head of the queue is with its iodev */
+	in_flight = sq->_spsc.consume != 0 &&
+		    sqe == &sq->buffer[z_rtio_spsc_mask(sq, atomic_get(&sq->_spsc.out))];
+	sqe->flags |= RTIO_SQE_CANCELED;
+
+	k_spin_unlock(&exc->lock, key);
+
+	/* Otherwise it fails when submitted or completed */
+	if (in_flight && rtio_iodev_cancel(sqe, r) == 0) {
+		rtio_simple_err(r, sqe, -ECANCELED);
+	}
+
+	return 0;
+}
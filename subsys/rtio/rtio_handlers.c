@@ -29,8 +29,21 @@ static inline bool rtio_vrfy_sqe(struct rtio_sqe *sqe)
 		valid_sqe &= Z_SYSCALL_MEMORY(sqe->buf, sqe->buf_len, false);
 		break;
 	case RTIO_OP_RX:
+		if (sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) {
+			/* The memory pool of the context is kernel memory */
+			valid_sqe = false;
+			break;
+		}
 		valid_sqe &= Z_SYSCALL_MEMORY(sqe->buf, sqe->buf_len, true);
 		break;
+	case RTIO_OP_TXRX:
+		valid_sqe &= Z_SYSCALL_MEMORY(sqe->tx_buf, sqe->txrx_buf_len, false);
+		valid_sqe &= Z_SYSCALL_MEMORY(sqe->rx_buf, sqe->txrx_buf_len, true);
+		break;
+	case RTIO_OP_TX_THEN_RX:
+		valid_sqe &= Z_SYSCALL_MEMORY(sqe->wr_buf, sqe->wr_buf_len, false);
+		valid_sqe &= Z_SYSCALL_MEMORY(sqe->rd_buf, sqe->rd_buf_len, true);
+		break;
 	default:
 		/* RTIO OP must be known */
 		valid_sqe = false;
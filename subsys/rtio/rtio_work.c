@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/rtio/rtio_work.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(rtio_work, CONFIG_RTIO_LOG_LEVEL);
+
+/* A submission waiting for the work queue */
+struct rtio_work_req {
+	struct k_work work;
+	const struct rtio_sqe *sqe;
+	struct rtio *r;
+	rtio_work_handler_t handler;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(rtio_work_slab, sizeof(struct rtio_work_req),
+			 CONFIG_RTIO_WORKQ_POOL_ITEMS, 4);
+
+static K_KERNEL_STACK_DEFINE(rtio_workq_stack, CONFIG_RTIO_WORKQ_STACK_SIZE);
+static struct k_work_q rtio_workq;
+
+static void rtio_work_handler(struct k_work *work)
+{
+	struct rtio_work_req *req = CONTAINER_OF(work, struct rtio_work_req, work);
+
+	req->handler(req->sqe, req->r);
+
+	/* Completing the submission may have queued the next one of the
+	 * chain while this request was still in use.
+	 */
+	k_mem_slab_free(&rtio_work_slab, (void **)&req);
+}
+
+void rtio_work_submit(const struct rtio_sqe *sqe, struct rtio *r,
+		      rtio_work_handler_t handler)
+{
+	struct rtio_work_req *req;
+
+	if (k_mem_slab_alloc(&rtio_work_slab, (void **)&req, K_NO_WAIT) != 0) {
+		LOG_WRN("No free request for sqe %p", sqe);
+		rtio_sqe_err(r, sqe, -ENOMEM);
+		return;
+	}
+
+	k_work_init(&req->work, rtio_work_handler);
+	req->sqe = sqe;
+	req->r = r;
+	req->handler = handler;
+
+	(void)k_work_submit_to_queue(&rtio_workq, &req->work);
+}
+
+static int rtio_work_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "rtio_workq",
+		.no_yield = false,
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&rtio_workq, rtio_workq_stack,
+			   K_KERNEL_STACK_SIZEOF(rtio_workq_stack),
+			   CONFIG_RTIO_WORKQ_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(rtio_work_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
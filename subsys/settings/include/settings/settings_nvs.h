@@ -24,14 +24,29 @@ extern "C" {
  * difference between name and value ID is constant and equal to
  * NVS_NAME_ID_OFFSET.
  *
- * Setting's name entries start from NVS_NAMECNT_ID + 1. The entry at
- * NVS_NAMECNT_ID is used to store the largest name ID in use.
+ * Setting's name entries start from NVS_NAMECNT_ID + 1 and end before
+ * NVS_BATCH_ID. The entry at NVS_NAMECNT_ID is used to store the largest name
+ * ID in use.
  *
  * Deleted records will not be found, only the last record will be
  * read.
+ *
+ * With CONFIG_SETTINGS_NVS_NAME_HASH, the setting's name is stored at the first
+ * ID with no name from NVS_NAMECNT_ID + 1 + (hash of the name modulo
+ * CONFIG_SETTINGS_NVS_NAME_HASH_SIZE) on, wrapping around. Names of deleted
+ * settings are replaced by a single '\0'. The entry at NVS_NAME_HASH_ID holds
+ * the table size and the largest ID of the settings stored before the table
+ * was in use.
+ *
+ * With CONFIG_SETTINGS_TRANSACTION, the settings of a transaction are first
+ * written to the entry at NVS_BATCH_ID, the last name ID, which is deleted
+ * once they are all saved. If it is found on initialization, its settings are
+ * saved again.
  */
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
+#define NVS_NAME_HASH_ID (NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET)
+#define NVS_BATCH_ID (NVS_NAME_HASH_ID - 1)
 
 struct settings_nvs {
 	struct settings_store cf_store;
@@ -46,6 +61,9 @@ struct settings_nvs {
 
 	uint16_t cache_next;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+	uint16_t hash_legacy_id;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -32,11 +32,18 @@ static int settings_fcb_load(struct settings_store *cs,
 static int settings_fcb_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
 static void *settings_fcb_storage_get(struct settings_store *cs);
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+static int settings_fcb_save_batch(struct settings_store *cs, const void *batch,
+				   size_t len);
+#endif
 
 static const struct settings_store_itf settings_fcb_itf = {
 	.csi_load = settings_fcb_load,
 	.csi_save = settings_fcb_save,
-	.csi_storage_get = settings_fcb_storage_get
+	.csi_storage_get = settings_fcb_storage_get,
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+	.csi_save_batch = settings_fcb_save_batch,
+#endif
 };
 
 /**
@@ -100,34 +107,111 @@ int settings_fcb_dst(struct settings_fcb *cf)
 	return 0;
 }
 
+/*
+ * Iterator over the settings lines stored in the FCB, including the lines in
+ * the batch entries written by transactions.
+ */
+struct settings_fcb_iter {
+	struct fcb_entry_ctx entry;
+	/* offset of the next line in a batch entry, 0 outside of batches */
+	uint16_t batch_off;
+};
+
+static size_t settings_fcb_batch_hdr_len(struct settings_fcb *cf)
+{
+	return ROUND_UP(sizeof(uint16_t), cf->cf_fcb.f_align);
+}
+
+/**
+ * @brief Get the next settings line
+ *
+ * @param cf        FCB handler
+ * @param it        Iterator, with a NULL sector to start from the oldest line
+ * @param line      Context of the line
+ * @param name      Buffer for the name of the line
+ * @param name_size Size of the name buffer
+ *
+ * @return Length of the name, or a negative error code if there are no more
+ * lines.
+ */
+static int settings_fcb_next(struct settings_fcb *cf,
+			     struct settings_fcb_iter *it,
+			     struct fcb_entry_ctx *line, char *name,
+			     size_t name_size)
+{
+	uint8_t align = cf->cf_fcb.f_align;
+	size_t name_len, len_read;
+	bool batch_line;
+	uint16_t len;
+	size_t off;
+	int rc;
+
+	while (1) {
+		batch_line = (it->batch_off != 0);
+
+		if (!batch_line) {
+			rc = fcb_getnext(&cf->cf_fcb, &it->entry.loc);
+			if (rc) {
+				return rc;
+			}
+			*line = it->entry;
+		} else {
+			rc = settings_line_raw_read(it->batch_off, (char *)&len,
+						    sizeof(len), &len_read,
+						    &it->entry);
+			off = it->batch_off + settings_fcb_batch_hdr_len(cf);
+			if (rc || len_read != sizeof(len) || len == 0 ||
+			    off + len > it->entry.loc.fe_data_len) {
+				it->batch_off = 0;
+				continue;
+			}
+
+			*line = it->entry;
+			line->loc.fe_data_off += off;
+			line->loc.fe_data_len = len;
+
+			off += ROUND_UP(len, align);
+			it->batch_off = (off < it->entry.loc.fe_data_len) ? off : 0;
+		}
+
+		rc = settings_line_name_read(name, name_size, &name_len, line);
+		if (rc) {
+			LOG_ERR("Failed to load line name: %d", rc);
+			continue;
+		}
+		name[name_len] = '\0';
+
+		if (!batch_line && !strcmp(name, SETTINGS_BATCH_NAME)) {
+			off = ROUND_UP(name_len + 1, align);
+			it->batch_off = (off < line->loc.fe_data_len) ? off : 0;
+			continue;
+		}
+
+		return name_len;
+	}
+}
+
 /**
  * @brief Check if there is any duplicate of the current setting
  *
  * This function checks if there is any duplicated data further in the buffer.
  *
- * @param cf        FCB handler
- * @param entry_ctx Current entry context
- * @param name      The name of the current entry
+ * @param cf   FCB handler
+ * @param it   Iterator at the current setting
+ * @param name The name of the current entry
  *
  * @retval false No duplicates found
  * @retval true  Duplicate found
  */
 static bool settings_fcb_check_duplicate(struct settings_fcb *cf,
-					const struct fcb_entry_ctx *entry_ctx,
+					const struct settings_fcb_iter *it,
 					const char * const name)
 {
-	struct fcb_entry_ctx entry2_ctx = *entry_ctx;
-
-	while (fcb_getnext(&cf->cf_fcb, &entry2_ctx.loc) == 0) {
-		char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
-		size_t name2_len;
+	struct settings_fcb_iter it2 = *it;
+	struct fcb_entry_ctx line2;
+	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 
-		if (settings_line_name_read(name2, sizeof(name2), &name2_len,
-					    &entry2_ctx)) {
-			LOG_ERR("failed to load line");
-			continue;
-		}
-		name2[name2_len] = '\0';
+	while (settings_fcb_next(cf, &it2, &line2, name2, sizeof(name2)) >= 0) {
 		if (!strcmp(name, name2)) {
 			return true;
 		}
@@ -149,40 +233,31 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 				  bool filter_duplicates)
 {
 	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
-	struct fcb_entry_ctx entry_ctx = {
-		{.fe_sector = NULL, .fe_elem_off = 0},
-		.fap = cf->cf_fcb.fap
+	struct settings_fcb_iter it = {
+		.entry = {
+			{.fe_sector = NULL, .fe_elem_off = 0},
+			.fap = cf->cf_fcb.fap
+		},
 	};
+	struct fcb_entry_ctx line;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	int rc;
 
-	while ((rc = fcb_getnext(&cf->cf_fcb, &entry_ctx.loc)) == 0) {
-		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
-		size_t name_len;
-		int rc;
+	while ((rc = settings_fcb_next(cf, &it, &line, name, sizeof(name))) >= 0) {
+		size_t name_len = rc;
 		bool pass_entry = true;
 
-		rc = settings_line_name_read(name, sizeof(name), &name_len,
-					     (void *)&entry_ctx);
-		if (rc) {
-			LOG_ERR("Failed to load line name: %d", rc);
-			continue;
-		}
-		name[name_len] = '\0';
-
 		if (filter_duplicates &&
-		    (!read_entry_len(&entry_ctx, name_len+1) ||
-		     settings_fcb_check_duplicate(cf, &entry_ctx, name))) {
+		    (!read_entry_len(&line, name_len+1) ||
+		     settings_fcb_check_duplicate(cf, &it, name))) {
 			pass_entry = false;
 		}
 		/*name, val-read_cb-ctx, val-off*/
 		/* take into account '=' separator after the name */
 		if (pass_entry) {
-			cb(name, &entry_ctx, name_len + 1, cb_arg);
+			cb(name, &line, name_len + 1, cb_arg);
 		}
 	}
-	if (rc == -ENOTSUP) {
-		rc = 0;
-	}
 	return 0;
 }
 
@@ -217,37 +292,34 @@ static int read_handler(void *ctx, off_t off, char *buf, size_t *len)
 static void settings_fcb_compress(struct settings_fcb *cf)
 {
 	int rc;
+	struct settings_fcb_iter it1;
+	struct settings_fcb_iter it2;
 	struct fcb_entry_ctx loc1;
 	struct fcb_entry_ctx loc2;
-	char name1[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
-	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
+	struct fcb_entry_ctx dst;
+	char name1[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	int copy;
-	uint8_t rbs;
 
 	rc = fcb_append_to_scratch(&cf->cf_fcb);
 	if (rc) {
 		return; /* XXX */
 	}
 
-	rbs = flash_area_align(cf->cf_fcb.fap);
+	it1.entry.fap = cf->cf_fcb.fap;
+	it1.entry.loc.fe_sector = NULL;
+	it1.entry.loc.fe_elem_off = 0U;
+	it1.batch_off = 0U;
+	dst.fap = cf->cf_fcb.fap;
 
-	loc1.fap = cf->cf_fcb.fap;
-
-	loc1.loc.fe_sector = NULL;
-	loc1.loc.fe_elem_off = 0U;
-
-	while (fcb_getnext(&cf->cf_fcb, &loc1.loc) == 0) {
+	/* The settings of a batch entry are copied one by one */
+	while ((rc = settings_fcb_next(cf, &it1, &loc1, name1,
+				       sizeof(name1))) >= 0) {
 		if (loc1.loc.fe_sector != cf->cf_fcb.f_oldest) {
 			break;
 		}
 
-		size_t val1_off;
-
-		rc = settings_line_name_read(name1, sizeof(name1), &val1_off,
-					     &loc1);
-		if (rc) {
-			continue;
-		}
+		size_t val1_off = rc;
 
 		if (val1_off + 1 == loc1.loc.fe_data_len) {
 			/* Lack of a value so the record is a deletion-record */
@@ -256,20 +328,12 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 			continue;
 		}
 
-		loc2 = loc1;
+		it2 = it1;
 		copy = 1;
 
-		while (fcb_getnext(&cf->cf_fcb, &loc2.loc) == 0) {
-			size_t val2_off;
-
-			rc = settings_line_name_read(name2, sizeof(name2),
-						     &val2_off, &loc2);
-			if (rc) {
-				continue;
-			}
-
-			if ((val1_off == val2_off) &&
-			    !memcmp(name1, name2, val1_off)) {
+		while (settings_fcb_next(cf, &it2, &loc2, name2,
+					 sizeof(name2)) >= 0) {
+			if (!strcmp(name1, name2)) {
 				copy = 0;
 				break;
 			}
@@ -281,17 +345,17 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 		/*
 		 * Can't find one. Must copy.
 		 */
-		rc = fcb_append(&cf->cf_fcb, loc1.loc.fe_data_len, &loc2.loc);
+		rc = fcb_append(&cf->cf_fcb, loc1.loc.fe_data_len, &dst.loc);
 		if (rc) {
 			continue;
 		}
 
-		rc = settings_line_entry_copy(&loc2, 0, &loc1, 0,
+		rc = settings_line_entry_copy(&dst, 0, &loc1, 0,
 					      loc1.loc.fe_data_len);
 		if (rc) {
 			continue;
 		}
-		rc = fcb_append_finish(&cf->cf_fcb, &loc2.loc);
+		rc = fcb_append_finish(&cf->cf_fcb, &dst.loc);
 
 		if (rc != 0) {
 			LOG_ERR("Failed to finish fcb_append (%d)", rc);
@@ -320,24 +384,15 @@ static int write_handler(void *ctx, off_t off, char const *buf, size_t len)
 				buf, len);
 }
 
-/* ::csi_save implementation */
-static int settings_fcb_save_priv(struct settings_store *cs, const char *name,
-				  const char *value, size_t val_len)
+/* Allocate an FCB entry, compressing the FCB if it is full */
+static int settings_fcb_append(struct settings_fcb *cf, int len,
+			       struct fcb_entry_ctx *loc)
 {
-	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
-	struct fcb_entry_ctx loc;
-	int len;
 	int rc = -EINVAL;
 	int i;
 
-	if (!name) {
-		return -EINVAL;
-	}
-
-	len = settings_line_len_calc(name, val_len);
-
 	for (i = 0; i < cf->cf_fcb.f_sector_cnt; i++) {
-		rc = fcb_append(&cf->cf_fcb, len, &loc.loc);
+		rc = fcb_append(&cf->cf_fcb, len, &loc->loc);
 		if (rc != -ENOSPC) {
 			break;
 		}
@@ -351,7 +406,31 @@ static int settings_fcb_save_priv(struct settings_store *cs, const char *name,
 		return -EINVAL;
 	}
 
-	loc.fap = cf->cf_fcb.fap;
+	loc->fap = cf->cf_fcb.fap;
+
+	return 0;
+}
+
+/* ::csi_save implementation */
+static int settings_fcb_save_priv(struct settings_store *cs, const char *name,
+				  const char *value, size_t val_len)
+{
+	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
+	struct fcb_entry_ctx loc;
+	int len;
+	int rc;
+	int i;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	len = settings_line_len_calc(name, val_len);
+
+	rc = settings_fcb_append(cf, len, &loc);
+	if (rc) {
+		return rc;
+	}
 
 	rc = settings_line_write(name, value, val_len, 0, (void *)&loc);
 
@@ -387,6 +466,97 @@ static int settings_fcb_save(struct settings_store *cs, const char *name,
 	return settings_fcb_save_priv(cs, name, value, val_len);
 }
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+/*
+ * ::csi_save_batch implementation, the settings which are not stored yet are
+ * written to a single FCB entry, which is only valid once its CRC is written.
+ */
+static int settings_fcb_save_batch(struct settings_store *cs, const void *batch,
+				   size_t len)
+{
+	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
+	struct settings_line_batch_dup_check_arg cdca = {
+		.batch = batch,
+		.len = len,
+	};
+	struct settings_batch_entry entry;
+	struct settings_batch_entry last = { 0 };
+	struct fcb_entry_ctx loc;
+	uint8_t align = cf->cf_fcb.f_align;
+	size_t hdr_len = settings_fcb_batch_hdr_len(cf);
+	char hdr[32]; /* aligned to write-block-size as in settings_line_write */
+	size_t batch_len, off, w_off;
+	uint16_t line_len;
+	int count = 0;
+	size_t n;
+	int rc;
+
+	settings_fcb_load_priv(cs, settings_line_batch_dup_check_cb, &cdca,
+			       false);
+
+	batch_len = ROUND_UP(strlen(SETTINGS_BATCH_NAME) + 1, align);
+	off = 0;
+	for (n = 0; settings_batch_next(batch, len, &off, &entry) == 0; n++) {
+		if (settings_line_batch_is_dup(&cdca, n)) {
+			continue;
+		}
+
+		last = entry;
+		count++;
+		batch_len += hdr_len + ROUND_UP(settings_line_len_calc(
+				entry.name, entry.val_len), align);
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	if (count == 1) {
+		return settings_fcb_save_priv(cs, last.name, last.value,
+					      last.val_len);
+	}
+
+	if (batch_len >= FCB_MAX_LEN || hdr_len > sizeof(hdr)) {
+		return -EFBIG;
+	}
+
+	rc = settings_fcb_append(cf, batch_len, &loc);
+	if (rc) {
+		return rc;
+	}
+
+	rc = settings_line_write(SETTINGS_BATCH_NAME, NULL, 0, 0, &loc);
+	w_off = ROUND_UP(strlen(SETTINGS_BATCH_NAME) + 1, align);
+	off = 0;
+	for (n = 0; !rc && settings_batch_next(batch, len, &off, &entry) == 0;
+	     n++) {
+		if (settings_line_batch_is_dup(&cdca, n)) {
+			continue;
+		}
+
+		line_len = settings_line_len_calc(entry.name, entry.val_len);
+		memset(hdr, 0, hdr_len);
+		memcpy(hdr, &line_len, sizeof(line_len));
+
+		rc = write_handler(&loc, w_off, hdr, hdr_len);
+		if (rc) {
+			break;
+		}
+
+		rc = settings_line_write(entry.name, entry.value, entry.val_len,
+					 w_off + hdr_len, &loc);
+		w_off += hdr_len + ROUND_UP(line_len, align);
+	}
+
+	/* Without its CRC, the entry is skipped when loading */
+	if (rc) {
+		return -EIO;
+	}
+
+	return fcb_append_finish(&cf->cf_fcb, &loc.loc);
+}
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 void settings_mount_fcb_backend(struct settings_fcb *cf)
 {
 	uint8_t rbs;
@@ -34,11 +34,18 @@ static int settings_file_load(struct settings_store *cs,
 static int settings_file_save(struct settings_store *cs, const char *name,
 			      const char *value, size_t val_len);
 static void *settings_file_storage_get(struct settings_store *cs);
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+static int settings_file_save_batch(struct settings_store *cs,
+				    const void *batch, size_t len);
+#endif
 
 static const struct settings_store_itf settings_file_itf = {
 	.csi_load = settings_file_load,
 	.csi_save = settings_file_save,
-	.csi_storage_get = settings_file_storage_get
+	.csi_storage_get = settings_file_storage_get,
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+	.csi_save_batch = settings_file_save_batch,
+#endif
 };
 
 /*
@@ -69,38 +76,115 @@ int settings_file_dst(struct settings_file *cf)
 	return 0;
 }
 
+/*
+ * Iterator over the settings lines stored in the file, including the lines in
+ * the batch lines written by transactions.
+ */
+struct settings_file_iter {
+	struct line_entry_ctx entry;
+	/* offset of the next line in a batch line, 0 outside of batches */
+	size_t batch_off;
+	/* number of lines read, batch lines counting as one */
+	int lines;
+};
+
+/**
+ * @brief Get the next settings line
+ *
+ * @param it        Iterator, with a 0 seek and len to start from the first
+ *                  line
+ * @param line      Context of the line
+ * @param name      Buffer for the name of the line
+ * @param name_size Size of the name buffer
+ *
+ * @return Length of the name, or a negative error code if there are no more
+ * lines.
+ */
+static int settings_file_next(struct settings_file_iter *it,
+			      struct line_entry_ctx *line, char *name,
+			      size_t name_size)
+{
+	size_t name_len, len_read;
+	bool batch_line;
+	uint16_t len;
+	size_t off;
+	char last;
+	int rc;
+
+	while (1) {
+		batch_line = (it->batch_off != 0);
+
+		if (!batch_line) {
+			rc = settings_next_line_ctx(&it->entry);
+			if (rc || it->entry.len == 0) {
+				return -ENOENT;
+			}
+			*line = it->entry;
+			it->lines++;
+		} else {
+			rc = settings_line_raw_read(it->batch_off, (char *)&len,
+						    sizeof(len), &len_read,
+						    &it->entry);
+			off = it->batch_off + sizeof(len);
+			if (rc || len_read != sizeof(len) || len == 0 ||
+			    off + len > it->entry.len) {
+				it->batch_off = 0;
+				continue;
+			}
+
+			line->stor_ctx = it->entry.stor_ctx;
+			line->seek = it->entry.seek + off;
+			line->len = len;
+
+			off += len;
+			it->batch_off = (off < it->entry.len) ? off : 0;
+		}
+
+		rc = settings_line_name_read(name, name_size, &name_len, line);
+		if (rc || name_len == 0) {
+			continue;
+		}
+		name[name_len] = '\0';
+
+		if (!batch_line && !strcmp(name, SETTINGS_BATCH_NAME)) {
+			/* Skip a batch line which was not written in full */
+			rc = settings_line_raw_read(line->len - 1, &last,
+						    sizeof(last), &len_read,
+						    line);
+			if (rc || len_read != sizeof(last)) {
+				continue;
+			}
+
+			off = name_len + 1;
+			it->batch_off = (off < line->len) ? off : 0;
+			continue;
+		}
+
+		return name_len;
+	}
+}
+
 /**
  * @brief Check if there is any duplicate of the current setting
  *
  * This function checks if there is any duplicated data further in the buffer.
  *
- * @param entry_ctx Current entry context
- * @param name      The name of the current entry
+ * @param it   Iterator at the current setting
+ * @param name The name of the current entry
  *
  * @retval false No duplicates found
  * @retval true  Duplicate found
  */
 static bool settings_file_check_duplicate(
-				  const struct line_entry_ctx *entry_ctx,
+				  const struct settings_file_iter *it,
 				  const char * const name)
 {
-	struct line_entry_ctx entry2_ctx = *entry_ctx;
+	struct settings_file_iter it2 = *it;
+	struct line_entry_ctx line2;
+	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 
 	/* Searching the duplicates */
-	while (settings_next_line_ctx(&entry2_ctx) == 0) {
-		char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
-		size_t name2_len;
-
-		if (entry2_ctx.len == 0) {
-			break;
-		}
-
-		if (settings_line_name_read(name2, sizeof(name2), &name2_len,
-					    &entry2_ctx)) {
-			continue;
-		}
-		name2[name2_len] = '\0';
-
+	while (settings_file_next(&it2, &line2, name2, sizeof(name2)) >= 0) {
 		if (!strcmp(name, name2)) {
 			return true;
 		}
@@ -121,16 +205,16 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 {
 	struct settings_file *cf = CONTAINER_OF(cs, struct settings_file, cf_store);
 	struct fs_file_t file;
-	int lines;
 	int rc;
 
-	struct line_entry_ctx entry_ctx = {
-		.stor_ctx = (void *)&file,
-		.seek = 0,
-		.len = 0 /* unknown length */
+	struct settings_file_iter it = {
+		.entry = {
+			.stor_ctx = (void *)&file,
+			.seek = 0,
+			.len = 0 /* unknown length */
+		},
 	};
-
-	lines = 0;
+	struct line_entry_ctx line;
 
 	fs_file_t_init(&file);
 
@@ -148,34 +232,26 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 		size_t name_len;
 		bool pass_entry = true;
 
-		rc = settings_next_line_ctx(&entry_ctx);
-		if (rc || entry_ctx.len == 0) {
+		rc = settings_file_next(&it, &line, name, sizeof(name));
+		if (rc < 0) {
 			break;
 		}
-
-		rc = settings_line_name_read(name, sizeof(name), &name_len,
-					     &entry_ctx);
-
-		if (rc || name_len == 0) {
-			break;
-		}
-		name[name_len] = '\0';
+		name_len = rc;
 
 		if (filter_duplicates &&
-		    (!read_entry_len(&entry_ctx, name_len+1) ||
-		     settings_file_check_duplicate(&entry_ctx, name))) {
+		    (!read_entry_len(&line, name_len+1) ||
+		     settings_file_check_duplicate(&it, name))) {
 			pass_entry = false;
 		}
 		/*name, val-read_cb-ctx, val-off*/
 		/* take into account '=' separator after the name */
 		if (pass_entry) {
-			cb(name, (void *)&entry_ctx, name_len + 1, cb_arg);
+			cb(name, (void *)&line, name_len + 1, cb_arg);
 		}
-		lines++;
 	}
 
 	rc = fs_close(&file);
-	cf->cf_lines = lines;
+	cf->cf_lines = it.lines;
 
 	return rc;
 }
@@ -226,7 +302,8 @@ static int settings_file_create_or_replace(struct fs_file_t *zfp,
 }
 
 /*
- * Try to compress configuration file by keeping unique names only.
+ * Try to compress configuration file by keeping unique names only, then
+ * append the new value, if any.
  */
 static int settings_file_save_and_compress(struct settings_file *cf,
 			   const char *name, const char *value,
@@ -236,14 +313,18 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	struct fs_file_t rf;
 	struct fs_file_t wf;
 	char tmp_file[SETTINGS_FILE_NAME_MAX];
-	char name1[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
-	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN];
-	struct line_entry_ctx loc1 = {
-		.stor_ctx = &rf,
-		.seek = 0,
-		.len = 0 /* unknown length */
+	char name1[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	struct settings_file_iter it1 = {
+		.entry = {
+			.stor_ctx = &rf,
+			.seek = 0,
+			.len = 0 /* unknown length */
+		},
 	};
+	struct settings_file_iter it2;
 
+	struct line_entry_ctx loc1;
 	struct line_entry_ctx loc2;
 
 	struct line_entry_ctx loc3 = {
@@ -252,7 +333,6 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 
 	int copy;
 	int lines;
-	size_t new_name_len;
 	size_t val1_off;
 
 	fs_file_t_init(&rf);
@@ -270,22 +350,15 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	}
 
 	lines = 0;
-	new_name_len = strlen(name);
 
+	/* The settings of a batch line are copied one by one */
 	while (1) {
-		rc = settings_next_line_ctx(&loc1);
-
-		if (rc || loc1.len == 0) {
+		rc = settings_file_next(&it1, &loc1, name1, sizeof(name1));
+		if (rc < 0) {
 			/* try to amend new value to the compressed file */
 			break;
 		}
-
-		rc = settings_line_name_read(name1, sizeof(name1), &val1_off,
-					     &loc1);
-		if (rc) {
-			/* try to process next line */
-			continue;
-		}
+		val1_off = rc;
 
 		if (val1_off + 1 == loc1.len) {
 			/* Lack of a value so the record is a deletion-record */
@@ -295,33 +368,16 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 		}
 
 		/* avoid copping value which will be overwritten by new value*/
-		if ((val1_off == new_name_len) &&
-		    !memcmp(name1, name, val1_off)) {
+		if (name && !strcmp(name1, name)) {
 			continue;
 		}
 
-		loc2 = loc1;
+		it2 = it1;
 
 		copy = 1;
-		while (1) {
-			size_t val2_off;
-
-			rc = settings_next_line_ctx(&loc2);
-
-			if (rc || loc2.len == 0) {
-				/* try to amend new value to */
-				/* the compressed file */
-				break;
-			}
-
-			rc = settings_line_name_read(name2, sizeof(name2),
-						     &val2_off, &loc2);
-			if (rc) {
-				/* try to process next line */
-				continue;
-			}
-			if ((val1_off == val2_off) &&
-			    !memcmp(name1, name2, val1_off)) {
+		while (settings_file_next(&it2, &loc2, name2,
+					  sizeof(name2)) >= 0) {
+			if (!strcmp(name1, name2)) {
 				copy = 0; /* newer version doesn't exist */
 				break;
 			}
@@ -343,10 +399,13 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 	}
 
 	/* at last store the new value */
-	rc = settings_line_write(name, value, val_len, 0, &loc3);
-	if (rc) {
-		/* compressed file might be corrupted */
-		goto end_rolback;
+	if (name) {
+		rc = settings_line_write(name, value, val_len, 0, &loc3);
+		if (rc) {
+			/* compressed file might be corrupted */
+			goto end_rolback;
+		}
+		lines++;
 	}
 
 	rc = fs_close(&wf);
@@ -355,7 +414,7 @@ static int settings_file_save_and_compress(struct settings_file *cf,
 		if (fs_rename(tmp_file, cf->cf_name)) {
 			return -ENOENT;
 		}
-		cf->cf_lines = lines + 1;
+		cf->cf_lines = lines;
 	} else {
 		rc = -EIO;
 	}
@@ -511,6 +570,111 @@ static int write_handler(void *ctx, off_t off, char const *buf, size_t len)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+/*
+ * ::csi_save_batch implementation, the settings which are not stored yet are
+ * appended as a single line, which is ignored if it is not written in full.
+ */
+static int settings_file_save_batch(struct settings_store *cs,
+				    const void *batch, size_t len)
+{
+	struct settings_file *cf = CONTAINER_OF(cs, struct settings_file, cf_store);
+	struct settings_line_batch_dup_check_arg cdca = {
+		.batch = batch,
+		.len = len,
+	};
+	struct settings_batch_entry entry;
+	struct settings_batch_entry last = { 0 };
+	struct line_entry_ctx entry_ctx;
+	struct fs_file_t file;
+	size_t batch_len, off;
+	uint16_t len_field;
+	int count = 0;
+	size_t n;
+	int rc2;
+	int rc;
+
+	settings_file_load_priv(cs, settings_line_batch_dup_check_cb, &cdca,
+				false);
+
+	batch_len = strlen(SETTINGS_BATCH_NAME) + 1;
+	off = 0;
+	for (n = 0; settings_batch_next(batch, len, &off, &entry) == 0; n++) {
+		if (settings_line_batch_is_dup(&cdca, n)) {
+			continue;
+		}
+
+		last = entry;
+		count++;
+		batch_len += sizeof(len_field) +
+			     settings_line_len_calc(entry.name, entry.val_len);
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	if (count == 1) {
+		return settings_file_save_priv(cs, last.name, last.value,
+					       last.val_len);
+	}
+
+	if (batch_len > UINT16_MAX) {
+		return -EFBIG;
+	}
+
+	if (cf->cf_maxlines && (cf->cf_lines + 1 >= cf->cf_maxlines)) {
+		/*
+		 * Compress before config file size exceeds
+		 * the max number of lines.
+		 */
+		rc = settings_file_save_and_compress(cf, NULL, NULL, 0);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, cf->cf_name, FS_O_CREATE | FS_O_RDWR);
+	if (rc) {
+		return rc;
+	}
+
+	entry_ctx.stor_ctx = &file;
+
+	len_field = batch_len;
+	rc = write_handler(&entry_ctx, 0, (char *)&len_field,
+			   sizeof(len_field));
+	if (rc == 0) {
+		rc = write_handler(&entry_ctx, 0, SETTINGS_BATCH_NAME "=",
+				   strlen(SETTINGS_BATCH_NAME) + 1);
+	}
+
+	off = 0;
+	for (n = 0; !rc && settings_batch_next(batch, len, &off, &entry) == 0;
+	     n++) {
+		if (settings_line_batch_is_dup(&cdca, n)) {
+			continue;
+		}
+
+		rc = settings_line_write(entry.name, entry.value, entry.val_len,
+					 0, &entry_ctx);
+	}
+
+	if (rc == 0) {
+		cf->cf_lines++;
+	}
+
+	rc2 = fs_close(&file);
+	if (rc == 0) {
+		rc = rc2;
+	}
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 void settings_mount_file_backend(struct settings_file *cf)
 {
 	settings_line_io_init(read_handler, write_handler, get_len_cb, 1);
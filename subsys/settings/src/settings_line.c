@@ -387,6 +387,40 @@ int settings_line_dup_check_cb(const char *name, void *val_read_cb_ctx,
 	return 0;
 }
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+int settings_line_batch_dup_check_cb(const char *name, void *val_read_cb_ctx,
+				     off_t off, void *cb_arg)
+{
+	struct settings_line_batch_dup_check_arg *cdca = cb_arg;
+	struct settings_line_dup_check_arg entry_cdca;
+	struct settings_batch_entry entry;
+	size_t batch_off = 0;
+	size_t n;
+
+	for (n = 0; n < SETTINGS_BATCH_ENTRIES_MAX; n++) {
+		if (settings_batch_next(cdca->batch, cdca->len, &batch_off,
+					&entry)) {
+			break;
+		}
+
+		if (strcmp(name, entry.name)) {
+			continue;
+		}
+
+		entry_cdca.name = entry.name;
+		entry_cdca.val = entry.value;
+		entry_cdca.val_len = entry.val_len;
+		entry_cdca.is_dup = 0;
+		settings_line_dup_check_cb(name, val_read_cb_ctx, off,
+					   &entry_cdca);
+		WRITE_BIT(cdca->dup[n / 32], n % 32, entry_cdca.is_dup);
+		break;
+	}
+
+	return 0;
+}
+#endif
+
 static ssize_t settings_line_read_cb(void *cb_arg, void *data, size_t len)
 {
 	struct settings_line_read_value_cb_ctx *value_context = cb_arg;
@@ -33,11 +33,18 @@ static int settings_nvs_load(struct settings_store *cs,
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
 static void *settings_nvs_storage_get(struct settings_store *cs);
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+static int settings_nvs_save_batch(struct settings_store *cs, const void *batch,
+				   size_t len);
+#endif
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
 	.csi_save = settings_nvs_save,
-	.csi_storage_get = settings_nvs_storage_get
+	.csi_storage_get = settings_nvs_storage_get,
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+	.csi_save_batch = settings_nvs_save_batch,
+#endif
 };
 
 static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
@@ -118,6 +125,230 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+#define NVS_NAME_HASH_LAST_ID (NVS_NAMECNT_ID + CONFIG_SETTINGS_NVS_NAME_HASH_SIZE)
+
+/* Content of the NVS entry at NVS_NAME_HASH_ID */
+struct settings_nvs_hash_info {
+	uint16_t size;
+	uint16_t legacy_id;
+};
+
+static uint16_t settings_nvs_hash_next(uint16_t name_id)
+{
+	if (name_id == NVS_NAME_HASH_LAST_ID) {
+		return NVS_NAMECNT_ID + 1;
+	}
+
+	return name_id + 1;
+}
+
+static bool settings_nvs_hash_is_removed(const char *rdname, ssize_t len)
+{
+	return (len == 1) && (rdname[0] == '\0');
+}
+
+/* Find the name by probing the ids from the one its hash points to, until an
+ * id with no name. free_id is set to the first id of the probe sequence a new
+ * name can be written to, NVS_NAMECNT_ID if the table is full.
+ */
+static uint16_t settings_nvs_hash_find(struct settings_nvs *cf, const char *name,
+				       char *rdname, size_t len, uint16_t *free_id)
+{
+	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	uint16_t name_id;
+	ssize_t rc;
+
+	name_id = NVS_NAMECNT_ID + 1 + (name_hash % CONFIG_SETTINGS_NVS_NAME_HASH_SIZE);
+	*free_id = NVS_NAMECNT_ID;
+
+	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_HASH_SIZE; i++) {
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len - 1);
+
+		if (rc == -ENOENT) {
+			if (*free_id == NVS_NAMECNT_ID) {
+				*free_id = name_id;
+			}
+			break;
+		}
+
+		if (settings_nvs_hash_is_removed(rdname, rc)) {
+			if (*free_id == NVS_NAMECNT_ID) {
+				*free_id = name_id;
+			}
+		} else if ((rc > 0) && ((size_t)rc < len)) {
+			rdname[rc] = '\0';
+			if (!strcmp(name, rdname)) {
+				return name_id;
+			}
+		}
+
+		name_id = settings_nvs_hash_next(name_id);
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+/* Settings stored before the hash table was in use, or with another table
+ * size, might not be found by probing. They are searched for in the ids up to
+ * hash_legacy_id, until they are moved by their next save.
+ */
+static uint16_t settings_nvs_hash_legacy_find(struct settings_nvs *cf, const char *name,
+					      char *rdname, size_t len)
+{
+	ssize_t rc;
+
+	for (uint16_t name_id = NVS_NAMECNT_ID + 1; name_id <= cf->hash_legacy_id;
+	     name_id++) {
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len - 1);
+		if ((rc <= 0) || ((size_t)rc >= len)) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+		if (!strcmp(name, rdname)) {
+			return name_id;
+		}
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+/* Deleting the name would end the probing for the names stored after it, it
+ * is replaced by a single '\0' instead, which can be reused by a new name.
+ */
+static int settings_nvs_hash_remove(struct settings_nvs *cf, uint16_t name_id)
+{
+	int rc;
+
+	if (name_id <= NVS_NAME_HASH_LAST_ID) {
+		rc = nvs_write(&cf->cf_nvs, name_id, "", 1);
+	} else {
+		rc = nvs_delete(&cf->cf_nvs, name_id);
+	}
+
+	if (rc >= 0) {
+		rc = nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+	}
+
+	if (rc < 0) {
+		return rc;
+	}
+
+	return 0;
+}
+
+static int settings_nvs_hash_info_update(struct settings_nvs *cf)
+{
+	struct settings_nvs_hash_info info = {
+		.size = CONFIG_SETTINGS_NVS_NAME_HASH_SIZE,
+		.legacy_id = cf->hash_legacy_id,
+	};
+	uint16_t last_name_id;
+	int rc;
+
+	rc = nvs_write(&cf->cf_nvs, NVS_NAME_HASH_ID, &info, sizeof(info));
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* The largest name ID in use is kept up to date, so that the settings
+	 * are still found if the hash table is disabled again.
+	 */
+	last_name_id = MAX(NVS_NAME_HASH_LAST_ID, cf->hash_legacy_id);
+	if (last_name_id != cf->last_name_id) {
+		cf->last_name_id = last_name_id;
+		rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
+			       sizeof(uint16_t));
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static int settings_nvs_hash_init(struct settings_nvs *cf)
+{
+	struct settings_nvs_hash_info info;
+	ssize_t rc;
+
+	rc = nvs_read(&cf->cf_nvs, NVS_NAME_HASH_ID, &info, sizeof(info));
+	if ((rc == sizeof(info)) &&
+	    (info.size == CONFIG_SETTINGS_NVS_NAME_HASH_SIZE)) {
+		cf->hash_legacy_id = info.legacy_id;
+	} else {
+		/* Any stored setting is in the legacy ids */
+		cf->hash_legacy_id = cf->last_name_id;
+	}
+
+	return settings_nvs_hash_info_update(cf);
+}
+
+static int settings_nvs_hash_save(struct settings_nvs *cf, const char *name,
+				  const char *value, size_t val_len, bool delete)
+{
+	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t name_id, free_id, legacy_id = NVS_NAMECNT_ID;
+	int rc;
+
+	name_id = settings_nvs_hash_find(cf, name, rdname, sizeof(rdname), &free_id);
+	if (name_id == NVS_NAMECNT_ID) {
+		legacy_id = settings_nvs_hash_legacy_find(cf, name, rdname,
+							  sizeof(rdname));
+	}
+
+	if (delete) {
+		if (name_id == NVS_NAMECNT_ID) {
+			name_id = legacy_id;
+		}
+
+		if (name_id == NVS_NAMECNT_ID) {
+			return 0;
+		}
+
+		return settings_nvs_hash_remove(cf, name_id);
+	}
+
+	if ((name_id == NVS_NAMECNT_ID) && (free_id == NVS_NAMECNT_ID)) {
+		/* No free IDs left, keep the setting where it is if any */
+		name_id = legacy_id;
+	}
+
+	if (name_id != NVS_NAMECNT_ID) {
+		rc = nvs_write(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET, value,
+			       val_len);
+		if (rc < 0) {
+			return rc;
+		}
+
+		return 0;
+	}
+
+	if (free_id == NVS_NAMECNT_ID) {
+		return -ENOMEM;
+	}
+
+	/* write the value, then the name */
+	rc = nvs_write(&cf->cf_nvs, free_id + NVS_NAME_ID_OFFSET, value, val_len);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = nvs_write(&cf->cf_nvs, free_id, name, strlen(name));
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (legacy_id != NVS_NAMECNT_ID) {
+		/* the setting has been moved to its hashed ID */
+		return settings_nvs_hash_remove(cf, legacy_id);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_HASH */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -128,6 +359,11 @@ static int settings_nvs_load(struct settings_store *cs,
 	char buf;
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t hash_id, free_id;
+	bool legacy_left = false;
+#endif
 
 	name_id = cf->last_name_id + 1;
 
@@ -150,6 +386,20 @@ static int settings_nvs_load(struct settings_store *cs,
 			continue;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+		if ((rc1 <= 0) || (rc2 <= 0) ||
+		    settings_nvs_hash_is_removed(name, rc1)) {
+			/* Deleted settings item, or save or delete that did
+			 * not complete.
+			 */
+			if (!settings_nvs_hash_is_removed(name, rc1) ||
+			    (rc2 > 0)) {
+				settings_nvs_hash_remove(cf, name_id);
+			}
+			continue;
+		}
+#endif
+
 		if ((rc1 <= 0) || (rc2 <= 0)) {
 			/* Settings item is not stored correctly in the NVS.
 			 * NVS entry for its name or value is either missing
@@ -168,6 +418,23 @@ static int settings_nvs_load(struct settings_store *cs,
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+		if (name_id <= cf->hash_legacy_id) {
+			hash_id = settings_nvs_hash_find(cf, name, rdname,
+							 sizeof(rdname), &free_id);
+			if (hash_id == NVS_NAMECNT_ID) {
+				legacy_left = true;
+			} else if (hash_id != name_id) {
+				/* Left behind by a save moving the item to
+				 * its hashed ID.
+				 */
+				settings_nvs_hash_remove(cf, name_id);
+				continue;
+			}
+		}
+#endif
+
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -183,6 +450,15 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+	if (!ret && !legacy_left && (cf->hash_legacy_id != NVS_NAMECNT_ID)) {
+		/* All the items are found by probing from now on */
+		cf->hash_legacy_id = NVS_NAMECNT_ID;
+		ret = settings_nvs_hash_info_update(cf);
+	}
+#endif
+
 	return ret;
 }
 
@@ -202,6 +478,10 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+	return settings_nvs_hash_save(cf, name, value, val_len, delete);
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	name_id = settings_nvs_cache_match(cf, name, rdname, sizeof(rdname));
 	if (name_id != NVS_NAMECNT_ID) {
@@ -281,7 +561,7 @@ found:
 	}
 
 	/* No free IDs left. */
-	if (write_name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) {
+	if (write_name_id == NVS_BATCH_ID) {
 		return -ENOMEM;
 	}
 
@@ -314,6 +594,107 @@ found:
 	return 0;
 }
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+/* Save the settings of a transaction, then delete its entry at NVS_BATCH_ID */
+static int settings_nvs_batch_apply(struct settings_nvs *cf, const void *batch,
+				    size_t len, bool stored)
+{
+	struct settings_batch_entry entry;
+	size_t off = 0;
+	int rc;
+
+	while ((rc = settings_batch_next(batch, len, &off, &entry)) == 0) {
+		rc = settings_nvs_save(&cf->cf_store, entry.name, entry.value,
+				       entry.val_len);
+		if (rc) {
+			break;
+		}
+	}
+
+	if (rc == -ENOENT) {
+		rc = 0;
+	}
+
+	/* Even if a setting could not be saved, so that the transaction is
+	 * not written again over newer values on the next initialization.
+	 */
+	if (stored) {
+		int rc2 = nvs_delete(&cf->cf_nvs, NVS_BATCH_ID);
+
+		if (!rc) {
+			rc = rc2;
+		}
+	}
+
+	return rc;
+}
+
+static int settings_nvs_save_batch(struct settings_store *cs, const void *batch,
+				   size_t len)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+	struct settings_batch_entry entry;
+	size_t off = 0;
+	int count = 0;
+	ssize_t rc;
+
+	while ((rc = settings_batch_next(batch, len, &off, &entry)) == 0) {
+		count++;
+	}
+
+	if (rc != -ENOENT) {
+		return rc;
+	}
+
+	/* A single setting is saved atomically without the journal entry */
+	if (count > 1) {
+		rc = nvs_write(&cf->cf_nvs, NVS_BATCH_ID, batch, len);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return settings_nvs_batch_apply(cf, batch, len, count > 1);
+}
+
+/* Complete a transaction interrupted by a reset */
+static int settings_nvs_batch_replay(struct settings_nvs *cf)
+{
+	struct settings_batch_entry entry;
+	size_t off = 0;
+	size_t len;
+	ssize_t rc;
+
+	rc = nvs_read(&cf->cf_nvs, NVS_BATCH_ID, settings_txn_buf,
+		      sizeof(settings_txn_buf));
+	if (rc == -ENOENT) {
+		return 0;
+	}
+
+	if (rc < 0) {
+		return rc;
+	}
+
+	if ((size_t)rc > sizeof(settings_txn_buf)) {
+		LOG_ERR("Transaction of %d bytes dropped", (int)rc);
+		return nvs_delete(&cf->cf_nvs, NVS_BATCH_ID);
+	}
+
+	len = rc;
+	do {
+		rc = settings_batch_next(settings_txn_buf, len, &off, &entry);
+	} while (rc == 0);
+
+	if (rc != -ENOENT) {
+		LOG_ERR("Malformed transaction dropped");
+		return nvs_delete(&cf->cf_nvs, NVS_BATCH_ID);
+	}
+
+	LOG_DBG("Completing interrupted transaction");
+	return settings_nvs_batch_apply(cf, settings_txn_buf, len, true);
+}
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 /* Initialize the nvs backend. */
 int settings_nvs_backend_init(struct settings_nvs *cf)
 {
@@ -338,6 +719,20 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_HASH
+	rc = settings_nvs_hash_init(cf);
+	if (rc) {
+		return rc;
+	}
+#endif
+
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+	rc = settings_nvs_batch_replay(cf);
+	if (rc) {
+		return rc;
+	}
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
@@ -58,6 +58,38 @@ struct settings_line_dup_check_arg {
 	int is_dup;
 };
 
+/*
+ * Name of the FCB and file back-end entries holding the settings of a
+ * transaction. The value of such an entry is a sequence of settings lines,
+ * each one preceded by its length.
+ */
+#define SETTINGS_BATCH_NAME "\x1e"
+
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+/* The smallest transaction entry has a one character name and no value */
+#define SETTINGS_BATCH_ENTRIES_MAX \
+	(CONFIG_SETTINGS_TRANSACTION_BUF_SIZE / (2 * sizeof(uint16_t) + 2))
+
+struct settings_line_batch_dup_check_arg {
+	const void *batch;
+	size_t len;
+	/* bit n is set if the n-th entry of the batch is already stored */
+	uint32_t dup[DIV_ROUND_UP(SETTINGS_BATCH_ENTRIES_MAX, 32)];
+};
+
+int settings_line_batch_dup_check_cb(const char *name, void *val_read_cb_ctx,
+				     off_t off, void *cb_arg);
+
+static inline bool settings_line_batch_is_dup(
+	const struct settings_line_batch_dup_check_arg *cdca, size_t n)
+{
+	return (cdca->dup[n / 32] & BIT(n % 32)) != 0;
+}
+
+/* Buffer of the transaction, free while no transaction is in progress */
+extern uint8_t settings_txn_buf[CONFIG_SETTINGS_TRANSACTION_BUF_SIZE];
+#endif
+
 #ifdef CONFIG_SETTINGS_ENCODE_LEN
 /* in storage line contex */
 struct line_entry_ctx {
@@ -24,6 +24,16 @@ sys_slist_t settings_load_srcs;
 struct settings_store *settings_save_dst;
 extern struct k_mutex settings_lock;
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+/*
+ * Values staged in the transaction, each one as its name length and value
+ * length, its name with the terminating '\0' and its value.
+ */
+uint8_t settings_txn_buf[CONFIG_SETTINGS_TRANSACTION_BUF_SIZE];
+static size_t settings_txn_len;
+static k_tid_t settings_txn_owner;
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 void settings_src_register(struct settings_store *cs)
 {
 	sys_slist_append(&settings_load_srcs, &cs->cs_next);
@@ -96,6 +106,12 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 	int rc;
 	struct settings_store *cs;
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+	if (settings_txn_owner == k_current_get()) {
+		return settings_transaction_stage(name, value, val_len);
+	}
+#endif
+
 	cs = settings_save_dst;
 	if (!cs) {
 		return -ENOENT;
@@ -158,6 +174,171 @@ int settings_save(void)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+int settings_batch_next(const void *batch, size_t len, size_t *off,
+			struct settings_batch_entry *entry)
+{
+	const uint8_t *rec = (const uint8_t *)batch + *off;
+	uint16_t name_len;
+	uint16_t val_len;
+
+	if (*off == len) {
+		return -ENOENT;
+	}
+
+	if (*off + 2 * sizeof(uint16_t) > len) {
+		return -EINVAL;
+	}
+
+	memcpy(&name_len, rec, sizeof(name_len));
+	memcpy(&val_len, rec + sizeof(name_len), sizeof(val_len));
+	rec += 2 * sizeof(uint16_t);
+
+	if (*off + 2 * sizeof(uint16_t) + name_len + 1 + val_len > len ||
+	    rec[name_len] != '\0') {
+		return -EINVAL;
+	}
+
+	entry->name = (const char *)rec;
+	entry->value = val_len ? rec + name_len + 1 : NULL;
+	entry->val_len = val_len;
+	*off += 2 * sizeof(uint16_t) + name_len + 1 + val_len;
+
+	return 0;
+}
+
+int settings_transaction_begin(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	/* Another thread's transaction would hold the lock */
+	if (settings_txn_owner != NULL) {
+		k_mutex_unlock(&settings_lock);
+		return -EALREADY;
+	}
+
+	settings_txn_owner = k_current_get();
+	settings_txn_len = 0;
+
+	/* The lock is held until the transaction ends */
+	return 0;
+}
+
+int settings_transaction_stage(const char *name, const void *value,
+			       size_t val_len)
+{
+	struct settings_batch_entry entry;
+	size_t name_len, rec_len;
+	size_t off = 0;
+	size_t rec_off = 0;
+	size_t old_len = 0;
+	uint16_t hdr[2];
+	uint8_t *rec;
+
+	if (settings_txn_owner != k_current_get()) {
+		return -EINVAL;
+	}
+
+	if (!name || (val_len > 0 && value == NULL)) {
+		return -EINVAL;
+	}
+
+	if (value == NULL) {
+		val_len = 0;
+	}
+
+	name_len = strlen(name);
+	if (name_len > UINT16_MAX || val_len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	/* Look for a value staged before for the same name */
+	while (settings_batch_next(settings_txn_buf, settings_txn_len, &off,
+				   &entry) == 0) {
+		if (!strcmp(name, entry.name)) {
+			old_len = off - rec_off;
+			break;
+		}
+		rec_off = off;
+	}
+
+	rec_len = 2 * sizeof(uint16_t) + name_len + 1 + val_len;
+	if (settings_txn_len - old_len + rec_len > sizeof(settings_txn_buf)) {
+		return -ENOMEM;
+	}
+
+	if (old_len) {
+		memmove(&settings_txn_buf[rec_off],
+			&settings_txn_buf[rec_off + old_len],
+			settings_txn_len - rec_off - old_len);
+		settings_txn_len -= old_len;
+	}
+
+	hdr[0] = name_len;
+	hdr[1] = val_len;
+	rec = &settings_txn_buf[settings_txn_len];
+	memcpy(rec, hdr, sizeof(hdr));
+	rec += sizeof(hdr);
+	memcpy(rec, name, name_len + 1);
+	rec += name_len + 1;
+	if (val_len) {
+		memcpy(rec, value, val_len);
+	}
+	settings_txn_len += rec_len;
+
+	return 0;
+}
+
+static void settings_transaction_end(void)
+{
+	settings_txn_owner = NULL;
+	settings_txn_len = 0;
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_transaction_commit(void)
+{
+	struct settings_batch_entry entry;
+	struct settings_store *cs;
+	size_t off = 0;
+	int rc = 0;
+
+	if (settings_txn_owner != k_current_get()) {
+		return -EINVAL;
+	}
+
+	cs = settings_save_dst;
+	if (!cs) {
+		rc = -ENOENT;
+	} else if (settings_txn_len == 0) {
+		rc = 0;
+	} else if (cs->cs_itf->csi_save_batch) {
+		rc = cs->cs_itf->csi_save_batch(cs, settings_txn_buf,
+						settings_txn_len);
+	} else {
+		while (!rc && settings_batch_next(settings_txn_buf,
+						  settings_txn_len, &off,
+						  &entry) == 0) {
+			rc = cs->cs_itf->csi_save(cs, entry.name, entry.value,
+						  entry.val_len);
+		}
+	}
+
+	settings_transaction_end();
+
+	return rc;
+}
+
+void settings_transaction_abort(void)
+{
+	if (settings_txn_owner != k_current_get()) {
+		return;
+	}
+
+	settings_transaction_end();
+}
+#endif /* CONFIG_SETTINGS_TRANSACTION */
+
 int settings_storage_get(void **storage)
 {
 	struct settings_store *cs = settings_save_dst;
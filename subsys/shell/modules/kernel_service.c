@@ -92,7 +92,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	shell_print(shell, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		      thread->base.user_options,
 		      thread->base.prio,
-		      (int64_t)thread->base.timeout.dticks);
+		      (int64_t)z_timeout_remaining(&thread->base.timeout));
 	shell_print(shell, "\tstate: %s, entry: %p",
 		    k_thread_state_str(thread, state_str, sizeof(state_str)),
 		    thread->entry.pEntry);
@@ -247,6 +247,11 @@ static int cmd_kernel_heap(const struct shell *sh,
 	int err;
 	struct sys_memory_stats stats;
 
+#ifdef CONFIG_HEAP_MAGAZINE
+	/* Blocks cached in the magazines count as allocated otherwise */
+	k_heap_magazine_flush(CONTAINER_OF(&_system_heap, struct k_heap, heap));
+#endif
+
 	err = sys_heap_runtime_stats_get(&_system_heap, &stats);
 	if (err) {
 		shell_error(sh, "Failed to read kernel system heap statistics (err %d)", err);
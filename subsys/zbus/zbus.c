@@ -5,10 +5,20 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/net/buf.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/zbus/zbus.h>
 LOG_MODULE_REGISTER(zbus, CONFIG_ZBUS_LOG_LEVEL);
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+/* The data of the buffers is reference counted, so the clones given to each message subscriber
+ * share a single copy of the message. The user data holds the channel reference.
+ */
+NET_BUF_POOL_VAR_DEFINE(_zbus_msg_subscribers_pool, CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE,
+			CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_DATA_SIZE,
+			sizeof(struct zbus_channel *), NULL);
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks)
 {
 	int64_t now_ticks = sys_clock_tick_get();
@@ -16,6 +26,69 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks)
 	return K_TICKS((k_ticks_t)MAX(end_ticks - now_ticks, 0));
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+static inline bool _zbus_chan_is_seqlock(const struct zbus_channel *chan)
+{
+	return chan->seqlock != NULL;
+}
+
+/* The sequence is odd while a publication is in progress. The buffer being written is the one
+ * of the next version, so the previous message stays readable in the other buffer.
+ */
+static void _zbus_seqlock_write(const struct zbus_channel *chan, const void *msg)
+{
+	struct zbus_channel_seqlock *sl = chan->seqlock;
+	k_spinlock_key_t key = k_spin_lock(&sl->lock);
+	atomic_val_t seq = atomic_inc(&sl->seq) + 1;
+
+	/* Readers must see the odd sequence before any byte of the new message, and the whole
+	 * message before the even one.
+	 */
+	__sync_synchronize();
+
+	memcpy(_zbus_seqlock_msg(chan, seq + 1), msg, chan->message_size);
+
+	__sync_synchronize();
+
+	atomic_inc(&sl->seq);
+
+	k_spin_unlock(&sl->lock, key);
+}
+
+static int _zbus_seqlock_read(const struct zbus_channel *chan, void *msg, uint64_t end_ticks)
+{
+	struct zbus_channel_seqlock *sl = chan->seqlock;
+	atomic_val_t start, end;
+
+	while (true) {
+		start = atomic_get(&sl->seq);
+
+		memcpy(msg, _zbus_seqlock_msg(chan, start), chan->message_size);
+
+		__sync_synchronize();
+
+		/* The copied buffer is only overwritten by the second publication started after
+		 * the one that filled it.
+		 */
+		end = atomic_get(&sl->seq);
+		if ((unsigned long)end - (unsigned long)(start & ~1) < 3) {
+			return 0;
+		}
+
+		if (sys_clock_tick_get() >= end_ticks) {
+			return -EAGAIN;
+		}
+	}
+}
+#else
+static inline bool _zbus_chan_is_seqlock(const struct zbus_channel *chan)
+{
+	ARG_UNUSED(chan);
+
+	return false;
+}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0)
 static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *chan)
 {
@@ -63,7 +136,114 @@ static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *ch
 }
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE */
 
-static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_ticks)
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+/* msg is the published message, or NULL to take the current one of the channel. A seqlock
+ * channel may already hold a newer publication, so its publisher passes the message along.
+ */
+static int _zbus_msg_copy(const struct zbus_channel *chan, const void *msg,
+			  struct net_buf **buf, uint64_t end_ticks)
+{
+	*buf = net_buf_alloc_len(&_zbus_msg_subscribers_pool, chan->message_size,
+				 _zbus_timeout_remainder(end_ticks));
+	if (*buf == NULL) {
+		return -ENOMEM;
+	}
+
+	if (msg != NULL) {
+		net_buf_add_mem(*buf, msg, chan->message_size);
+
+		return 0;
+	}
+
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (_zbus_chan_is_seqlock(chan)) {
+		int err = _zbus_seqlock_read(chan, net_buf_add(*buf, chan->message_size),
+					     end_ticks);
+
+		if (err) {
+			net_buf_unref(*buf);
+			*buf = NULL;
+		}
+
+		return err;
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
+	net_buf_add_mem(*buf, chan->message, chan->message_size);
+
+	return 0;
+}
+
+static int _zbus_notify_msg_subscriber(const struct zbus_channel *chan, const void *msg,
+				       const struct zbus_observer *obs, struct net_buf **buf,
+				       uint64_t end_ticks)
+{
+	struct net_buf *clone;
+	int err;
+
+	/* The message is copied by the first message subscriber only */
+	if (*buf == NULL) {
+		err = _zbus_msg_copy(chan, msg, buf, end_ticks);
+		if (err) {
+			return err;
+		}
+	}
+
+	clone = net_buf_clone(*buf, _zbus_timeout_remainder(end_ticks));
+	if (clone == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(net_buf_user_data(clone), &chan, sizeof(chan));
+
+	net_buf_put(obs->message_fifo, clone);
+
+	return 0;
+}
+
+static int _zbus_notify_msg_subscribers(const struct zbus_channel *chan, const void *msg,
+					uint64_t end_ticks)
+{
+	int last_error = 0, err;
+	struct net_buf *buf = NULL;
+
+	for (const struct zbus_observer *const *obs = chan->observers; *obs != NULL; ++obs) {
+		if ((*obs)->enabled && ((*obs)->message_fifo != NULL)) {
+			err = _zbus_notify_msg_subscriber(chan, msg, *obs, &buf, end_ticks);
+			if (err) {
+				LOG_ERR("Observer %s at %p could not be notified. Error code %d",
+					_ZBUS_OBS_NAME(*obs), *obs, err);
+				last_error = err;
+			}
+		}
+	}
+
+#if CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0
+	struct zbus_observer_node *obs_nd, *tmp;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(chan->runtime_observers, obs_nd, tmp, node) {
+		if (obs_nd->obs->enabled && (obs_nd->obs->message_fifo != NULL)) {
+			err = _zbus_notify_msg_subscriber(chan, msg, obs_nd->obs, &buf,
+							  end_ticks);
+			if (err) {
+				LOG_ERR("Observer %s at %p could not be notified. Error code %d",
+					_ZBUS_OBS_NAME(obs_nd->obs), obs_nd->obs, err);
+				last_error = err;
+			}
+		}
+	}
+#endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE */
+
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+
+	return last_error;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+static int _zbus_notify_observers(const struct zbus_channel *chan, const void *msg,
+				  uint64_t end_ticks)
 {
 	int last_error = 0, err;
 	/* Notify static listeners */
@@ -97,22 +277,43 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_
 		last_error = err;
 	}
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE */
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+	err = _zbus_notify_msg_subscribers(chan, msg, end_ticks);
+	if (err) {
+		last_error = err;
+	}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 	return last_error;
 }
 
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
-	uint64_t end_ticks = sys_clock_timeout_end_calc(timeout);
+	uint64_t end_ticks;
 
-	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(!k_is_in_isr() || _zbus_chan_is_seqlock(chan),
+		     "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
 
 	if (chan->validator != NULL && !chan->validator(msg, chan->message_size)) {
 		return -ENOMSG;
 	}
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (_zbus_chan_is_seqlock(chan)) {
+		/* Subscribers' queues cannot be waited on from ISRs */
+		end_ticks = sys_clock_timeout_end_calc(k_is_in_isr() ? K_NO_WAIT : timeout);
+
+		_zbus_seqlock_write(chan, msg);
+
+		return _zbus_notify_observers(chan, msg, end_ticks);
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
+	end_ticks = sys_clock_timeout_end_calc(timeout);
+
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
 		return err;
@@ -120,7 +321,7 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 
 	memcpy(chan->message, msg, chan->message_size);
 
-	err = _zbus_notify_observers(chan, end_ticks);
+	err = _zbus_notify_observers(chan, NULL, end_ticks);
 
 	k_mutex_unlock(chan->mutex);
 
@@ -131,10 +332,17 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 {
 	int err;
 
-	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(!k_is_in_isr() || _zbus_chan_is_seqlock(chan),
+		     "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (_zbus_chan_is_seqlock(chan)) {
+		return _zbus_seqlock_read(chan, msg, sys_clock_timeout_end_calc(timeout));
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
 		return err;
@@ -148,17 +356,26 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 {
 	int err;
-	uint64_t end_ticks = sys_clock_timeout_end_calc(timeout);
+	uint64_t end_ticks;
 
-	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(!k_is_in_isr() || _zbus_chan_is_seqlock(chan),
+		     "zbus cannot be used inside ISRs");
+
+	if (_zbus_chan_is_seqlock(chan)) {
+		end_ticks = sys_clock_timeout_end_calc(k_is_in_isr() ? K_NO_WAIT : timeout);
+
+		return _zbus_notify_observers(chan, NULL, end_ticks);
+	}
+
+	end_ticks = sys_clock_timeout_end_calc(timeout);
 
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
 		return err;
 	}
 
-	err = _zbus_notify_observers(chan, end_ticks);
+	err = _zbus_notify_observers(chan, NULL, end_ticks);
 
 	k_mutex_unlock(chan->mutex);
 
@@ -170,6 +387,10 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+	if (_zbus_chan_is_seqlock(chan)) {
+		return -ENOTSUP;
+	}
+
 	int err = k_mutex_lock(chan->mutex, timeout);
 
 	if (err) {
@@ -184,6 +405,10 @@ int zbus_chan_finish(const struct zbus_channel *chan)
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+	if (_zbus_chan_is_seqlock(chan)) {
+		return -ENOTSUP;
+	}
+
 	int err = k_mutex_unlock(chan->mutex);
 
 	return err;
@@ -202,3 +427,32 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 
 	return k_msgq_get(sub->queue, chan, timeout);
 }
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
+		      k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	if (sub->message_fifo == NULL) {
+		return -EINVAL;
+	}
+
+	buf = net_buf_get(sub->message_fifo, timeout);
+	if (buf == NULL) {
+		return -ENOMSG;
+	}
+
+	memcpy(chan, net_buf_user_data(buf), sizeof(*chan));
+	memcpy(msg, buf->data, buf->len);
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
@@ -27,6 +27,13 @@ int zbus_chan_add_obs(const struct zbus_channel *chan, const struct zbus_observe
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 	_ZBUS_ASSERT(obs != NULL, "obs is required");
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	/* Lock-free channels notify without the mutex protecting the runtime list */
+	if (chan->seqlock != NULL) {
+		return -ENOTSUP;
+	}
+#endif
+
 	/* Check if the observer is already a static observer */
 	for (const struct zbus_observer *const *static_obs = chan->observers; *static_obs != NULL;
 	     ++static_obs) {
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* This benchmark measures k_heap allocation throughput for small,
+ * short-lived objects.  First a single thread allocates and frees
+ * batches of objects with sizes between 8 and 128 bytes and the
+ * average number of cycles per alloc/free pair is reported.  Then one
+ * thread per CPU does the same for RUN_MS and the total number of
+ * pairs per second is reported, which shows the contention on the
+ * heap lock on SMP systems.
+ *
+ * Build with CONFIG_HEAP_MAGAZINE=n to compare against plain k_heap
+ * allocations.  The heap statistics are checked at the end: once the
+ * magazines are flushed, no memory must be accounted as allocated.
+ */
+
+#define HEAP_SIZE 16384
+#define BATCH 16
+#define N_ROUNDS 1000
+#define RUN_MS 1000
+#define WORKER_PRIO 1
+
+K_HEAP_DEFINE(bench_heap, HEAP_SIZE);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_MAX_NUM_CPUS, 1024);
+static struct k_thread workers[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t worker_pairs[CONFIG_MP_MAX_NUM_CPUS];
+static volatile bool workers_stop;
+
+static inline size_t object_size(int i)
+{
+	return 8 + ((i * 40) % 121);
+}
+
+static uint32_t alloc_free_batch(void)
+{
+	void *objs[BATCH];
+	uint32_t pairs = 0;
+
+	for (int i = 0; i < BATCH; i++) {
+		objs[i] = k_heap_alloc(&bench_heap, object_size(i), K_NO_WAIT);
+	}
+
+	for (int i = 0; i < BATCH; i++) {
+		if (objs[i] != NULL) {
+			k_heap_free(&bench_heap, objs[i]);
+			pairs++;
+		}
+	}
+
+	return pairs;
+}
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!workers_stop) {
+		worker_pairs[id] += alloc_free_batch();
+	}
+}
+
+static void single_thread(void)
+{
+	uint64_t total = 0;
+	uint32_t pairs = 0;
+	uint32_t start;
+
+	/* Warm up, e.g. fill the magazines */
+	alloc_free_batch();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		start = k_cycle_get_32();
+		pairs += alloc_free_batch();
+		total += k_cycle_get_32() - start;
+	}
+
+	printk("single cycles/pair %6u\n", pairs ? (uint32_t)(total / pairs) : 0);
+}
+
+static void multi_thread(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint64_t total = 0;
+
+	workers_stop = false;
+
+	for (int i = 0; i < num_cpus; i++) {
+		worker_pairs[i] = 0;
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				worker_fn, INT_TO_POINTER(i), NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(RUN_MS);
+
+	workers_stop = true;
+
+	for (int i = 0; i < num_cpus; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		total += worker_pairs[i];
+	}
+
+	printk("threads %2u pairs/s %8llu\n", num_cpus,
+	       total * MSEC_PER_SEC / RUN_MS);
+}
+
+void main(void)
+{
+	struct sys_memory_stats stats;
+
+	single_thread();
+	multi_thread();
+
+#ifdef CONFIG_HEAP_MAGAZINE
+	k_heap_magazine_flush(&bench_heap);
+#endif
+
+	sys_heap_runtime_stats_get(&bench_heap.heap, &stats);
+	if (stats.allocated_bytes != 0) {
+		printk("%zu bytes still allocated\n", stats.allocated_bytes);
+	}
+
+	printk("fin\n");
+}
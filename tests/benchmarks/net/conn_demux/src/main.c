@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/ethernet.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+#include "connection.h"
+
+/* This benchmark measures how the cost of demultiplexing a received UDP
+ * packet to its connection handler grows with the number of registered
+ * handlers. Handlers are registered for consecutive local ports and, for
+ * each handler count in handler_steps, N_PACKETS packets are injected
+ * round robin to the registered ports. The average number of cycles spent
+ * in the RX path per packet and the resulting packet rate are reported.
+ *
+ * The RX and TX traffic classes are disabled so that net_recv_data()
+ * processes the packet synchronously in the caller context. Build with
+ * CONFIG_NET_CONN_PORT_INDEX=n to compare against the linear handler
+ * matching.
+ */
+
+#define LOCAL_PORT_BASE 5000
+#define PEER_PORT 9999
+#define N_PACKETS 2000
+
+static const uint16_t handler_steps[] = { 1, 8, 32, 64, 128, 256 };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static uint32_t received;
+
+static uint8_t bench_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, bench_mac, sizeof(bench_mac),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(demux_bench, "demux_bench", bench_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict bench_recv(struct net_conn *conn,
+				   struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   union net_proto_header *proto_hdr,
+				   void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	received++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_pkt *prepare_packet(uint16_t dst_port)
+{
+	static const uint8_t payload[16];
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(payload), AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) < 0 ||
+	    net_udp_create(pkt, htons(PEER_PORT), htons(dst_port)) < 0 ||
+	    net_pkt_write(pkt, payload, sizeof(payload)) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv4_finalize(pkt, IPPROTO_UDP) < 0) {
+		goto fail;
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static int register_handler(uint16_t local_port)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+
+	return net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+				 (struct sockaddr *)&local, 0, local_port,
+				 NULL, bench_recv, NULL, NULL);
+}
+
+static uint32_t measure(int handlers)
+{
+	uint64_t total = 0;
+	struct net_pkt *pkt;
+	uint32_t start;
+
+	received = 0;
+
+	for (int i = 0; i < N_PACKETS; i++) {
+		pkt = prepare_packet(LOCAL_PORT_BASE + (i % handlers));
+		if (!pkt) {
+			printk("Cannot allocate packet\n");
+			return 0;
+		}
+
+		start = k_cycle_get_32();
+		if (net_recv_data(iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+		}
+		total += k_cycle_get_32() - start;
+	}
+
+	if (received != N_PACKETS) {
+		printk("Only %u of %u packets delivered\n", received,
+		       N_PACKETS);
+	}
+
+	return (uint32_t)(total / N_PACKETS);
+}
+
+void main(void)
+{
+	uint32_t cycles;
+	int handlers = 0;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (!iface ||
+	    !net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot setup interface\n");
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(handler_steps); i++) {
+		if (handler_steps[i] > CONFIG_NET_MAX_CONN) {
+			break;
+		}
+
+		while (handlers < handler_steps[i]) {
+			ret = register_handler(LOCAL_PORT_BASE + handlers);
+			if (ret < 0) {
+				printk("Cannot register handler %d (%d)\n",
+				       handlers, ret);
+				return;
+			}
+
+			handlers++;
+		}
+
+		cycles = measure(handlers);
+
+		printk("handlers %4d cycles/pkt %6u pkts/s %8u\n", handlers,
+		       cycles, cycles ? sys_clock_hw_cycles_per_sec() / cycles : 0);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/ethernet.h>
+
+#include "ipv4.h"
+#include "tcp.h"
+#include "tcp_private.h"
+
+/* This benchmark measures the cost of delivering a TCP segment to an
+ * established connection as the number of open connections grows. It
+ * works like this: a listening context is created on a dummy interface
+ * and connections are opened to it by injecting SYN and ACK segments
+ * from different peer ports. For each connection count in conn_steps,
+ * N_SEGMENTS pure ACK segments are then injected round robin into the
+ * open connections and the average number of cycles spent in the RX path
+ * per segment is reported.
+ *
+ * The RX and TX traffic classes are disabled so that net_recv_data()
+ * processes the segment synchronously in the caller context. Build with
+ * CONFIG_NET_TCP_CONN_HASH=n to compare against the linear connection
+ * lookup.
+ */
+
+#define MY_PORT 4242
+#define PEER_PORT_BASE 10000
+#define N_SEGMENTS 1000
+
+static const uint16_t conn_steps[] = { 1, 8, 16, 32, 64, 128 };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static int accepted;
+
+static uint8_t bench_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, bench_mac, sizeof(bench_mac),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	/* Replies from the stack are not needed, the dummy L2 frees them */
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(tcp_bench, "tcp_bench", bench_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static struct net_pkt *prepare_segment(uint16_t peer_port, uint8_t flags,
+				       uint32_t seq, uint32_t ack)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct tcphdr), AF_INET,
+					IPPROTO_TCP, K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) < 0) {
+		goto fail;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		goto fail;
+	}
+
+	memset(th, 0, sizeof(struct tcphdr));
+
+	th->th_sport = htons(peer_port);
+	th->th_dport = htons(MY_PORT);
+	th->th_off = 5U;
+	th->th_flags = flags;
+	th->th_win = htons(NET_IPV6_MTU);
+	th->th_seq = htonl(seq);
+	th->th_ack = htonl(ack);
+
+	if (net_pkt_set_data(pkt, &tcp_access) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv4_finalize(pkt, IPPROTO_TCP) < 0) {
+		goto fail;
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static int inject(uint16_t peer_port, uint8_t flags, uint32_t seq,
+		  uint32_t ack)
+{
+	struct net_pkt *pkt;
+
+	pkt = prepare_segment(peer_port, flags, seq, ack);
+	if (!pkt) {
+		return -ENOMEM;
+	}
+
+	if (net_recv_data(iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void accept_cb(struct net_context *ctx, struct sockaddr *addr,
+		      socklen_t addrlen, int status, void *user_data)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addrlen);
+	ARG_UNUSED(user_data);
+
+	if (status == 0) {
+		accepted++;
+	}
+}
+
+/* The stack does not randomize the ISN when CONFIG_NET_TEST is set, so
+ * the three way handshake can be completed without looking at the
+ * SYN-ACK: our SYN uses seq 0 and the SYN-ACK has seq 0.
+ */
+static int open_conn(uint16_t peer_port)
+{
+	int ret;
+
+	ret = inject(peer_port, SYN, 0, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return inject(peer_port, ACK, 1, 1);
+}
+
+static uint32_t measure(int conns)
+{
+	uint64_t total = 0;
+	struct net_pkt *pkt;
+	uint32_t start;
+
+	for (int i = 0; i < N_SEGMENTS; i++) {
+		pkt = prepare_segment(PEER_PORT_BASE + (i % conns), ACK, 1, 1);
+		if (!pkt) {
+			printk("Cannot allocate segment\n");
+			return 0;
+		}
+
+		start = k_cycle_get_32();
+		if (net_recv_data(iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+		}
+		total += k_cycle_get_32() - start;
+	}
+
+	return (uint32_t)(total / N_SEGMENTS);
+}
+
+void main(void)
+{
+	struct sockaddr_in my_addr_s = {
+		.sin_family = AF_INET,
+		.sin_port = htons(MY_PORT),
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+	struct net_context *ctx;
+	int conns = 0;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (!iface ||
+	    !net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot setup interface\n");
+		return;
+	}
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret == 0) {
+		ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+				       sizeof(my_addr_s));
+	}
+
+	if (ret == 0) {
+		ret = net_context_listen(ctx, 0);
+	}
+
+	if (ret == 0) {
+		ret = net_context_accept(ctx, accept_cb, K_NO_WAIT, NULL);
+	}
+
+	if (ret < 0) {
+		printk("Cannot setup listening context (%d)\n", ret);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(conn_steps); i++) {
+		while (conns < conn_steps[i]) {
+			ret = open_conn(PEER_PORT_BASE + conns);
+			if (ret < 0) {
+				printk("Cannot open connection %d (%d)\n",
+				       conns, ret);
+				return;
+			}
+
+			conns++;
+		}
+
+		if (accepted != conns) {
+			printk("Only %d of %d connections accepted\n",
+			       accepted, conns);
+			return;
+		}
+
+		printk("conns %4d cycles/segment %6u\n", conns,
+		       measure(conns));
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/printk.h>
+
+/* This benchmark measures the NVS read latency against the number of
+ * stored IDs, on the flash simulator.  For each step, the storage is
+ * cleared and filled with one entry per ID, then every ID is read
+ * READ_ROUNDS times and the average time per read is reported, along
+ * with the time to mount the file system again, which includes
+ * rebuilding the lookup cache or index.
+ *
+ * Build with CONFIG_NVS_LOOKUP_INDEX=n, with or without
+ * CONFIG_NVS_LOOKUP_CACHE, to compare against the lookup cache and
+ * plain ATE walks.
+ */
+
+#define NVS_PARTITION storage_partition
+#define NVS_PARTITION_OFFSET FIXED_PARTITION_OFFSET(NVS_PARTITION)
+#define NVS_PARTITION_SIZE FIXED_PARTITION_SIZE(NVS_PARTITION)
+#define NVS_PARTITION_DEV FIXED_PARTITION_DEVICE(NVS_PARTITION)
+
+#define SECTOR_SIZE 8192
+#define READ_ROUNDS 4
+
+static const uint16_t id_counts[] = { 16, 64, 256, 1024, 2048 };
+
+static struct nvs_fs fs = {
+	.flash_device = NVS_PARTITION_DEV,
+	.offset = NVS_PARTITION_OFFSET,
+	.sector_size = SECTOR_SIZE,
+	.sector_count = NVS_PARTITION_SIZE / SECTOR_SIZE,
+};
+
+static int fill(uint16_t count)
+{
+	uint32_t data;
+	ssize_t rc;
+
+	for (uint16_t id = 0; id < count; id++) {
+		data = id;
+		rc = nvs_write(&fs, id, &data, sizeof(data));
+		if (rc != sizeof(data)) {
+			printk("write of id %u failed (%d)\n", id, (int)rc);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int measure(uint16_t count)
+{
+	uint64_t read_cycles = 0;
+	uint32_t mount_cycles;
+	uint32_t start;
+	uint32_t data;
+	ssize_t rc;
+
+	if (fs.ready) {
+		rc = nvs_clear(&fs);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rc = nvs_mount(&fs);
+	if (rc) {
+		return rc;
+	}
+
+	rc = fill(count);
+	if (rc) {
+		return rc;
+	}
+
+	start = k_cycle_get_32();
+	rc = nvs_mount(&fs);
+	mount_cycles = k_cycle_get_32() - start;
+	if (rc) {
+		return rc;
+	}
+
+	for (int round = 0; round < READ_ROUNDS; round++) {
+		for (uint16_t id = 0; id < count; id++) {
+			start = k_cycle_get_32();
+			rc = nvs_read(&fs, id, &data, sizeof(data));
+			read_cycles += k_cycle_get_32() - start;
+
+			if (rc != sizeof(data) || data != id) {
+				printk("read of id %u failed (%d)\n", id, (int)rc);
+				return -EIO;
+			}
+		}
+	}
+
+	printk("ids %5u read ns %8llu mount ms %6llu\n", count,
+	       k_cyc_to_ns_floor64(read_cycles / (READ_ROUNDS * count)),
+	       k_cyc_to_ms_floor64(mount_cycles));
+
+	return 0;
+}
+
+void main(void)
+{
+	int rc;
+
+	if (!device_is_ready(fs.flash_device)) {
+		printk("flash device not ready\n");
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(id_counts); i++) {
+		rc = measure(id_counts[i]);
+		if (rc) {
+			printk("step with %u ids failed (%d)\n", id_counts[i], rc);
+			break;
+		}
+	}
+
+	printk("fin\n");
+}
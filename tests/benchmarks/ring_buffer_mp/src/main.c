@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/ring_buffer_mp.h>
+#include <zephyr/sys/printk.h>
+
+/* This benchmark measures the throughput of several producer threads
+ * writing 16 byte records to a ring buffer drained by a consumer thread,
+ * comparing ring_buf guarded by a spinlock, as multi-producer users of
+ * ring_buf do, against the lock-free ring_buf_mp.
+ *
+ * All threads have the same priority and time slicing is enabled, so on a
+ * single CPU the producers are preempted in the middle of a write.  On SMP
+ * targets they also run in parallel.
+ */
+
+#define RECORD_SIZE 16
+#define RECORDS 20000
+#define MAX_PRODUCERS 4
+#define STACK_SIZE 1024
+#define PRIO K_PRIO_PREEMPT(5)
+
+static const uint8_t producer_counts[] = { 1, 2, 4 };
+
+RING_BUF_DECLARE(locked_rb, 1024);
+static struct k_spinlock locked_rb_lock;
+
+RING_BUF_MP_DECLARE(mp_rb, 1024 / sizeof(atomic_t));
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_PRODUCERS + 1, STACK_SIZE);
+static struct k_thread threads[MAX_PRODUCERS + 1];
+
+static void locked_produce(void *p1, void *p2, void *p3)
+{
+	uint32_t records = (uintptr_t)p1;
+	uint8_t rec[RECORD_SIZE] = { 0 };
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	while (records) {
+		key = k_spin_lock(&locked_rb_lock);
+		if (ring_buf_space_get(&locked_rb) >= sizeof(rec)) {
+			len = ring_buf_put(&locked_rb, rec, sizeof(rec));
+		} else {
+			len = 0;
+		}
+		k_spin_unlock(&locked_rb_lock, key);
+
+		if (len) {
+			records--;
+		}
+	}
+}
+
+static void locked_consume(void *p1, void *p2, void *p3)
+{
+	uint32_t records = (uintptr_t)p1;
+	uint8_t rec[RECORD_SIZE];
+
+	/* Producers commit whole records under the lock and the consumer is
+	 * alone, so it does not need the lock.
+	 */
+	while (records) {
+		if (ring_buf_get(&locked_rb, rec, sizeof(rec)) == sizeof(rec)) {
+			records--;
+		}
+	}
+}
+
+static void mp_produce(void *p1, void *p2, void *p3)
+{
+	uint32_t records = (uintptr_t)p1;
+	uint8_t rec[RECORD_SIZE] = { 0 };
+
+	while (records) {
+		if (ring_buf_mp_put(&mp_rb, rec, sizeof(rec))) {
+			records--;
+		}
+	}
+}
+
+static void mp_consume(void *p1, void *p2, void *p3)
+{
+	uint32_t records = (uintptr_t)p1;
+	uint8_t rec[RECORD_SIZE];
+
+	while (records) {
+		if (ring_buf_mp_get(&mp_rb, rec, sizeof(rec)) > 0) {
+			records--;
+		}
+	}
+}
+
+static void measure(const char *name, k_thread_entry_t produce,
+		    k_thread_entry_t consume, uint8_t producers)
+{
+	uint32_t records = RECORDS / producers;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE, consume,
+			(void *)(uintptr_t)(records * producers), NULL, NULL,
+			PRIO, 0, K_NO_WAIT);
+	for (uint8_t i = 1; i <= producers; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, produce,
+				(void *)(uintptr_t)records, NULL, NULL,
+				PRIO, 0, K_NO_WAIT);
+	}
+
+	for (uint8_t i = 0; i <= producers; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	printk("%-9s producers %u ns/record %6llu\n", name, producers,
+	       k_cyc_to_ns_floor64(cycles) / (records * producers));
+}
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(producer_counts); i++) {
+		ring_buf_reset(&locked_rb);
+		measure("locked", locked_produce, locked_consume,
+			producer_counts[i]);
+
+		ring_buf_mp_init(&mp_rb, mp_rb.size, mp_rb.buffer);
+		measure("lock-free", mp_produce, mp_consume, producer_counts[i]);
+	}
+
+	printk("fin\n");
+}
@@ -36,6 +36,8 @@
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
 static struct k_thread partner_thread;
 
+void smp_throughput(void);
+
 _wait_q_t waitq;
 
 enum {
@@ -148,5 +150,10 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+	if (IS_ENABLED(CONFIG_SMP)) {
+		smp_throughput();
+	}
+
 	printk("fin\n");
 }
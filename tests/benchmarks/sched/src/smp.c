@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* Multi-core wake/switch throughput test.  A ring of worker threads
+ * (N_WORKERS_PER_CPU per CPU) passes semaphore "tokens" around: each
+ * worker waits on its own semaphore, counts the wakeup and gives the
+ * semaphore of the next worker in the ring.  One token per CPU is
+ * circulating, so all CPUs are constantly waking threads up and
+ * switching to them concurrently, which stresses the run queue(s) and
+ * the scheduler lock.  After SMP_RUN_MS the total number of wakeups per
+ * second is reported.
+ */
+
+#define N_WORKERS_PER_CPU 2
+#define MAX_WORKERS (CONFIG_MP_MAX_NUM_CPUS * N_WORKERS_PER_CPU)
+#define WORKER_PRIO 1
+#define SMP_RUN_MS 1000
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, MAX_WORKERS, 1024);
+static struct k_thread workers[MAX_WORKERS];
+static struct k_sem worker_sems[MAX_WORKERS];
+static uint32_t worker_counts[MAX_WORKERS];
+static volatile bool workers_stop;
+static int n_workers;
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	int next = (id + 1) % n_workers;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&worker_sems[id], K_FOREVER);
+
+		if (workers_stop) {
+			return;
+		}
+
+		worker_counts[id]++;
+		k_sem_give(&worker_sems[next]);
+	}
+}
+
+void smp_throughput(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint64_t total = 0U;
+
+	if (num_cpus < 2) {
+		return;
+	}
+
+	n_workers = num_cpus * N_WORKERS_PER_CPU;
+	workers_stop = false;
+
+	for (int i = 0; i < n_workers; i++) {
+		worker_counts[i] = 0U;
+		k_sem_init(&worker_sems[i], 0, 1);
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				worker_fn, INT_TO_POINTER(i), NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	/* One token per CPU, spread evenly over the ring */
+	for (int i = 0; i < num_cpus; i++) {
+		k_sem_give(&worker_sems[i * N_WORKERS_PER_CPU]);
+	}
+
+	k_msleep(SMP_RUN_MS);
+
+	workers_stop = true;
+
+	for (int i = 0; i < n_workers; i++) {
+		k_sem_give(&worker_sems[i]);
+	}
+
+	for (int i = 0; i < n_workers; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		total += worker_counts[i];
+	}
+
+	printk("smp cpus %u threads %d wakeups %llu/s\n", num_cpus, n_workers,
+	       total * MSEC_PER_SEC / SMP_RUN_MS);
+}
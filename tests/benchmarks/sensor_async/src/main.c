@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+#include <zephyr/sys/printk.h>
+
+#include "akm09918c_emul.h"
+#include "akm09918c_reg.h"
+
+/* This benchmark measures the rate at which the samples of an emulated
+ * magnetometer are read and converted to fixed point, and the CPU time spent
+ * per sample, comparing:
+ * - fetch: sensor_sample_fetch() and sensor_channel_get() for each sample,
+ * - pool: batches of reads into memory pool buffers, decoded as they complete,
+ * - stream: a multishot read, decoded as samples arrive.
+ * The sensor is in continuous mode, so no read waits for a measurement.
+ */
+
+#define SAMPLES 2000
+#define BATCH 16
+#define BLOCK_SIZE 16
+
+static const struct device *const dev = DEVICE_DT_GET(DT_NODELABEL(akm09918c));
+
+SENSOR_DT_READ_IODEV(magn_iodev, DT_NODELABEL(akm09918c), SENSOR_CHAN_MAGN_XYZ);
+RTIO_EXECUTOR_SIMPLE_DEFINE(bench_exec);
+RTIO_DEFINE_WITH_MEMPOOL(bench_rtio, (struct rtio_executor *)&bench_exec, BATCH, BATCH, BATCH,
+			 BLOCK_SIZE, sizeof(uint64_t));
+
+static const struct sensor_decoder_api *decoder;
+static int64_t checksum;
+
+struct bench_start {
+	uint32_t cycles;
+	uint64_t busy_cycles;
+};
+
+static void bench_begin(struct bench_start *start)
+{
+	k_thread_runtime_stats_t stats;
+
+	k_thread_runtime_stats_all_get(&stats);
+	start->busy_cycles = stats.total_cycles;
+	start->cycles = k_cycle_get_32();
+}
+
+static void bench_end(const char *name, const struct bench_start *start, uint32_t samples)
+{
+	k_thread_runtime_stats_t stats;
+	uint64_t ns, busy_ns;
+	uint32_t cycles = k_cycle_get_32() - start->cycles;
+
+	k_thread_runtime_stats_all_get(&stats);
+	ns = k_cyc_to_ns_floor64(cycles);
+	busy_ns = k_cyc_to_ns_floor64(stats.total_cycles - start->busy_cycles);
+
+	printk("%-6s samples/s %8llu cpu ns/sample %8llu\n", name,
+	       (uint64_t)samples * NSEC_PER_SEC / MAX(ns, 1ULL), busy_ns / MAX(samples, 1U));
+}
+
+static void decode(const uint8_t *buf)
+{
+	uint32_t fit = 0;
+	q31_t values[3];
+
+	if (decoder->decode(buf, SENSOR_CHAN_MAGN_XYZ, &fit, 1, values) == 1) {
+		checksum += values[0] + values[1] + values[2];
+	}
+}
+
+static void bench_fetch(void)
+{
+	struct sensor_value values[3];
+	struct bench_start start;
+
+	bench_begin(&start);
+
+	for (int i = 0; i < SAMPLES; i++) {
+		(void)sensor_sample_fetch(dev);
+		(void)sensor_channel_get(dev, SENSOR_CHAN_MAGN_XYZ, values);
+		checksum += values[0].val2 + values[1].val2 + values[2].val2;
+	}
+
+	bench_end("fetch", &start, SAMPLES);
+}
+
+static void bench_pool(void)
+{
+	struct bench_start start;
+	struct rtio_cqe *cqe;
+	struct rtio_sqe *sqe;
+	uint32_t samples = 0;
+	uint32_t buf_len;
+	uint8_t *buf;
+
+	bench_begin(&start);
+
+	for (int i = 0; i < SAMPLES / BATCH; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			sqe = rtio_sqe_acquire(&bench_rtio);
+			sqe->flags = 0;
+			rtio_sqe_prep_read_with_pool(sqe, &magn_iodev, RTIO_PRIO_NORM, BLOCK_SIZE,
+						     NULL);
+		}
+		(void)rtio_submit(&bench_rtio, BATCH);
+
+		while ((cqe = rtio_cqe_consume(&bench_rtio)) != NULL) {
+			if (cqe->result == 0 &&
+			    rtio_cqe_get_mempool_buffer(&bench_rtio, cqe, &buf, &buf_len) == 0) {
+				decode(buf);
+				rtio_release_buffer(&bench_rtio, buf, buf_len);
+				samples++;
+			}
+			rtio_cqe_release_all(&bench_rtio);
+		}
+	}
+
+	bench_end("pool", &start, samples);
+}
+
+static void bench_stream(void)
+{
+	struct bench_start start;
+	struct rtio_cqe *cqe;
+	struct rtio_sqe *sqe;
+	uint32_t samples = 0;
+	uint32_t buf_len;
+	uint8_t *buf;
+	int result;
+
+	bench_begin(&start);
+
+	sqe = rtio_sqe_acquire(&bench_rtio);
+	sqe->flags = 0;
+	rtio_sqe_prep_read_multishot(sqe, &magn_iodev, RTIO_PRIO_NORM, BLOCK_SIZE, NULL);
+	(void)rtio_submit(&bench_rtio, 0);
+
+	do {
+		cqe = rtio_cqe_consume_block(&bench_rtio);
+		result = cqe->result;
+		if (result == 0 &&
+		    rtio_cqe_get_mempool_buffer(&bench_rtio, cqe, &buf, &buf_len) == 0) {
+			decode(buf);
+			rtio_release_buffer(&bench_rtio, buf, buf_len);
+			if (++samples == SAMPLES) {
+				(void)rtio_sqe_cancel(&bench_rtio, sqe);
+			}
+		}
+		rtio_cqe_release_all(&bench_rtio);
+	} while (result == 0);
+
+	bench_end("stream", &start, samples);
+}
+
+void main(void)
+{
+	const struct emul *target = EMUL_DT_GET(DT_NODELABEL(akm09918c));
+	const struct sensor_value freq = { .val1 = 100 };
+	const uint8_t st1 = AKM09918C_ST1_DRDY;
+	const uint8_t data[6] = { 0x10, 0x20, 0x30, 0x40, 0x50, 0x60 };
+
+	if (!device_is_ready(dev) ||
+	    sensor_attr_set(dev, SENSOR_CHAN_MAGN_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &freq) != 0 ||
+	    sensor_get_decoder(dev, &decoder) != 0) {
+		printk("sensor setup failed\n");
+		return;
+	}
+
+	/* In continuous mode the data stays ready */
+	akm09918c_emul_set_reg(target, AKM09918C_REG_ST1, &st1, 1);
+	akm09918c_emul_set_reg(target, AKM09918C_REG_HXL, data, sizeof(data));
+
+	bench_fetch();
+	bench_pool();
+	bench_stream();
+
+	printk("checksum %lld\n", checksum);
+	printk("fin\n");
+}
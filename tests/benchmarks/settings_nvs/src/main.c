@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/printk.h>
+
+/* This benchmark measures settings_save_one() on the NVS back-end against
+ * the number of stored settings, on the flash simulator.  Keys are added
+ * up to each step of key_counts, and the average time to save a new key,
+ * the average time to save an existing key again and the time to load all
+ * the keys are reported.
+ *
+ * Build with CONFIG_SETTINGS_NVS_NAME_HASH=n, with or without
+ * CONFIG_SETTINGS_NVS_NAME_CACHE, to compare against the name cache and
+ * plain name scans.
+ */
+
+#define UPDATE_KEYS 128
+
+static const uint32_t key_counts[] = { 128, 512, 2048 };
+
+static uint32_t loaded;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static int save(uint32_t key, uint32_t value)
+{
+	char name[16];
+
+	snprintf(name, sizeof(name), "bench/%04x", key);
+
+	return settings_save_one(name, &value, sizeof(value));
+}
+
+static int measure(uint32_t from, uint32_t to)
+{
+	uint64_t insert_cycles, update_cycles;
+	uint32_t load_cycles;
+	uint32_t start;
+	int rc;
+
+	start = k_cycle_get_32();
+	for (uint32_t key = from; key < to; key++) {
+		rc = save(key, key);
+		if (rc) {
+			printk("save of key %u failed (%d)\n", key, rc);
+			return rc;
+		}
+	}
+	insert_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < UPDATE_KEYS; i++) {
+		uint32_t key = i * to / UPDATE_KEYS;
+
+		rc = save(key, key + to);
+		if (rc) {
+			printk("update of key %u failed (%d)\n", key, rc);
+			return rc;
+		}
+	}
+	update_cycles = k_cycle_get_32() - start;
+
+	loaded = 0;
+	start = k_cycle_get_32();
+	rc = settings_load();
+	load_cycles = k_cycle_get_32() - start;
+	if (rc || loaded != to) {
+		printk("load failed (%d), %u keys loaded\n", rc, loaded);
+		return rc ? rc : -EIO;
+	}
+
+	printk("keys %5u insert us %6llu update us %6llu load ms %6llu\n", to,
+	       k_cyc_to_us_floor64(insert_cycles / (to - from)),
+	       k_cyc_to_us_floor64(update_cycles / UPDATE_KEYS),
+	       k_cyc_to_ms_floor64(load_cycles));
+
+	return 0;
+}
+
+void main(void)
+{
+	uint32_t from = 0;
+	int rc;
+
+	rc = settings_subsys_init();
+	if (rc) {
+		printk("settings init failed (%d)\n", rc);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(key_counts); i++) {
+		rc = measure(from, key_counts[i]);
+		if (rc) {
+			break;
+		}
+		from = key_counts[i];
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timeout_q.h>
+
+/* This benchmark measures the cost of arming and cancelling kernel
+ * timeouts as the number of pending timeouts grows.  For each count
+ * in timeout_steps, that many timeouts with pseudo random durations
+ * (spread from a few ticks up to MAX_TICKS, like a mix of
+ * retransmission, keepalive and housekeeping timers) are armed and
+ * then aborted in a different order.  The average number of cycles
+ * per z_add_timeout() and z_abort_timeout() call is reported.
+ *
+ * Build with CONFIG_TIMEOUT_WHEEL=n to compare against the sorted
+ * delta list.
+ */
+
+#define MAX_TIMEOUTS 2048
+#define MAX_TICKS 100000
+
+static const uint16_t timeout_steps[] = { 16, 64, 256, 1024, 2048 };
+
+static struct _timeout timeouts[MAX_TIMEOUTS];
+static uint32_t durations[MAX_TIMEOUTS];
+
+static void timeout_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static uint32_t rand_state = 0x12345678;
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic LCG, so that all runs use the same durations */
+	rand_state = rand_state * 1103515245U + 12345U;
+
+	return rand_state >> 8;
+}
+
+static void measure(int n, uint32_t *add, uint32_t *abort)
+{
+	uint64_t add_total = 0;
+	uint64_t abort_total = 0;
+	uint32_t start;
+
+	for (int i = 0; i < n; i++) {
+		z_init_timeout(&timeouts[i]);
+
+		start = k_cycle_get_32();
+		z_add_timeout(&timeouts[i], timeout_fn, K_TICKS(durations[i]));
+		add_total += k_cycle_get_32() - start;
+	}
+
+	/* Cancel with a stride coprime to n, i.e. not in arming order */
+	for (int i = 0, j = 0; i < n; i++, j = (j + 7) % n) {
+		start = k_cycle_get_32();
+		z_abort_timeout(&timeouts[j]);
+		abort_total += k_cycle_get_32() - start;
+	}
+
+	*add = (uint32_t)(add_total / n);
+	*abort = (uint32_t)(abort_total / n);
+}
+
+void main(void)
+{
+	uint32_t add, abort;
+
+	for (int i = 0; i < MAX_TIMEOUTS; i++) {
+		durations[i] = 1 + (next_rand() % MAX_TICKS);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(timeout_steps); i++) {
+		measure(timeout_steps[i], &add, &abort);
+
+		printk("timeouts %5u add %6u abort %6u\n", timeout_steps[i],
+		       add, abort);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* This benchmark measures the throughput of independent work items, each
+ * one busy for a fixed time, submitted from a single thread to a work queue.
+ * A single k_work_q processes them one at a time, while a pool of work queues
+ * with one thread per CPU processes them in parallel.  On a single CPU the
+ * pool shows the cost of the additional threads and of stealing.
+ */
+
+#define ITEMS 64
+#define ROUNDS 20
+#define STACK_SIZE 1024
+#define PRIO K_PRIO_PREEMPT(1)
+#define NUM_QUEUES CONFIG_MP_MAX_NUM_CPUS
+
+static const uint32_t loads_us[] = { 0, 10, 100 };
+
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static struct k_work_q single_queue;
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_QUEUES, STACK_SIZE);
+static struct k_work_q pool_queues[NUM_QUEUES];
+static struct k_work_q_pool pool;
+
+static struct k_work items[ITEMS];
+static struct k_sem done_sem;
+static atomic_t pending;
+static uint32_t load_us;
+
+static void item_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (load_us != 0U) {
+		k_busy_wait(load_us);
+	}
+
+	if (atomic_dec(&pending) == 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void measure(const char *name, struct k_work_q_pool *p,
+		    struct k_work_q *queue)
+{
+	uint32_t start, cycles;
+	uint64_t ns;
+
+	start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		atomic_set(&pending, ITEMS);
+
+		for (int i = 0; i < ITEMS; i++) {
+			if (p != NULL) {
+				(void)k_work_submit_to_pool(p, &items[i]);
+			} else {
+				(void)k_work_submit_to_queue(queue, &items[i]);
+			}
+		}
+
+		(void)k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	printk("%-6s load %3u us items/s %8llu\n", name, load_us,
+	       (uint64_t)ITEMS * ROUNDS * NSEC_PER_SEC / MAX(ns, 1ULL));
+}
+
+void main(void)
+{
+	k_sem_init(&done_sem, 0, 1);
+
+	for (int i = 0; i < ITEMS; i++) {
+		k_work_init(&items[i], item_handler);
+	}
+
+	k_work_queue_start(&single_queue, single_stack, STACK_SIZE, PRIO, NULL);
+	k_work_queue_pool_start(&pool, pool_queues, NUM_QUEUES,
+				&pool_stacks[0][0], STACK_SIZE, PRIO, NULL);
+
+	printk("pool of %u queues\n", NUM_QUEUES);
+
+	for (int i = 0; i < ARRAY_SIZE(loads_us); i++) {
+		load_us = loads_us[i];
+
+		measure("single", NULL, &single_queue);
+		measure("pool", &pool, NULL);
+	}
+
+	printk("fin\n");
+}
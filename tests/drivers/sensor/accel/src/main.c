@@ -13,6 +13,9 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/drivers/sensor.h>
+#ifdef CONFIG_SENSOR_ASYNC_API
+#include <zephyr/rtio/rtio_executor_simple.h>
+#endif
 
 struct sensor_accel_fixture {
 	const struct device *accel_spi;
@@ -69,6 +72,43 @@ ZTEST_USER_F(sensor_accel, test_sensor_accel_basic_i2c)
 	test_sensor_accel_basic(fixture->accel_i2c);
 }
 
+#ifdef CONFIG_SENSOR_ASYNC_API
+SENSOR_DT_READ_IODEV(accel_iodev, DT_ALIAS(accel_0), SENSOR_CHAN_ACCEL_X, SENSOR_CHAN_ACCEL_Y,
+		     SENSOR_CHAN_ACCEL_Z, SENSOR_CHAN_GYRO_X, SENSOR_CHAN_GYRO_Y,
+		     SENSOR_CHAN_GYRO_Z);
+RTIO_EXECUTOR_SIMPLE_DEFINE(accel_exec);
+RTIO_DEFINE(accel_rtio, (struct rtio_executor *)&accel_exec, 1, 1);
+
+/* The driver has no native support, the default decoder is used */
+ZTEST_F(sensor_accel, test_sensor_accel_read_decode)
+{
+	const struct sensor_decoder_api *decoder;
+	uint8_t buf[128] __aligned(8);
+	uint64_t timestamp;
+
+	zassert_ok(sensor_read(&accel_iodev, &accel_rtio, buf, sizeof(buf)));
+	zassert_ok(sensor_get_decoder(fixture->accel_spi, &decoder));
+	zassert_ok(decoder->get_timestamp(buf, &timestamp));
+	zassert_true(timestamp <= k_ticks_to_ns_floor64(k_uptime_ticks()));
+
+	for (int i = 0; i < ARRAY_SIZE(channel); i++) {
+		struct sensor_value val;
+		uint32_t fit = 0;
+		int8_t shift;
+		q31_t q;
+
+		zassert_ok(sensor_channel_get(fixture->accel_spi, channel[i], &val));
+		zassert_ok(decoder->get_shift(buf, channel[i], &shift));
+		zassert_equal(1, decoder->decode(buf, channel[i], &fit, 1, &q));
+		zassert_within(sensor_value_to_micro(&val), sensor_q31_to_micro(q, shift), 1,
+			       "channel %d", channel[i]);
+	}
+
+	/* Too small for the frame */
+	zassert_equal(-ENOMEM, sensor_read(&accel_iodev, &accel_rtio, buf, 32));
+}
+#endif /* CONFIG_SENSOR_ASYNC_API */
+
 static void *sensor_accel_setup(void)
 {
 	static struct sensor_accel_fixture fixture = {
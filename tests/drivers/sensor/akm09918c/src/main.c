@@ -8,6 +8,7 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/gpio/gpio_emul.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
 #include <zephyr/ztest.h>
 
 #include "akm09918c_emul.h"
@@ -47,12 +48,9 @@ ZTEST_F(akm09918c, test_fetch_fail_no_ready_data)
 	zassert_equal(-EBUSY, sensor_sample_fetch(fixture->dev));
 }
 
-static void test_fetch_magnetic_field(const struct akm09918c_fixture *fixture,
-				      const int16_t magn_percent[3])
+static void set_magnetic_field(const struct akm09918c_fixture *fixture,
+			       const int16_t magn_percent[3])
 {
-	struct sensor_value values[3];
-	int64_t expect_ugauss;
-	int64_t actual_ugauss;
 	uint8_t register_buffer[6];
 
 	/* Set the ST1 register to show we have data */
@@ -65,6 +63,16 @@ static void test_fetch_magnetic_field(const struct akm09918c_fixture *fixture,
 		register_buffer[i * 2] = magn_percent[i] & GENMASK(7, 0);
 	}
 	akm09918c_emul_set_reg(fixture->target, AKM09918C_REG_HXL, register_buffer, 6);
+}
+
+static void test_fetch_magnetic_field(const struct akm09918c_fixture *fixture,
+				      const int16_t magn_percent[3])
+{
+	struct sensor_value values[3];
+	int64_t expect_ugauss;
+	int64_t actual_ugauss;
+
+	set_magnetic_field(fixture, magn_percent);
 
 	/* Fetch the data */
 	zassert_ok(sensor_sample_fetch(fixture->dev));
@@ -101,3 +109,59 @@ ZTEST_F(akm09918c, test_fetch_magn)
 
 	test_fetch_magnetic_field(fixture, magn_percent);
 }
+
+#ifdef CONFIG_SENSOR_ASYNC_API
+SENSOR_DT_READ_IODEV(akm09918c_iodev, DT_NODELABEL(akm09918c), SENSOR_CHAN_MAGN_XYZ);
+RTIO_EXECUTOR_SIMPLE_DEFINE(akm09918c_exec);
+RTIO_DEFINE(akm09918c_rtio, (struct rtio_executor *)&akm09918c_exec, 1, 1);
+
+ZTEST_F(akm09918c, test_read_decode_magn)
+{
+	const int16_t magn_percent[3] = {
+		INT16_C(32752) / INT16_C(4),
+		INT16_C(-32751) / INT16_C(3),
+		INT16_MIN,
+	};
+	const struct sensor_decoder_api *decoder;
+	uint8_t buf[32] __aligned(8);
+	uint16_t frame_count;
+	uint32_t fit = 0;
+	q31_t values[3];
+	int8_t shift;
+
+	set_magnetic_field(fixture, magn_percent);
+
+	zassert_ok(sensor_read(&akm09918c_iodev, &akm09918c_rtio, buf, sizeof(buf)));
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+
+	zassert_ok(decoder->get_frame_count(buf, &frame_count));
+	zassert_equal(1, frame_count);
+	zassert_ok(decoder->get_shift(buf, SENSOR_CHAN_MAGN_XYZ, &shift));
+	zassert_equal(-ENOTSUP, decoder->get_shift(buf, SENSOR_CHAN_ACCEL_XYZ, &shift));
+
+	zassert_equal(1, decoder->decode(buf, SENSOR_CHAN_MAGN_XYZ, &fit, 1, values));
+	zassert_equal(0, decoder->decode(buf, SENSOR_CHAN_MAGN_XYZ, &fit, 1, values));
+
+	for (int i = 0; i < 3; i++) {
+		int64_t expect_ugauss = magn_percent[i] * INT64_C(500);
+
+		zassert_within(expect_ugauss, sensor_q31_to_micro(values[i], shift), INT64_C(5),
+			       "(%d) expected %" PRIi64 " micro-gauss", i, expect_ugauss);
+	}
+
+	/* Single channels decode to the same values */
+	fit = 0;
+	zassert_equal(1, decoder->decode(buf, SENSOR_CHAN_MAGN_Y, &fit, 1, &values[0]));
+	zassert_within(magn_percent[1] * INT64_C(500), sensor_q31_to_micro(values[0], shift),
+		       INT64_C(5));
+}
+
+ZTEST_F(akm09918c, test_read_fail_no_ready_data)
+{
+	uint8_t buf[32] __aligned(8);
+	uint8_t status = 0;
+
+	akm09918c_emul_set_reg(fixture->target, AKM09918C_REG_ST1, &status, 1);
+	zassert_equal(-EBUSY, sensor_read(&akm09918c_iodev, &akm09918c_rtio, buf, sizeof(buf)));
+}
+#endif /* CONFIG_SENSOR_ASYNC_API */
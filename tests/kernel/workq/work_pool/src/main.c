@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_QUEUES 2
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define POOL_PRIORITY K_PRIO_COOP(1)
+#define REENTRANCY_LOOPS 200
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_QUEUES, STACK_SIZE);
+static struct k_work_q pool_queues[NUM_QUEUES];
+static struct k_work_q_pool pool;
+
+static struct k_work_sync work_sync;
+static struct k_sem block_sem;
+
+/* Work item recording the thread which ran it. */
+struct test_work {
+	struct k_work work;
+	k_tid_t thread;
+	atomic_t count;
+	atomic_t running;
+	bool block;
+};
+
+static struct test_work works[3];
+
+static void test_handler(struct k_work *work)
+{
+	struct test_work *tw = CONTAINER_OF(work, struct test_work, work);
+
+	/* A work item must never run concurrently with itself. */
+	zassert_true(atomic_cas(&tw->running, 0, 1));
+
+	tw->thread = k_current_get();
+	if (tw->block) {
+		(void)k_sem_take(&block_sem, K_FOREVER);
+	}
+	atomic_inc(&tw->count);
+
+	atomic_set(&tw->running, 0);
+}
+
+static void release_cb(struct k_timer *timer)
+{
+	k_sem_give(&block_sem);
+	k_sem_give(&block_sem);
+}
+
+static K_TIMER_DEFINE(release_timer, release_cb, NULL);
+
+static bool is_pool_thread(k_tid_t thread)
+{
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		if (thread == &pool_queues[i].thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Work queued behind a busy queue is run by the idle thread of the pool. */
+ZTEST(work_pool, test_steal)
+{
+	struct k_work_q *queue = &pool_queues[0];
+
+	works[0].block = true;
+	zassert_equal(k_work_submit_to_queue(queue, &works[0].work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&works[0].work), K_WORK_RUNNING);
+	zassert_equal(works[0].thread, &queue->thread);
+
+	zassert_equal(k_work_submit_to_queue(queue, &works[1].work), 1);
+	zassert_true(k_work_flush(&works[1].work, &work_sync));
+
+	zassert_equal(atomic_get(&works[1].count), 1);
+	zassert_equal(works[1].thread, &pool_queues[1].thread);
+	zassert_equal(atomic_get(&works[0].count), 0);
+
+	k_sem_give(&block_sem);
+	zassert_true(k_work_flush(&works[0].work, &work_sync));
+	zassert_equal(atomic_get(&works[0].count), 1);
+}
+
+/* Flushing work which is taken by another thread still waits for it. */
+ZTEST(work_pool, test_flush_stolen)
+{
+	struct k_work_q *queue = &pool_queues[0];
+
+	/* Keep both threads busy. */
+	works[0].block = true;
+	works[1].block = true;
+	zassert_equal(k_work_submit_to_queue(queue, &works[0].work), 1);
+	zassert_equal(k_work_submit_to_queue(queue, &works[1].work), 1);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&works[0].work), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(&works[1].work), K_WORK_RUNNING);
+
+	zassert_equal(k_work_submit_to_queue(queue, &works[2].work), 1);
+	zassert_equal(k_work_busy_get(&works[2].work), K_WORK_QUEUED);
+
+	k_timer_start(&release_timer, K_MSEC(10), K_NO_WAIT);
+	zassert_true(k_work_flush(&works[2].work, &work_sync));
+
+	zassert_equal(atomic_get(&works[2].count), 1);
+	zassert_equal(k_work_busy_get(&works[2].work), 0);
+	zassert_true(is_pool_thread(works[2].thread));
+
+	(void)k_work_flush(&works[0].work, &work_sync);
+	(void)k_work_flush(&works[1].work, &work_sync);
+	zassert_equal(atomic_get(&works[0].count), 1);
+	zassert_equal(atomic_get(&works[1].count), 1);
+}
+
+/* Resubmitting work while it runs never runs it on two threads at once. */
+ZTEST(work_pool, test_reentrancy)
+{
+	uint32_t submitted = 0;
+
+	for (int i = 0; i < REENTRANCY_LOOPS; i++) {
+		for (int j = 0; j < ARRAY_SIZE(works); j++) {
+			if (k_work_submit_to_pool(&pool, &works[j].work) > 0) {
+				submitted++;
+			}
+		}
+		k_busy_wait(10);
+		if ((i % 16) == 0) {
+			k_yield();
+		}
+	}
+
+	for (int j = 0; j < ARRAY_SIZE(works); j++) {
+		(void)k_work_flush(&works[j].work, &work_sync);
+		submitted -= atomic_get(&works[j].count);
+		zassert_equal(k_work_busy_get(&works[j].work), 0);
+	}
+
+	zassert_equal(submitted, 0);
+}
+
+/* Delayable work can be scheduled on a pool queue. */
+static k_tid_t delayed_thread;
+
+static void delayed_handler(struct k_work *work)
+{
+	delayed_thread = k_current_get();
+}
+
+ZTEST(work_pool, test_delayable)
+{
+	static struct k_work_delayable dwork;
+
+	k_work_init_delayable(&dwork, delayed_handler);
+	zassert_equal(k_work_schedule_for_queue(k_work_queue_pool_get(&pool),
+						&dwork, K_MSEC(10)), 1);
+	zassert_true(k_work_flush_delayable(&dwork, &work_sync));
+	zassert_true(is_pool_thread(delayed_thread));
+}
+
+static void *work_pool_setup(void)
+{
+	k_sem_init(&block_sem, 0, NUM_QUEUES);
+	k_work_queue_pool_start(&pool, pool_queues, NUM_QUEUES,
+				&pool_stacks[0][0], STACK_SIZE,
+				POOL_PRIORITY, NULL);
+
+	return NULL;
+}
+
+static void work_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < ARRAY_SIZE(works); i++) {
+		works[i] = (struct test_work){ 0 };
+		k_work_init(&works[i].work, test_handler);
+	}
+	k_sem_reset(&block_sem);
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before, NULL, NULL);
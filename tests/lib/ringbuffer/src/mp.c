@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/ring_buffer_mp.h>
+#include <stdint.h>
+
+#define MP_RINGBUFFER 64
+#define MP_PRODUCERS 3
+
+RING_BUF_MP_DECLARE(mp_ringbuf, MP_RINGBUFFER);
+
+/**
+ * @brief Test that records are read in claim order, once finished
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_mp_claim_order)
+{
+	static atomic_t data[8];
+	struct ring_buf_mp rb;
+	uint8_t *a, *b, *src;
+	uint8_t out[8];
+	uint32_t len;
+	int err;
+
+	ring_buf_mp_init(&rb, ARRAY_SIZE(data), data);
+	zassert_true(ring_buf_mp_is_empty(&rb));
+
+	zassert_equal(ring_buf_mp_put_claim(&rb, &a, 3), 3);
+	zassert_equal(ring_buf_mp_put_claim(&rb, &b, 2), 2);
+	memcpy(a, "abc", 3);
+	memcpy(b, "de", 2);
+
+	/* a is not finished, so b is not visible yet */
+	zassert_equal(ring_buf_mp_put_finish(&rb, b, 2), 0);
+	zassert_equal(ring_buf_mp_get_claim(&rb, &src), 0);
+	zassert_false(ring_buf_mp_is_empty(&rb));
+
+	zassert_equal(ring_buf_mp_put_finish(&rb, a, sizeof(atomic_t) + 1),
+		      -EINVAL);
+	zassert_equal(ring_buf_mp_put_finish(&rb, a, 3), 0);
+
+	len = ring_buf_mp_get_claim(&rb, &src);
+	zassert_equal(len, 3);
+	zassert_mem_equal(src, "abc", 3);
+	zassert_equal(ring_buf_mp_get_finish(&rb), 0);
+	zassert_equal(ring_buf_mp_get_finish(&rb), -EINVAL);
+
+	err = ring_buf_mp_get(&rb, out, 1);
+	zassert_equal(err, -EMSGSIZE);
+	err = ring_buf_mp_get(&rb, out, sizeof(out));
+	zassert_equal(err, 2);
+	zassert_mem_equal(out, "de", 2);
+	zassert_true(ring_buf_mp_is_empty(&rb));
+
+	/* a record committed with no data is dropped */
+	zassert_equal(ring_buf_mp_put_claim(&rb, &a, 1), 1);
+	zassert_equal(ring_buf_mp_put_finish(&rb, a, 0), 0);
+	zassert_equal(ring_buf_mp_get(&rb, out, sizeof(out)), -EAGAIN);
+	zassert_true(ring_buf_mp_is_empty(&rb));
+
+	/* records do not wrap, the end of the buffer is skipped */
+	zassert_equal(ring_buf_mp_put(&rb, "0123456789", 10), 10);
+	zassert_equal(ring_buf_mp_get(&rb, out, sizeof(out)), -EMSGSIZE);
+	zassert_equal(ring_buf_mp_get(&rb, NULL, 0), 10);
+	zassert_true(ring_buf_mp_is_empty(&rb));
+
+	/* too large for the buffer */
+	zassert_equal(ring_buf_mp_put_claim(&rb, &a,
+					    ARRAY_SIZE(data) * sizeof(atomic_t)),
+		      0);
+}
+
+struct mp_record {
+	uint32_t id;
+	uint32_t seq;
+	uint32_t fill[2];
+};
+
+static uint32_t mp_put_seq[MP_PRODUCERS];
+static uint32_t mp_get_seq[MP_PRODUCERS];
+
+static bool mp_produce(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	uint32_t id = (uintptr_t)user_data;
+	struct mp_record *rec;
+	uint8_t *data;
+	uint32_t size;
+
+	/* vary the record size to exercise the padding at the end */
+	size = offsetof(struct mp_record, fill) +
+	       (mp_put_seq[id] % 3) * sizeof(uint32_t);
+
+	if (ring_buf_mp_put_claim(&mp_ringbuf, &data, size) == 0) {
+		return true;
+	}
+
+	rec = (struct mp_record *)data;
+	rec->id = id;
+	rec->seq = mp_put_seq[id]++;
+	for (uint32_t i = 0; i < (size - offsetof(struct mp_record, fill)) / 4;
+	     i++) {
+		rec->fill[i] = rec->seq;
+	}
+
+	zassert_equal(ring_buf_mp_put_finish(&mp_ringbuf, data, size), 0);
+
+	return true;
+}
+
+static bool mp_consume(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	struct mp_record *rec;
+	uint8_t *data;
+	uint32_t len;
+
+	while ((len = ring_buf_mp_get_claim(&mp_ringbuf, &data)) != 0) {
+		rec = (struct mp_record *)data;
+
+		zassert_true(rec->id < MP_PRODUCERS);
+		zassert_equal(rec->seq, mp_get_seq[rec->id],
+			      "producer %u: got %u, exp: %u", rec->id, rec->seq,
+			      mp_get_seq[rec->id]);
+		zassert_equal(len, offsetof(struct mp_record, fill) +
+				   (rec->seq % 3) * sizeof(uint32_t));
+		for (uint32_t i = 0; i < (rec->seq % 3); i++) {
+			zassert_equal(rec->fill[i], rec->seq);
+		}
+		mp_get_seq[rec->id]++;
+
+		zassert_equal(ring_buf_mp_get_finish(&mp_ringbuf), 0);
+	}
+
+	return true;
+}
+
+/* Lock-free API. Test is validating producers in an interrupt and in two
+ * threads, preempting each other and the consumer.
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_mp_stress)
+{
+	k_timeout_t timeout;
+
+	ring_buf_mp_init(&mp_ringbuf, MP_RINGBUFFER,
+			 mp_ringbuf.buffer);
+	memset(mp_put_seq, 0, sizeof(mp_put_seq));
+	memset(mp_get_seq, 0, sizeof(mp_get_seq));
+
+	timeout = (CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) : K_MSEC(10000);
+
+	ztress_set_timeout(timeout);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(mp_produce, (void *)0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mp_produce, (void *)1, 0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mp_produce, (void *)2, 0, 1000, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mp_consume, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+
+	/* drain what was produced after the consumer stopped */
+	mp_consume(NULL, 0, true, 0);
+
+	for (int i = 0; i < MP_PRODUCERS; i++) {
+		zassert_equal(mp_put_seq[i], mp_get_seq[i]);
+		zassert_true(mp_put_seq[i] > 0, "producer %d starved", i);
+	}
+	zassert_true(ring_buf_mp_is_empty(&mp_ringbuf));
+}
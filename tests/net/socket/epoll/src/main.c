@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait takes +10ms from the requested time. */
+#define FUZZ 10
+
+static void epoll_add(int epfd, int fd, uint32_t events)
+{
+	struct zsock_epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	zassert_equal(zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fd, &ev), 0,
+		      "EPOLL_CTL_ADD failed (%d)", errno);
+}
+
+ZTEST(net_socket_epoll, test_epoll_udp)
+{
+	struct zsock_epoll_event events[2];
+	struct zsock_epoll_event ev;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	uint32_t tstamp;
+	char buf[10];
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	/* Registration errors */
+	ev.events = ZSOCK_EPOLLIN;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EPERM, "");
+
+	/* Nothing ready, timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Nothing ready, timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	/* Level triggered: reported until the data is consumed */
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+
+	res = recv(s_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Edge triggered: reported once per arrival */
+	ev.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLET;
+	ev.data.u32 = 1234;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.u32, 1234, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+
+	/* One shot: disabled after the first report until modified */
+	ev.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Removed sockets are not reported */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Closing a registered socket removes it from the instance */
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* A new socket reusing the fd does not inherit the registration */
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	ev.events = ZSOCK_EPOLLIN;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+}
+
+/* Wait until fd is reported with the given events */
+static void epoll_wait_for(int epfd, int fd, uint32_t events)
+{
+	struct zsock_epoll_event ev[3];
+	int64_t end = k_uptime_get() + 500;
+	int res;
+
+	while (k_uptime_get() < end) {
+		res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), 100);
+		zassert_true(res >= 0, "epoll_wait failed (%d)", errno);
+
+		for (int i = 0; i < res; i++) {
+			if (ev[i].data.fd == fd && (ev[i].events & events)) {
+				return;
+			}
+		}
+	}
+
+	zassert_unreachable("fd %d not reported", fd);
+}
+
+ZTEST(net_socket_epoll, test_epoll_tcp)
+{
+	struct zsock_epoll_event events[3];
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	char buf[10];
+	int new_sock;
+	int c_sock;
+	int i;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+	res = listen(s_sock, 0);
+	zassert_equal(res, 0, "");
+
+	epfd = zsock_epoll_create(0);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	/* Pending connections make the listening socket readable */
+	res = connect(c_sock, (const struct sockaddr *)&s_addr,
+		      sizeof(s_addr));
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+
+	new_sock = accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	epoll_add(epfd, new_sock, ZSOCK_EPOLLIN);
+	epoll_add(epfd, c_sock, ZSOCK_EPOLLOUT | ZSOCK_EPOLLET);
+
+	/* Connected socket is writable, reported once */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, c_sock, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLOUT, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Received data is reported on the accepted socket only */
+	res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+
+	res = recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	/* Writable again as soon as the peer opens its window */
+	for (i = 0; i < 100; i++) {
+		res = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), MSG_DONTWAIT);
+		if (res < 0) {
+			break;
+		}
+	}
+	zassert_equal(res, -1, "Send window not filled");
+	zassert_equal(errno, EAGAIN, "");
+
+	for (int left = i * STRLEN(TEST_STR_SMALL); left > 0; left -= res) {
+		res = recv(new_sock, buf, MIN(left, sizeof(buf)), 0);
+		zassert_true(res > 0, "recv failed (%d)", errno);
+	}
+
+	epoll_wait_for(epfd, c_sock, ZSOCK_EPOLLOUT);
+
+	/* Peer close is reported as readable and hung up */
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 500);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN | ZSOCK_EPOLLHUP, "");
+
+	k_msleep(10);
+
+	res = close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/ztest_assert.h>
 #include <fcntl.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_context.h>
 #include <zephyr/net/loopback.h>
 
 #include "../../socket_helpers.h"
@@ -1141,6 +1142,58 @@ ZTEST(net_socket_tcp, test_so_sndbuf)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen;
+	int sock;
+	int rv;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+		ztest_test_skip();
+	}
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	/* The name does not need to be terminated */
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic", 5);
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, sizeof("cubic"), "getsockopt got invalid size");
+	zassert_mem_equal(name, "cubic", sizeof("cubic"),
+			  "getsockopt got invalid name");
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno",
+			sizeof("reno"));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_mem_equal(name, "reno", sizeof("reno"),
+			  "getsockopt got invalid name");
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "vegas", 5);
+	zassert_equal(rv, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno");
+
+	/* Too short to hold the name */
+	optlen = 2;
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, -1, "getsockopt should fail");
+	zassert_equal(errno, EINVAL, "getsockopt got invalid errno");
+
+	test_close(sock);
+
+	zassert_equal(wait_for_n_tcp_contexts(0, TCP_TEARDOWN_TIMEOUT),
+		      0,
+		      "Not all TCP contexts properly cleaned up");
+}
+
 ZTEST(net_socket_tcp, test_v4_so_rcvtimeo)
 {
 	int c_sock;
@@ -1446,6 +1499,171 @@ ZTEST(net_socket_tcp, test_v6_msg_waitall)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_v4_recv_zc)
+{
+	/* Test zero-copy receive on a ipv4 stream socket. */
+	static uint8_t tx_buf[1000];
+	uint8_t rx_buf[sizeof(tx_buf)];
+	struct iovec iov[4];
+	struct zsock_zc_rx rx;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	size_t recved = 0;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	ssize_t ret;
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, tx_buf, sizeof(tx_buf), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	while (recved < sizeof(tx_buf)) {
+		size_t len = 0;
+
+		rx.iov = iov;
+		rx.iovlen = ARRAY_SIZE(iov);
+
+		ret = zsock_recv_zc(new_sock, &rx, 0);
+		zassert_true(ret > 0, "zsock_recv_zc failed (%d)", errno);
+		zassert_true(recved + ret <= sizeof(tx_buf), "too much data");
+		zassert_true(rx.iovlen > 0 && rx.iovlen <= ARRAY_SIZE(iov),
+			     "invalid fragment count");
+
+		for (int i = 0; i < rx.iovlen; i++) {
+			memcpy(&rx_buf[recved + len], iov[i].iov_base,
+			       iov[i].iov_len);
+			len += iov[i].iov_len;
+		}
+
+		zassert_equal(len, ret, "fragments do not add up");
+		zassert_equal(zsock_recv_zc_release(new_sock, &rx), 0,
+			      "zsock_recv_zc_release failed");
+
+		recved += len;
+	}
+
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(tx_buf), "unexpected data");
+
+	/* Nothing left */
+	rx.iov = iov;
+	rx.iovlen = ARRAY_SIZE(iov);
+	ret = zsock_recv_zc(new_sock, &rx, MSG_DONTWAIT);
+	zassert_equal(ret, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "unexpected errno %d", errno);
+
+	test_close(c_sock);
+
+	rx.iov = iov;
+	rx.iovlen = ARRAY_SIZE(iov);
+	ret = zsock_recv_zc(new_sock, &rx, 0);
+	zassert_equal(ret, 0, "EOF not detected");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
+NET_BUF_POOL_DEFINE(zc_tx_pool, 2, 0, 0, NULL);
+
+static K_SEM_DEFINE(zc_tx_done, 0, 1);
+static int zc_tx_status;
+
+static void zc_tx_cb(struct net_context *context,
+		     struct net_context_zc_tx *tx, int status)
+{
+	zc_tx_status = status;
+	k_sem_give(&zc_tx_done);
+}
+
+ZTEST(net_socket_tcp, test_v4_send_zc)
+{
+	/* Test zero-copy send on a ipv4 stream socket. */
+	static uint8_t tx_buf[1000];
+	uint8_t rx_buf[sizeof(tx_buf)];
+	struct net_context_zc_tx tx = { .cb = zc_tx_cb };
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags;
+	size_t recved = 0;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	ssize_t ret;
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	/* Two fragments referencing the caller's memory */
+	frags = net_buf_alloc_with_data(&zc_tx_pool, tx_buf,
+					sizeof(tx_buf) / 2, K_NO_WAIT);
+	zassert_not_null(frags, "cannot allocate buffer");
+	net_buf_frag_add(frags,
+			 net_buf_alloc_with_data(&zc_tx_pool,
+						 &tx_buf[sizeof(tx_buf) / 2],
+						 sizeof(tx_buf) / 2,
+						 K_NO_WAIT));
+	zassert_not_null(frags->frags, "cannot allocate buffer");
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	ret = zsock_send_zc(c_sock, frags, &tx, 0);
+	zassert_equal(ret, sizeof(tx_buf), "zsock_send_zc failed (%d)", errno);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	while (recved < sizeof(tx_buf)) {
+		ret = recv(new_sock, &rx_buf[recved], sizeof(rx_buf) - recved,
+			   0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		recved += ret;
+	}
+
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(tx_buf), "unexpected data");
+
+	/* Completion is reported once the data has been acknowledged */
+	zassert_equal(k_sem_take(&zc_tx_done, K_MSEC(1000)), 0,
+		      "no completion");
+	zassert_equal(zc_tx_status, 0, "unexpected status %d", zc_tx_status);
+
+	/* The stack released both fragments */
+	frags = net_buf_alloc_with_data(&zc_tx_pool, tx_buf, 1, K_NO_WAIT);
+	zassert_not_null(frags, "buffers not released");
+	net_buf_frag_add(frags, net_buf_alloc_with_data(&zc_tx_pool, tx_buf,
+							1, K_NO_WAIT));
+	zassert_not_null(frags->frags, "buffers not released");
+	net_buf_unref(frags);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 #ifdef CONFIG_USERSPACE
 #define CHILD_STACK_SZ		(2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
 struct k_thread child_thread;
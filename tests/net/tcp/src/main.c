@@ -125,6 +125,8 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_server_sack(struct net_pkt *pkt);
+static void handle_server_congestion(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -213,6 +215,17 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Send tcp_options in the SYN of test cases other than 4 */
+static bool syn_options;
+
+/* Window advertised by the peer, 0 keeps the default */
+static uint16_t peer_win;
+
+static bool use_syn_options(uint8_t flags)
+{
+	return (test_case_no == 4U || syn_options) && (flags & SYN);
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -226,7 +239,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (use_syn_options(flags)) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -262,14 +275,14 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (use_syn_options(flags)) {
 		th->th_off = 10U;
 	} else {
 		th->th_off = 5U;
 	}
 
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = peer_win ? htons(peer_win) : NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,7 +294,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (use_syn_options(flags)) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -420,6 +433,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_server_sack(pkt);
+		break;
+	case 11:
+		handle_server_congestion(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1410,8 +1429,8 @@ static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
 	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
-	{ 10, 10, 40, 0}, /* First sequence complete */
+	{ 0,  10, 19, 0}, /* First section complete */
+	{ 19,  1, 40, 0}, /* Gap filled */
 	{ 50,  6, 40, 0},
 	{ 50,  3, 40, 0}, /* Discardable packet */
 	{ 55,  5, 40, 0},
@@ -1539,4 +1558,242 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+#define SACK_SEQ_INIT 1000
+
+static struct sack_check_struct {
+	int seq_offset;
+	int length;
+	int ack_offset;
+	int sack_count;
+	/* Expected SACK blocks, most recently received first */
+	struct {
+		int start;
+		int end;
+	} sack[2];
+} sack_check_list[] = {
+	{ 10, 10, 0, 1, { { 10, 20 } } },
+	{ 30, 10, 0, 2, { { 30, 40 }, { 10, 20 } } },
+	{ 12,  4, 0, 2, { { 10, 20 }, { 30, 40 } } }, /* Duplicate data */
+	{  0, 10, 20, 1, { { 30, 40 } } },
+	{ 20, 10, 40, 0 },
+};
+
+static struct sack_check_struct *sack_check;
+
+static void handle_server_sack(struct net_pkt *pkt)
+{
+	uint8_t opts[40];
+	struct tcphdr th;
+	size_t opts_len;
+	uint8_t *blk = NULL;
+	int sack_count = 0;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	zassert_equal(ret, 0, "Cannot read TCP header");
+
+	zassert_equal(SACK_SEQ_INIT + 1 + sack_check->ack_offset,
+		      ntohl(th.th_ack), "Unexpected ACK %u", ntohl(th.th_ack));
+
+	opts_len = th.th_off * 4 - sizeof(struct tcphdr);
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		     sizeof(struct tcphdr));
+	ret = net_pkt_read(pkt, opts, opts_len);
+	zassert_equal(ret, 0, "Cannot read TCP options");
+
+	for (int i = 0; i < opts_len; i++) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			continue;
+		}
+
+		zassert_equal(opts[i], NET_TCP_SACK_OPT, "Unexpected option %d",
+			      opts[i]);
+
+		sack_count = (opts[i + 1] - 2) / 8;
+		blk = &opts[i + 2];
+		break;
+	}
+
+	zassert_equal(sack_count, sack_check->sack_count,
+		      "Expected %d SACK blocks, got %d",
+		      sack_check->sack_count, sack_count);
+
+	for (int i = 0; i < sack_count; i++) {
+		zassert_equal(sys_get_be32(blk + i * 8),
+			      SACK_SEQ_INIT + 1 + sack_check->sack[i].start,
+			      "Unexpected start of SACK block %d", i);
+		zassert_equal(sys_get_be32(blk + i * 8 + 4),
+			      SACK_SEQ_INIT + 1 + sack_check->sack[i].end,
+			      "Unexpected end of SACK block %d", i);
+	}
+
+	test_sem_give();
+}
+
+ZTEST(net_tcp, test_server_sack)
+{
+	const uint8_t *data = lorem_ipsum + 10;
+	struct net_pkt *pkt;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	/* Offer SACK in the SYN */
+	syn_options = true;
+	ooo_ctx = create_server_socket(SACK_SEQ_INIT, 0);
+	syn_options = false;
+
+	test_case_no = 10;
+
+	for (int i = 0; i < ARRAY_SIZE(sack_check_list); i++) {
+		sack_check = &sack_check_list[i];
+
+		seq = SACK_SEQ_INIT + 1 + sack_check->seq_offset;
+		pkt = prepare_data_packet(AF_INET6, htons(MY_PORT),
+					  htons(PEER_PORT),
+					  &data[sack_check->seq_offset],
+					  sack_check->length);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		ret = net_recv_data(iface, pkt);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+		test_sem_take(K_MSEC(1000), __LINE__);
+	}
+
+	seq = SACK_SEQ_INIT + 1 + sack_check->ack_offset;
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ooo_ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define CC_SEQ_INIT 2000
+#define CC_DATA_LEN 400
+
+static void handle_server_congestion(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 th->th_off * 4U;
+
+	/* Only data segments are of interest */
+	if (net_pkt_get_len(pkt) > hdr_len) {
+		test_sem_give();
+	}
+}
+
+static void send_cc_ack(struct tcp *conn, uint32_t ack_value)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = conn->ack;
+	ack = ack_value;
+	pkt = prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+}
+
+ZTEST(net_tcp, test_server_congestion)
+{
+	struct net_pkt *pkt;
+	struct tcp *conn;
+	uint32_t ssthresh;
+	uint32_t cwnd;
+	uint16_t mss;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	syn_options = true;
+	peer_win = NET_IPV6_MTU;
+	ooo_ctx = create_server_socket(CC_SEQ_INIT, 0);
+	syn_options = false;
+
+	test_case_no = 11;
+	conn = accepted_ctx->tcp;
+	mss = conn_mss(conn);
+
+	/* Initial window (RFC 6928) */
+	cwnd = MIN(10U * mss, MAX(2U * mss, 14600U));
+	zassert_equal(conn->cwnd, cwnd, "Unexpected initial cwnd %u",
+		      conn->cwnd);
+
+	/* Slow start grows the window by the acknowledged data */
+	ret = net_context_send(accepted_ctx, lorem_ipsum, 100, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 100, "Failed to send data (%d)", ret);
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	send_cc_ack(conn, conn->seq + 100);
+	zassert_equal(conn->unacked_len, 0, "Data not acknowledged");
+	zassert_equal(conn->cwnd, cwnd + 100, "Unexpected cwnd %u after ACK",
+		      conn->cwnd);
+
+	/* Three duplicate ACKs halve the window and resend the head */
+	ret = net_context_send(accepted_ctx, lorem_ipsum, CC_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, CC_DATA_LEN, "Failed to send data (%d)", ret);
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ssthresh = MAX(CC_DATA_LEN / 2U, 2U * mss);
+
+	for (int i = 0; i < 3; i++) {
+		send_cc_ack(conn, conn->seq);
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_true(conn->in_recovery, "Not in fast recovery");
+	zassert_equal(conn->ssthresh, ssthresh, "Unexpected ssthresh %u",
+		      conn->ssthresh);
+	zassert_equal(conn->cwnd, ssthresh + 3U * mss,
+		      "Unexpected cwnd %u in fast recovery", conn->cwnd);
+
+	/* Every further duplicate ACK inflates the window */
+	send_cc_ack(conn, conn->seq);
+	zassert_equal(conn->cwnd, ssthresh + 4U * mss,
+		      "Unexpected cwnd %u on extra duplicate ACK", conn->cwnd);
+
+	/* The retransmission timeout falls back to one segment */
+	k_sem_reset(&test_sem);
+	test_sem_take(K_MSEC(1000), __LINE__);
+	zassert_false(conn->in_recovery, "Still in fast recovery");
+	zassert_equal(conn->cwnd, mss, "Unexpected cwnd %u after RTO",
+		      conn->cwnd);
+
+	peer_win = 0;
+	seq = conn->ack;
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ooo_ctx);
+	net_context_put(accepted_ctx);
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/storage/disk_cache.h>
+
+#define DISK_NAME "CACHE"
+#define NO_IOCTL_DISK_NAME "NOIOCTL"
+#define SECTOR_SIZE 512
+#define SECTOR_COUNT 64
+#define CACHE_SECTORS 8
+
+static uint8_t disk_data[SECTOR_COUNT * SECTOR_SIZE];
+static uint32_t device_reads;
+static uint32_t device_writes;
+
+static int test_disk_init(struct disk_info *disk)
+{
+	return 0;
+}
+
+static int test_disk_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int test_disk_read(struct disk_info *disk, uint8_t *buf,
+			  uint32_t start, uint32_t num)
+{
+	if (start + num > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	device_reads++;
+	memcpy(buf, &disk_data[start * SECTOR_SIZE], num * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int test_disk_write(struct disk_info *disk, const uint8_t *buf,
+			   uint32_t start, uint32_t num)
+{
+	if (start + num > SECTOR_COUNT) {
+		return -EIO;
+	}
+
+	device_writes++;
+	memcpy(&disk_data[start * SECTOR_SIZE], buf, num * SECTOR_SIZE);
+
+	return 0;
+}
+
+static int test_disk_ioctl(struct disk_info *disk, uint8_t cmd, void *buf)
+{
+	switch (cmd) {
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buf = SECTOR_COUNT;
+		return 0;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buf = SECTOR_SIZE;
+		return 0;
+	case DISK_IOCTL_CTRL_SYNC:
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static const struct disk_operations test_disk_ops = {
+	.init = test_disk_init,
+	.status = test_disk_status,
+	.read = test_disk_read,
+	.write = test_disk_write,
+	.ioctl = test_disk_ioctl,
+};
+
+static struct disk_info test_disk = {
+	.name = DISK_NAME,
+	.ops = &test_disk_ops,
+};
+
+static const struct disk_operations no_ioctl_disk_ops = {
+	.init = test_disk_init,
+	.status = test_disk_status,
+	.read = test_disk_read,
+	.write = test_disk_write,
+};
+
+static struct disk_info no_ioctl_disk = {
+	.name = NO_IOCTL_DISK_NAME,
+	.ops = &no_ioctl_disk_ops,
+};
+
+DISK_CACHE_DEFINE(test_cache, CACHE_SECTORS, SECTOR_SIZE);
+
+static uint8_t buf[CACHE_SECTORS * SECTOR_SIZE];
+
+static void fill_sector(uint8_t *sector, uint32_t num, uint8_t seed)
+{
+	for (int i = 0; i < SECTOR_SIZE; i++) {
+		sector[i] = (uint8_t)(num + i + seed);
+	}
+}
+
+static void check_sector(const uint8_t *sector, uint32_t num, uint8_t seed)
+{
+	for (int i = 0; i < SECTOR_SIZE; i++) {
+		zassert_equal(sector[i], (uint8_t)(num + i + seed),
+			      "Sector %u differs at %d", num, i);
+	}
+}
+
+static void attach(uint16_t read_ahead, bool write_back)
+{
+	const struct disk_cache_config cfg = {
+		.read_ahead = read_ahead,
+		.write_back = write_back,
+	};
+
+	zassert_ok(disk_cache_attach(DISK_NAME, &test_cache, &cfg));
+	device_reads = 0;
+	device_writes = 0;
+}
+
+static void *disk_cache_setup(void)
+{
+	zassert_ok(disk_access_register(&test_disk));
+	zassert_ok(disk_access_init(DISK_NAME));
+	zassert_ok(disk_access_register(&no_ioctl_disk));
+	zassert_ok(disk_access_init(NO_IOCTL_DISK_NAME));
+
+	return NULL;
+}
+
+static void disk_cache_before(void *f)
+{
+	for (uint32_t i = 0; i < SECTOR_COUNT; i++) {
+		fill_sector(&disk_data[i * SECTOR_SIZE], i, 0);
+	}
+}
+
+static void disk_cache_after(void *f)
+{
+	(void)disk_cache_detach(DISK_NAME);
+	(void)disk_cache_detach(NO_IOCTL_DISK_NAME);
+}
+
+ZTEST_SUITE(disk_cache, NULL, disk_cache_setup, disk_cache_before, disk_cache_after, NULL);
+
+/**
+ * @brief Sequential single sector reads are read ahead in one transaction
+ */
+ZTEST(disk_cache, test_read_ahead)
+{
+	struct disk_cache_stats stats;
+
+	attach(3, false);
+
+	for (uint32_t i = 0; i < 16; i++) {
+		zassert_ok(disk_access_read(DISK_NAME, buf, i, 1));
+		check_sector(buf, i, 0);
+	}
+
+	/* Sector 0, then 4 sectors per miss: 1-4, 5-8, 9-12, 13-16 */
+	zassert_equal(device_reads, 5, "Unexpected device reads %u", device_reads);
+
+	/* The most recent sectors are still cached */
+	zassert_ok(disk_access_read(DISK_NAME, buf, 13, 3));
+	for (uint32_t i = 0; i < 3; i++) {
+		check_sector(&buf[i * SECTOR_SIZE], 13 + i, 0);
+	}
+	zassert_equal(device_reads, 5, "Unexpected device reads %u", device_reads);
+
+	zassert_ok(disk_cache_stats_get(DISK_NAME, &stats));
+	zassert_equal(stats.device_reads, 5);
+	zassert_equal(stats.hits + stats.misses, 19);
+	zassert_equal(stats.misses, 5);
+}
+
+/**
+ * @brief Random reads do not read ahead
+ */
+ZTEST(disk_cache, test_read_no_read_ahead)
+{
+	attach(3, false);
+
+	zassert_ok(disk_access_read(DISK_NAME, buf, 20, 1));
+	zassert_ok(disk_access_read(DISK_NAME, buf, 10, 1));
+	check_sector(buf, 10, 0);
+	zassert_ok(disk_access_read(DISK_NAME, buf, 12, 1));
+	check_sector(buf, 12, 0);
+	zassert_equal(device_reads, 3, "Unexpected device reads %u", device_reads);
+
+	/* Large reads go to the device in one transaction */
+	zassert_ok(disk_access_read(DISK_NAME, buf, 30, CACHE_SECTORS));
+	for (uint32_t i = 0; i < CACHE_SECTORS; i++) {
+		check_sector(&buf[i * SECTOR_SIZE], 30 + i, 0);
+	}
+	zassert_equal(device_reads, 4, "Unexpected device reads %u", device_reads);
+}
+
+/**
+ * @brief Written sectors are kept until synced with write-back
+ */
+ZTEST(disk_cache, test_write_back)
+{
+	for (uint32_t i = 0; i < 2; i++) {
+		fill_sector(&buf[i * SECTOR_SIZE], 2 + i, 1);
+	}
+
+	attach(0, true);
+
+	zassert_ok(disk_access_write(DISK_NAME, buf, 2, 2));
+	zassert_equal(device_writes, 0, "Unexpected device writes %u", device_writes);
+	check_sector(&disk_data[2 * SECTOR_SIZE], 2, 0);
+
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(disk_access_read(DISK_NAME, buf, 2, 2));
+	check_sector(buf, 2, 1);
+	check_sector(&buf[SECTOR_SIZE], 3, 1);
+	zassert_equal(device_reads, 0, "Unexpected device reads %u", device_reads);
+
+	/* Reads bypassing the cache see the dirty sectors */
+	zassert_ok(disk_access_read(DISK_NAME, buf, 0, CACHE_SECTORS));
+	check_sector(&buf[2 * SECTOR_SIZE], 2, 1);
+	check_sector(&buf[4 * SECTOR_SIZE], 4, 0);
+
+	zassert_ok(disk_access_ioctl(DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_equal(device_writes, 1, "Unexpected device writes %u", device_writes);
+	check_sector(&disk_data[2 * SECTOR_SIZE], 2, 1);
+	check_sector(&disk_data[3 * SECTOR_SIZE], 3, 1);
+
+	/* Nothing left to write */
+	zassert_ok(disk_access_ioctl(DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_equal(device_writes, 1, "Unexpected device writes %u", device_writes);
+}
+
+/**
+ * @brief Dirty sectors are written back when evicted and on detach
+ */
+ZTEST(disk_cache, test_write_back_evict)
+{
+	attach(0, true);
+
+	for (uint32_t i = 0; i <= CACHE_SECTORS; i++) {
+		fill_sector(buf, 2 * i, 2);
+		zassert_ok(disk_access_write(DISK_NAME, buf, 2 * i, 1));
+	}
+
+	/* The least recently written sector made room for the last one */
+	zassert_equal(device_writes, 1, "Unexpected device writes %u", device_writes);
+	check_sector(&disk_data[0], 0, 2);
+	check_sector(&disk_data[2 * SECTOR_SIZE], 2, 0);
+
+	zassert_ok(disk_cache_detach(DISK_NAME));
+	zassert_equal(device_writes, 1 + CACHE_SECTORS, "Unexpected device writes %u",
+		      device_writes);
+	for (uint32_t i = 0; i <= CACHE_SECTORS; i++) {
+		check_sector(&disk_data[2 * i * SECTOR_SIZE], 2 * i, 2);
+	}
+}
+
+/**
+ * @brief Writes go through with write-back disabled, updating cached sectors
+ */
+ZTEST(disk_cache, test_write_through)
+{
+	attach(0, false);
+
+	zassert_ok(disk_access_read(DISK_NAME, buf, 5, 1));
+	fill_sector(buf, 5, 3);
+	zassert_ok(disk_access_write(DISK_NAME, buf, 5, 1));
+	zassert_equal(device_writes, 1, "Unexpected device writes %u", device_writes);
+	check_sector(&disk_data[5 * SECTOR_SIZE], 5, 3);
+
+	memset(buf, 0, SECTOR_SIZE);
+	zassert_ok(disk_access_read(DISK_NAME, buf, 5, 1));
+	check_sector(buf, 5, 3);
+	zassert_equal(device_reads, 1, "Unexpected device reads %u", device_reads);
+}
+
+/**
+ * @brief The cache is flushed on sync for disks without an ioctl operation
+ */
+ZTEST(disk_cache, test_write_back_no_ioctl)
+{
+	const struct disk_cache_config cfg = {
+		.read_ahead = 3,
+		.write_back = true,
+	};
+
+	zassert_ok(disk_cache_attach(NO_IOCTL_DISK_NAME, &test_cache, &cfg));
+	device_reads = 0;
+	device_writes = 0;
+
+	fill_sector(buf, 6, 4);
+	zassert_ok(disk_access_write(NO_IOCTL_DISK_NAME, buf, 6, 1));
+	zassert_equal(device_writes, 0, "Unexpected device writes %u", device_writes);
+
+	zassert_ok(disk_access_ioctl(NO_IOCTL_DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL));
+	zassert_equal(device_writes, 1, "Unexpected device writes %u", device_writes);
+	check_sector(&disk_data[6 * SECTOR_SIZE], 6, 4);
+
+	/* Nothing is read ahead without the sector count */
+	zassert_ok(disk_access_read(NO_IOCTL_DISK_NAME, buf, 62, 1));
+	zassert_ok(disk_access_read(NO_IOCTL_DISK_NAME, buf, 63, 1));
+	check_sector(buf, 63, 0);
+	zassert_equal(device_reads, 2, "Unexpected device reads %u", device_reads);
+}
+
+ZTEST(disk_cache, test_attach_invalid)
+{
+	DISK_CACHE_DEFINE(small_cache, 2, SECTOR_SIZE / 2);
+	const struct disk_cache_config cfg = { 0 };
+
+	zassert_equal(disk_cache_attach(DISK_NAME, &small_cache, &cfg), -EINVAL);
+	zassert_equal(disk_cache_attach("NONE", &test_cache, &cfg), -EINVAL);
+	zassert_equal(disk_cache_detach(DISK_NAME), -EINVAL);
+
+	zassert_ok(disk_cache_attach(DISK_NAME, &test_cache, &cfg));
+	zassert_equal(disk_cache_attach(DISK_NAME, &test_cache, &cfg), -EINVAL);
+}
@@ -869,3 +869,353 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+static size_t num_index_entries_in_sector(uint32_t sector, struct nvs_fs *fs)
+{
+	size_t i, num = 0;
+
+	for (i = 0; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		if (fs->lookup_index_addr[i] != NVS_LOOKUP_CACHE_NO_ADDR &&
+		    (fs->lookup_index_addr[i] >> ADDR_SECT_SHIFT) == sector) {
+			num++;
+		}
+	}
+
+	return num;
+}
+#endif
+
+/*
+ * Test that all NVS IDs can be read, deleted and found again after a restart,
+ * including when there are more IDs than NVS lookup index entries.
+ */
+ZTEST_F(nvs, test_nvs_index_overflow)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+	const uint16_t num_ids = CONFIG_NVS_LOOKUP_INDEX_SIZE + 8;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	for (id = 0; id < CONFIG_NVS_LOOKUP_INDEX_SIZE; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+	zassert_false(fixture->fs.lookup_index_full, "index full too early");
+
+	for (; id < num_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+	zassert_true(fixture->fs.lookup_index_full, "index not full");
+
+	err = nvs_delete(&fixture->fs, 3);
+	zassert_equal(err, 0, "nvs_delete call failure: %d", err);
+	err = nvs_delete(&fixture->fs, num_ids - 1);
+	zassert_equal(err, 0, "nvs_delete call failure: %d", err);
+
+	for (int mount = 0; mount < 2; mount++) {
+		for (id = 0; id < num_ids; id++) {
+			err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+			if (id == 3 || id == num_ids - 1) {
+				zassert_equal(err, -ENOENT, "deleted id %u found", id);
+				continue;
+			}
+			zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+			zassert_equal(data, id, "incorrect data read");
+		}
+
+		err = nvs_read(&fixture->fs, num_ids, &data, sizeof(data));
+		zassert_equal(err, -ENOENT, "unknown id found");
+
+		memset(fixture->fs.lookup_index_addr, 0xAA, sizeof(fixture->fs.lookup_index_addr));
+		err = nvs_mount(&fixture->fs);
+		zassert_true(err == 0, "nvs_init call failure: %d", err);
+	}
+#endif
+}
+
+/*
+ * Test that NVS lookup index follows the entries moved by gc and does not
+ * contain any address from the gc-ed sector.
+ */
+ZTEST_F(nvs, test_nvs_index_gc)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t data = 0;
+	uint16_t data_read;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_init call failure: %d", err);
+
+	err = nvs_write(&fixture->fs, 3, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 2,
+		      "invalid index content after filling sector 0");
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Sector 0 has been gc-ed, IDs 1 and 3 were moved to sector 2 */
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 0,
+		      "not invalidated index entries after gc");
+	zassert_equal(num_index_entries_in_sector(2, &fixture->fs), 3,
+		      "invalid index content after gc");
+
+	err = nvs_read(&fixture->fs, 3, &data_read, sizeof(data_read));
+	zassert_equal(err, sizeof(data_read), "nvs_read call failure: %d", err);
+	zassert_equal(data_read, 0, "incorrect data read");
+#endif
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+static int gc_step_until_done(struct nvs_fs *fs)
+{
+	int err;
+
+	do {
+		err = nvs_gc_step(fs);
+	} while (err == 0);
+
+	return err;
+}
+#endif
+
+/*
+ * Test that with incremental gc no write has to erase a sector, and record
+ * the distribution of the write latency.
+ */
+ZTEST_F(nvs, test_nvs_gc_step_latency)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	ssize_t len;
+	uint8_t buf[32];
+	uint32_t *flash_erase_stat;
+	uint32_t erase_calls, start, us;
+	uint32_t max_us = 0U, step_erases = 0U;
+	uint32_t histogram[16] = { 0 };
+	const uint16_t max_id = 10;
+	const uint16_t max_writes = 500;
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (uint16_t i = 0; i < max_writes; i++) {
+		uint8_t id = (i % max_id);
+		uint8_t id_data = id + max_id * (i / max_id);
+
+		erase_calls = *flash_erase_stat;
+		err = gc_step_until_done(&fixture->fs);
+		zassert_equal(err, -EALREADY, "nvs_gc_step call failure: %d", err);
+		step_erases += *flash_erase_stat - erase_calls;
+
+		memset(buf, id_data, sizeof(buf));
+
+		erase_calls = *flash_erase_stat;
+		start = k_cycle_get_32();
+		len = nvs_write(&fixture->fs, id, buf, sizeof(buf));
+		us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+		zassert_equal(*flash_erase_stat, erase_calls,
+			      "write %u erased a sector", i);
+
+		max_us = MAX(max_us, us);
+		histogram[MIN(LOG2CEIL(us), ARRAY_SIZE(histogram) - 1)]++;
+	}
+
+	zassert_true(step_erases > 0, "no sector erased ahead");
+
+	TC_PRINT("write latency, max %u us\n", max_us);
+	for (int i = 0; i < ARRAY_SIZE(histogram); i++) {
+		if (histogram[i]) {
+			TC_PRINT("  <= %6u us: %u\n", 1U << i, histogram[i]);
+		}
+	}
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	check_content(max_id, &fixture->fs);
+#endif
+}
+
+/*
+ * Test that an incremental gc interrupted by a restart is resumed and keeps
+ * all the entries.
+ */
+ZTEST_F(nvs, test_nvs_gc_step_remount)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	uint32_t *flash_erase_stat;
+	uint32_t erase_calls;
+	const uint16_t max_id = 10;
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	fixture->fs.sector_count = 4;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Write until sector 0 is the oldest sector, the sector before the
+	 * write sector is never erased ahead.
+	 */
+	for (uint16_t i = 0; (fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2; i++) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+	}
+
+	erase_calls = *flash_erase_stat;
+
+	for (int i = 0; i < 3; i++) {
+		err = nvs_gc_step(&fixture->fs);
+		zassert_equal(err, 0, "nvs_gc_step call failure: %d", err);
+	}
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	check_content(max_id, &fixture->fs);
+
+	err = gc_step_until_done(&fixture->fs);
+	zassert_equal(err, -EALREADY, "nvs_gc_step call failure: %d", err);
+	zassert_equal(*flash_erase_stat, erase_calls + 1, "sector 0 not erased ahead");
+
+	check_content(max_id, &fixture->fs);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	check_content(max_id, &fixture->fs);
+#endif
+}
+
+/*
+ * Test that the background gc completes the reserve of erased sectors.
+ */
+ZTEST_F(nvs, test_nvs_gc_background)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	const uint16_t max_id = 10;
+	const uint16_t batch = 20;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (uint16_t i = 0; i < 10 * batch; i += batch) {
+		write_content(max_id, i, i + batch, &fixture->fs);
+
+		k_sleep(K_MSEC(100));
+
+		err = nvs_gc_step(&fixture->fs);
+		zassert_equal(err, -EALREADY, "background gc not done: %d", err);
+	}
+
+	check_content(max_id, &fixture->fs);
+#endif
+}
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+#define GC_READER_STACK_SIZE 1024
+
+static K_THREAD_STACK_DEFINE(gc_reader_stack, GC_READER_STACK_SIZE);
+static struct k_thread gc_reader_thread;
+static atomic_t gc_reader_stop;
+static atomic_t gc_reader_errors;
+
+/* Keeps reading every id while the writes and the background gc move the entries */
+static void gc_reader(void *p1, void *p2, void *p3)
+{
+	struct nvs_fs *fs = p1;
+	uint16_t max_id = POINTER_TO_UINT(p2);
+	uint8_t rd_buf[32];
+	ssize_t len;
+
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&gc_reader_stop)) {
+		for (uint16_t id = 0; id < max_id; id++) {
+			len = nvs_read(fs, id, rd_buf, sizeof(rd_buf));
+			if (len != sizeof(rd_buf)) {
+				atomic_inc(&gc_reader_errors);
+				continue;
+			}
+
+			for (uint16_t i = 0; i < ARRAY_SIZE(rd_buf); i++) {
+				if ((rd_buf[i] != rd_buf[0]) || (rd_buf[i] % max_id != id)) {
+					atomic_inc(&gc_reader_errors);
+					break;
+				}
+			}
+		}
+
+		k_msleep(1);
+	}
+}
+#endif
+
+/*
+ * Test that reads and writes running concurrently with the background gc
+ * always find the latest entries.
+ */
+ZTEST_F(nvs, test_nvs_gc_background_concurrent)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	const uint16_t max_id = 10;
+	const uint16_t batch = 20;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	write_content(max_id, 0, max_id, &fixture->fs);
+
+	atomic_set(&gc_reader_stop, 0);
+	atomic_set(&gc_reader_errors, 0);
+
+	/* preempts the background gc in the middle of its steps */
+	k_thread_create(&gc_reader_thread, gc_reader_stack,
+			K_THREAD_STACK_SIZEOF(gc_reader_stack), gc_reader,
+			&fixture->fs, UINT_TO_POINTER(max_id), NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO - 1, 0, K_NO_WAIT);
+
+	for (uint16_t i = max_id; i < 10 * batch; i += batch) {
+		write_content(max_id, i, i + batch, &fixture->fs);
+
+		k_sleep(K_MSEC(20));
+	}
+
+	atomic_set(&gc_reader_stop, 1);
+	err = k_thread_join(&gc_reader_thread, K_FOREVER);
+	zassert_equal(err, 0, "reader thread join failure: %d", err);
+
+	zassert_equal(atomic_get(&gc_reader_errors), 0, "%d inconsistent reads",
+		      (int)atomic_get(&gc_reader_errors));
+
+	check_content(max_id, &fixture->fs);
+#endif
+}
@@ -103,6 +103,20 @@ static void validate(int ctx_cnt)
 			"dropped:%u missing:%u",
 			mock_backend.dropped, mock_backend.missing);
 	zassert_equal(in_cnt, out_cnt);
+
+	if (IS_ENABLED(CONFIG_LOG_BUFFER_STATS)) {
+		struct log_buffer_stats stats;
+		uint64_t allocated = 0;
+		uint64_t dropped = 0;
+
+		for (uint32_t cpu = 0; log_buffer_stats_get(cpu, &stats) == 0; cpu++) {
+			allocated += stats.allocated;
+			dropped += stats.dropped;
+		}
+
+		zassert_true(allocated >= in_cnt - mock_backend.dropped);
+		zassert_true(dropped >= mock_backend.dropped);
+	}
 }
 
 static bool context_handler(void *user_data, uint32_t cnt, bool last, int prio)
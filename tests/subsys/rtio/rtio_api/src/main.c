@@ -422,6 +422,315 @@ ZTEST(rtio_api, test_rtio_multiple_chains)
 }
 
 
+#define MEMPOOL_BLOCK_SIZE 16
+#define MEMPOOL_BLOCK_COUNT 4
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(mempool_exec_simp);
+RTIO_DEFINE_WITH_MEMPOOL(r_mempool_simp, (struct rtio_executor *)&mempool_exec_simp, 4, 4,
+			 MEMPOOL_BLOCK_COUNT, MEMPOOL_BLOCK_SIZE, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(mempool_exec_con, 1);
+RTIO_DEFINE_WITH_MEMPOOL(r_mempool_con, (struct rtio_executor *)&mempool_exec_con, 4, 4,
+			 MEMPOOL_BLOCK_COUNT, MEMPOOL_BLOCK_SIZE, 4);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_mempool, 1);
+
+static void mempool_submit_reads(struct rtio *r, const struct rtio_iodev *iodev,
+				 const uint32_t *lens, uint32_t count)
+{
+	struct rtio_sqe *sqe;
+
+	for (uint32_t i = 0; i < count; i++) {
+		sqe = rtio_spsc_acquire(r->sq);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_read_with_pool(sqe, iodev, RTIO_PRIO_NORM,
+					     lens[i], (void *)(uintptr_t)i);
+		rtio_spsc_produce(r->sq);
+	}
+
+	zassert_ok(rtio_submit(r, count), "Should return ok from rtio_submit");
+}
+
+/**
+ * @brief Test reads with buffers from the memory pool of the context
+ *
+ * Ensures buffers are handed over with the completions, that reads fail once
+ * the pool is exhausted and succeed again once buffers are released.
+ */
+void test_rtio_mempool_(struct rtio *r)
+{
+	static const uint32_t lens[] = {20, MEMPOOL_BLOCK_SIZE};
+	static const uint32_t full_len = MEMPOOL_BLOCK_COUNT * MEMPOOL_BLOCK_SIZE;
+	struct rtio_cqe *cqe;
+	uint8_t *bufs[ARRAY_SIZE(lens)];
+	uint32_t buf_lens[ARRAY_SIZE(lens)];
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	rtio_iodev_test_init(&iodev_test_mempool);
+
+	TC_PRINT("reading into 3 of the %d blocks\n", MEMPOOL_BLOCK_COUNT);
+	mempool_submit_reads(r, &iodev_test_mempool, lens, ARRAY_SIZE(lens));
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, (void *)(uintptr_t)i,
+				  "Expected in order completions");
+		zassert_ok(rtio_cqe_get_mempool_buffer(r, cqe, &bufs[i], &buf_lens[i]),
+			   "Expected a memory pool buffer");
+		rtio_spsc_release(r->cq);
+
+		zassert_equal(buf_lens[i], ROUND_UP(lens[i], MEMPOOL_BLOCK_SIZE),
+			      "Unexpected buffer length %u", buf_lens[i]);
+		for (uint32_t j = 0; j < lens[i]; j++) {
+			zassert_equal(bufs[i][j], (uint8_t)j, "Unexpected data");
+		}
+	}
+	zassert_true(bufs[0] + buf_lens[0] <= bufs[1] || bufs[1] + buf_lens[1] <= bufs[0],
+		     "Buffers should not overlap");
+
+	TC_PRINT("reading more than the free blocks\n");
+	mempool_submit_reads(r, &iodev_test_mempool, &full_len, 1);
+	cqe = rtio_spsc_consume(r->cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_equal(cqe->result, -ENOMEM, "Expected the pool to be exhausted");
+	zassert_equal(rtio_cqe_get_mempool_buffer(r, cqe, &buf, &buf_len), -EINVAL,
+		      "Failed reads hold no buffer");
+	rtio_spsc_release(r->cq);
+
+	TC_PRINT("reading the whole pool once released\n");
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		rtio_release_buffer(r, bufs[i], buf_lens[i]);
+	}
+	mempool_submit_reads(r, &iodev_test_mempool, &full_len, 1);
+	cqe = rtio_spsc_consume(r->cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_ok(cqe->result, "Result should be ok");
+	zassert_ok(rtio_cqe_get_mempool_buffer(r, cqe, &buf, &buf_len),
+		   "Expected a memory pool buffer");
+	zassert_equal(buf_len, full_len, "Unexpected buffer length %u", buf_len);
+	rtio_spsc_release(r->cq);
+	rtio_release_buffer(r, buf, buf_len);
+}
+
+ZTEST(rtio_api, test_rtio_mempool)
+{
+	TC_PRINT("rtio mempool simple\n");
+	test_rtio_mempool_(&r_mempool_simp);
+	TC_PRINT("rtio mempool concurrent\n");
+	test_rtio_mempool_(&r_mempool_con);
+}
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(multishot_exec_simp);
+RTIO_DEFINE_WITH_MEMPOOL(r_multishot_simp, (struct rtio_executor *)&multishot_exec_simp, 4, 4,
+			 MEMPOOL_BLOCK_COUNT, MEMPOOL_BLOCK_SIZE, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(multishot_exec_con, 1);
+RTIO_DEFINE_WITH_MEMPOOL(r_multishot_con, (struct rtio_executor *)&multishot_exec_con, 4, 4,
+			 MEMPOOL_BLOCK_COUNT, MEMPOOL_BLOCK_SIZE, 4);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_multishot, 1);
+
+/**
+ * @brief Test multishot reads and cancellation
+ *
+ * Ensures a multishot read completes once per event until cancelled, with a
+ * new buffer each time, and that cancelled submissions complete with
+ * -ECANCELED.
+ */
+void test_rtio_multishot_(struct rtio *r)
+{
+	uintptr_t userdata[2] = {0, 1};
+	struct rtio_sqe foreign_sqe = {0};
+	struct rtio_sqe *sqe, *multishot;
+	struct rtio_cqe *cqe;
+	uint8_t *buf, *prev_buf = NULL;
+	uint32_t buf_len;
+	uint32_t full_len = MEMPOOL_BLOCK_COUNT * MEMPOOL_BLOCK_SIZE;
+	int count = 0;
+
+	rtio_iodev_test_init(&iodev_test_multishot);
+
+	TC_PRINT("cancelling before submission\n");
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_multishot, &userdata[0]);
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, &iodev_test_multishot, &userdata[1]);
+	zassert_ok(rtio_sqe_cancel(r, sqe), "Cancel should succeed");
+	zassert_ok(rtio_submit(r, 2), "Should return ok from rtio_submit");
+
+	for (int i = 0; i < 2; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_equal_ptr(cqe->userdata, &userdata[i], "Expected in order completions");
+		zassert_equal(cqe->result, i == 0 ? 0 : -ECANCELED, "Unexpected result %d",
+			      cqe->result);
+		rtio_spsc_release(r->cq);
+	}
+
+	TC_PRINT("reading events until cancelled\n");
+	multishot = rtio_spsc_acquire(r->sq);
+	zassert_not_null(multishot, "Expected a valid sqe");
+	rtio_sqe_prep_read_multishot(multishot, &iodev_test_multishot, RTIO_PRIO_NORM,
+				     MEMPOOL_BLOCK_SIZE, &userdata[0]);
+	zassert_ok(rtio_submit(r, 3), "Should return ok from rtio_submit");
+
+	/* The iodev drops the read in flight, no further event is waited for */
+	zassert_ok(rtio_sqe_cancel(r, multishot), "Cancel should succeed");
+	zassert_true(rtio_spsc_consumable(r->cq) > 0, "Expected the cancellation to complete");
+
+	do {
+		cqe = rtio_cqe_consume_block(r);
+		zassert_equal_ptr(cqe->userdata, &userdata[0], "Unexpected userdata");
+		if (cqe->result == 0) {
+			zassert_ok(rtio_cqe_get_mempool_buffer(r, cqe, &buf, &buf_len),
+				   "Expected a memory pool buffer");
+			zassert_not_equal(buf, prev_buf, "Expected a new buffer per event");
+			for (uint32_t j = 0; j < buf_len; j++) {
+				zassert_equal(buf[j], (uint8_t)j, "Unexpected data");
+			}
+			if (prev_buf != NULL) {
+				rtio_release_buffer(r, prev_buf, buf_len);
+			}
+			prev_buf = buf;
+			count++;
+		} else {
+			zassert_equal(cqe->result, -ECANCELED, "Unexpected result %d",
+				      cqe->result);
+		}
+		rtio_spsc_release(r->cq);
+	} while (cqe->result == 0);
+
+	rtio_release_buffer(r, prev_buf, MEMPOOL_BLOCK_SIZE);
+	zassert_true(count >= 3, "Expected at least 3 events, got %d", count);
+
+	TC_PRINT("checking nothing follows the cancellation\n");
+	k_sleep(K_MSEC(50));
+	zassert_equal(rtio_spsc_consumable(r->cq), 0, "Expected no more completions");
+
+	/* Released or foreign submissions can't be cancelled */
+	zassert_equal(rtio_sqe_cancel(r, multishot), -EINVAL, "Expected a released sqe");
+	zassert_equal(rtio_sqe_cancel(r, &foreign_sqe), -EINVAL, "Expected a foreign sqe");
+
+	/* The executor moves on, with all the blocks free */
+	mempool_submit_reads(r, &iodev_test_multishot, &full_len, 1);
+	cqe = rtio_spsc_consume(r->cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_ok(cqe->result, "Result should be ok");
+	zassert_ok(rtio_cqe_get_mempool_buffer(r, cqe, &buf, &buf_len),
+		   "Expected a memory pool buffer");
+	rtio_spsc_release(r->cq);
+	rtio_release_buffer(r, buf, buf_len);
+}
+
+ZTEST(rtio_api, test_rtio_multishot)
+{
+	TC_PRINT("rtio multishot simple\n");
+	test_rtio_multishot_(&r_multishot_simp);
+	TC_PRINT("rtio multishot concurrent\n");
+	test_rtio_multishot_(&r_multishot_con);
+}
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(multitask_exec_con, 2);
+RTIO_DEFINE_WITH_MEMPOOL(r_multitask_con, (struct rtio_executor *)&multitask_exec_con, 4, 8,
+			 MEMPOOL_BLOCK_COUNT, MEMPOOL_BLOCK_SIZE, 4);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_multitask0, 1);
+RTIO_IODEV_TEST_DEFINE(iodev_test_multitask1, 1);
+
+/* Consumes completions until the one of userdata, releasing the buffers of the multishot
+ * events. For the multishot read itself, that is its final completion.
+ */
+static struct rtio_cqe *multitask_wait(struct rtio *r, uintptr_t *ms_userdata, void *userdata)
+{
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	while (true) {
+		cqe = rtio_cqe_consume_block(r);
+		if (cqe->userdata == userdata &&
+		    (userdata != ms_userdata || cqe->result != 0)) {
+			return cqe;
+		}
+
+		zassert_equal_ptr(cqe->userdata, ms_userdata, "Unexpected userdata");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_ok(rtio_cqe_get_mempool_buffer(r, cqe, &buf, &buf_len),
+			   "Expected a memory pool buffer");
+		rtio_spsc_release(r->cq);
+		rtio_release_buffer(r, buf, buf_len);
+	}
+}
+
+/**
+ * @brief Test a multishot read next to more reads than the other tasks
+ *
+ * Tasks are freed in submission order, so the read left without a task
+ * only starts once the multishot read is cancelled.
+ */
+ZTEST(rtio_api, test_rtio_multishot_multitask)
+{
+	struct rtio *r = &r_multitask_con;
+	struct rtio_concurrent_executor *exc = &multitask_exec_con;
+	uintptr_t userdata[3] = {0, 1, 2};
+	uint8_t bufs[2][MEMPOOL_BLOCK_SIZE];
+	struct rtio_sqe *sqe, *multishot;
+	struct rtio_cqe *cqe;
+
+	rtio_iodev_test_init(&iodev_test_multishot);
+	rtio_iodev_test_init(&iodev_test_multitask0);
+	rtio_iodev_test_init(&iodev_test_multitask1);
+
+	multishot = rtio_spsc_acquire(r->sq);
+	zassert_not_null(multishot, "Expected a valid sqe");
+	rtio_sqe_prep_read_multishot(multishot, &iodev_test_multishot, RTIO_PRIO_NORM,
+				     MEMPOOL_BLOCK_SIZE, &userdata[0]);
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read(sqe, &iodev_test_multitask0, RTIO_PRIO_NORM, bufs[0],
+			   sizeof(bufs[0]), &userdata[1]);
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read(sqe, &iodev_test_multitask1, RTIO_PRIO_NORM, bufs[1],
+			   sizeof(bufs[1]), &userdata[2]);
+
+	zassert_true(ARRAY_SIZE(userdata) - 1 > exc->task_mask,
+		     "Expected more reads than the other tasks");
+	zassert_ok(rtio_submit(r, 0), "Should return ok from rtio_submit");
+
+	TC_PRINT("completing the read with a task of its own\n");
+	cqe = multitask_wait(r, &userdata[0], &userdata[1]);
+	zassert_ok(cqe->result, "Result should be ok");
+	rtio_spsc_release(r->cq);
+
+	TC_PRINT("checking the last read waits for a free task\n");
+	k_sleep(K_MSEC(50));
+	zassert_not_null(exc->pending_sqe, "Expected the last read to wait for a task");
+
+	TC_PRINT("completing the last read once the multishot read is cancelled\n");
+	zassert_ok(rtio_sqe_cancel(r, multishot), "Cancel should succeed");
+	cqe = multitask_wait(r, &userdata[0], &userdata[0]);
+	zassert_equal(cqe->result, -ECANCELED, "Unexpected result %d", cqe->result);
+	rtio_spsc_release(r->cq);
+
+	cqe = rtio_cqe_consume_block(r);
+	zassert_equal_ptr(cqe->userdata, &userdata[2], "Unexpected userdata");
+	zassert_ok(cqe->result, "Result should be ok");
+	rtio_spsc_release(r->cq);
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(bufs); i++) {
+		for (uint32_t j = 0; j < sizeof(bufs[i]); j++) {
+			zassert_equal(bufs[i][j], (uint8_t)j, "Unexpected data");
+		}
+	}
+}
+
 
 #ifdef CONFIG_USERSPACE
 K_APPMEM_PARTITION_DEFINE(rtio_partition);
@@ -26,6 +26,11 @@ struct rtio_iodev_test_data {
 	 * Currently executing rtio context
 	 */
 	struct rtio *r;
+
+	/**
+	 * Lock around the currently executing sqe, taken on cancel
+	 */
+	struct k_spinlock lock;
 };
 
 
@@ -33,11 +38,25 @@ static void rtio_iodev_timer_fn(struct k_timer *tm)
 {
 	struct rtio_iodev_test_data *data = CONTAINER_OF(tm, struct rtio_iodev_test_data, timer);
 
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
 	struct rtio *r = data->r;
 	const struct rtio_sqe *sqe = data->sqe;
 
 	data->r = NULL;
 	data->sqe = NULL;
+	k_spin_unlock(&data->lock, key);
+
+	/* Cancelled while the timer expired */
+	if (sqe == NULL) {
+		return;
+	}
+
+	/* Fill read buffers with a known pattern */
+	if (sqe->op == RTIO_OP_RX) {
+		for (uint32_t i = 0; i < sqe->buf_len; i++) {
+			sqe->buf[i] = (uint8_t)i;
+		}
+	}
 
 	/* Complete the request with Ok and a result */
 	TC_PRINT("sqe ok callback\n");
@@ -73,8 +92,28 @@ static void rtio_iodev_test_submit(const struct rtio_sqe *sqe, struct rtio *r)
 	k_timer_start(&data->timer, K_MSEC(10), K_NO_WAIT);
 }
 
+static int rtio_iodev_test_cancel(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct rtio_iodev_test_data *data = sqe->iodev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	int ret = -EBUSY;
+
+	/* Drop the request if it has not completed yet */
+	if (data->sqe == sqe) {
+		k_timer_stop(&data->timer);
+		data->sqe = NULL;
+		data->r = NULL;
+		ret = 0;
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	return ret;
+}
+
 static const struct rtio_iodev_api rtio_iodev_test_api = {
 	.submit = rtio_iodev_test_submit,
+	.cancel = rtio_iodev_test_cancel,
 };
 
 const struct rtio_iodev_api *the_api = &rtio_iodev_test_api;
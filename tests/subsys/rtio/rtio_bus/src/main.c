@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+#include <zephyr/rtio/rtio_work.h>
+
+/* BMI160 registers, see drivers/sensor/bmi160/bmi160.h */
+#define BMI160_REG_CHIPID	0x00
+#define BMI160_REG_READ		BIT(7)
+#define BMI160_CHIP_ID		0xD1
+
+SPI_DT_IODEV_DEFINE(bmi_spi, DT_NODELABEL(bmi_spi),
+		    SPI_WORD_SET(8) | SPI_TRANSFER_MSB, 0);
+I2C_DT_IODEV_DEFINE(bmi_i2c, DT_NODELABEL(bmi_i2c));
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(bus_exec);
+RTIO_DEFINE(r_bus, (struct rtio_executor *)&bus_exec, 4, 4);
+
+/* Queue entries are reused, clear the flags left by previous tests */
+static struct rtio_sqe *sqe_acquire(struct rtio *r)
+{
+	struct rtio_sqe *sqe = rtio_spsc_acquire(r->sq);
+
+	zassert_not_null(sqe, "Expected a valid sqe");
+	sqe->flags = 0;
+
+	return sqe;
+}
+
+static void check_cqes(struct rtio *r, int count, uint8_t *ids)
+{
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < count; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &ids[i], "Completions out of order");
+		zassert_equal(ids[i], BMI160_CHIP_ID, "Unexpected chip id %x",
+			      ids[i]);
+		rtio_spsc_release(r->cq);
+	}
+}
+
+/**
+ * @brief Read the chip id with a write-read submission on SPI
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_bus, test_spi_write_read)
+{
+	static const uint8_t reg = BMI160_REG_CHIPID | BMI160_REG_READ;
+	uint8_t id = 0;
+	struct rtio_sqe *sqe;
+
+	zassert_true(spi_is_ready_iodev(&bmi_spi), "SPI bus not ready");
+
+	sqe = sqe_acquire(&r_bus);
+	rtio_sqe_prep_write_read(sqe, &bmi_spi, RTIO_PRIO_NORM, (uint8_t *)&reg,
+				 sizeof(reg), &id, sizeof(id), &id);
+	rtio_spsc_produce(r_bus.sq);
+
+	zassert_ok(rtio_submit(&r_bus, 1), "Submit should succeed");
+	check_cqes(&r_bus, 1, &id);
+}
+
+/**
+ * @brief Read the chip id with a write-read submission on I2C
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_bus, test_i2c_write_read)
+{
+	static const uint8_t reg = BMI160_REG_CHIPID;
+	uint8_t id = 0;
+	struct rtio_sqe *sqe;
+
+	zassert_true(i2c_is_ready_iodev(&bmi_i2c), "I2C bus not ready");
+
+	sqe = sqe_acquire(&r_bus);
+	rtio_sqe_prep_write_read(sqe, &bmi_i2c, RTIO_PRIO_NORM, (uint8_t *)&reg,
+				 sizeof(reg), &id, sizeof(id), &id);
+	rtio_spsc_produce(r_bus.sq);
+
+	zassert_ok(rtio_submit(&r_bus, 1), "Submit should succeed");
+	check_cqes(&r_bus, 1, &id);
+}
+
+/**
+ * @brief Chain submissions to devices on different buses
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_bus, test_chained)
+{
+	static const uint8_t spi_reg = BMI160_REG_CHIPID | BMI160_REG_READ;
+	static const uint8_t i2c_reg = BMI160_REG_CHIPID;
+	uint8_t ids[2] = { 0 };
+	struct rtio_sqe *sqe;
+
+	sqe = sqe_acquire(&r_bus);
+	rtio_sqe_prep_write_read(sqe, &bmi_spi, RTIO_PRIO_NORM, (uint8_t *)&spi_reg,
+				 sizeof(spi_reg), &ids[0], 1, &ids[0]);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	rtio_spsc_produce(r_bus.sq);
+
+	sqe = sqe_acquire(&r_bus);
+	rtio_sqe_prep_write_read(sqe, &bmi_i2c, RTIO_PRIO_NORM, (uint8_t *)&i2c_reg,
+				 sizeof(i2c_reg), &ids[1], 1, &ids[1]);
+	rtio_spsc_produce(r_bus.sq);
+
+	zassert_ok(rtio_submit(&r_bus, 2), "Submit should succeed");
+	check_cqes(&r_bus, 2, ids);
+}
+
+/**
+ * @brief I2C is half duplex, full duplex transfers are rejected
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_bus, test_i2c_transceive)
+{
+	uint8_t tx = 0, rx;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	sqe = sqe_acquire(&r_bus);
+	rtio_sqe_prep_transceive(sqe, &bmi_i2c, RTIO_PRIO_NORM, &tx, &rx, 1, NULL);
+	rtio_spsc_produce(r_bus.sq);
+
+	zassert_ok(rtio_submit(&r_bus, 1), "Submit should succeed");
+
+	cqe = rtio_spsc_consume(r_bus.cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_equal(cqe->result, -ENOTSUP, "Unexpected result %d", cqe->result);
+	rtio_spsc_release(r_bus.cq);
+}
+
+static k_tid_t work_thread;
+
+/* Records the thread performing the submission in its userdata */
+static void work_handler(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	*(k_tid_t *)sqe->userdata = k_current_get();
+	rtio_sqe_ok(r, sqe, 0);
+}
+
+static void work_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	rtio_work_submit(sqe, r, work_handler);
+}
+
+static const struct rtio_iodev_api work_iodev_api = {
+	.submit = work_iodev_submit,
+};
+
+RTIO_IODEV_DEFINE(work_iodev, &work_iodev_api, 1, NULL);
+
+/**
+ * @brief Submissions of blocking drivers complete on the RTIO work queue
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_bus, test_work_submit)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	work_thread = NULL;
+
+	sqe = sqe_acquire(&r_bus);
+	rtio_sqe_prep_nop(sqe, &work_iodev, &work_thread);
+	rtio_spsc_produce(r_bus.sq);
+
+	zassert_ok(rtio_submit(&r_bus, 1), "Submit should succeed");
+
+	cqe = rtio_spsc_consume(r_bus.cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_ok(cqe->result, "Result should be ok");
+	rtio_spsc_release(r_bus.cq);
+
+	zassert_not_null(work_thread, "Handler was not called");
+	zassert_not_equal(work_thread, k_current_get(),
+			  "Handler should run on the work queue");
+}
+
+/**
+ * @brief Chain submissions performed on the RTIO work queue
+ *
+ * The second submission is queued by the completion of the first one, from
+ * the handler running on the work queue.
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_bus, test_work_chained)
+{
+	k_tid_t threads[2] = { NULL };
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < ARRAY_SIZE(threads); i++) {
+		sqe = sqe_acquire(&r_bus);
+		rtio_sqe_prep_nop(sqe, &work_iodev, &threads[i]);
+		if (i == 0) {
+			sqe->flags |= RTIO_SQE_CHAINED;
+		}
+		rtio_spsc_produce(r_bus.sq);
+	}
+
+	zassert_ok(rtio_submit(&r_bus, 2), "Submit should succeed");
+
+	for (int i = 0; i < ARRAY_SIZE(threads); i++) {
+		cqe = rtio_spsc_consume(r_bus.cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &threads[i], "Completions out of order");
+		rtio_spsc_release(r_bus.cq);
+
+		zassert_not_null(threads[i], "Handler was not called");
+		zassert_not_equal(threads[i], k_current_get(),
+				  "Handler should run on the work queue");
+	}
+}
+
+ZTEST_SUITE(rtio_bus, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/storage/flash_map.h>
+
+#include "settings_test.h"
+#include "settings_priv.h"
+#include "settings/settings_fcb.h"
+
+#ifdef CONFIG_SETTINGS_TRANSACTION
+
+/* Register the FCB back-end as on boot */
+static void fcb_reboot(struct settings_fcb *cf)
+{
+	int rc;
+
+	config_wipe_srcs();
+	memset(cf, 0, sizeof(*cf));
+
+	cf->cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC;
+	cf->cf_fcb.f_sectors = fcb_sectors;
+	cf->cf_fcb.f_sector_cnt = ARRAY_SIZE(fcb_sectors);
+
+	rc = settings_fcb_src(cf);
+	zassert_true(rc == 0, "can't register FCB as configuration source");
+	settings_mount_fcb_backend(cf);
+
+	rc = settings_fcb_dst(cf);
+	zassert_true(rc == 0,
+		     "can't register FCB as configuration destination");
+}
+
+ZTEST(settings_config_fcb, test_config_transaction_replay_fcb)
+{
+	uint64_t new64 = 0x0102030405060708ULL;
+	uint8_t new8 = 7U;
+	struct settings_fcb cf;
+	int rc;
+
+	rc = settings_register(&c_test_handlers[0]);
+	zassert_true(rc == 0 || rc == -EEXIST, "settings_register fail");
+	config_wipe_fcb(fcb_sectors, ARRAY_SIZE(fcb_sectors));
+
+	fcb_reboot(&cf);
+
+	rc = settings_transaction_begin();
+	zassert_true(rc == 0, "can't begin transaction");
+	rc = settings_save_one("myfoo/mybar", &new8, sizeof(new8));
+	zassert_true(rc == 0, "can't stage value");
+	rc = settings_save_one("myfoo/mybar64", &new64, sizeof(new64));
+	zassert_true(rc == 0, "can't stage value");
+	rc = settings_transaction_commit();
+	zassert_true(rc == 0, "fcb transaction write error");
+
+	/* The settings are found in the transaction entry after a reset */
+	fcb_reboot(&cf);
+
+	val8 = 0U;
+	val64 = 0U;
+	rc = settings_load();
+	zassert_true(rc == 0, "fcb read error");
+	zassert_equal(val8, new8, "bad value read");
+	zassert_equal(val64, new64, "bad value read");
+
+	settings_unregister(&c_test_handlers[0]);
+}
+
+ZTEST(settings_config_fcb, test_config_transaction_truncated_fcb)
+{
+	const char *name = "myfoo/mybar";
+	uint8_t old8 = 1U;
+	uint8_t new8 = 7U;
+	struct settings_fcb cf;
+	struct fcb_entry_ctx loc;
+	char hdr[32];
+	size_t hdr_len, w_off;
+	uint16_t line_len;
+	uint8_t align;
+	int rc;
+
+	rc = settings_register(&c_test_handlers[0]);
+	zassert_true(rc == 0 || rc == -EEXIST, "settings_register fail");
+	config_wipe_fcb(fcb_sectors, ARRAY_SIZE(fcb_sectors));
+
+	fcb_reboot(&cf);
+
+	rc = settings_save_one(name, &old8, sizeof(old8));
+	zassert_true(rc == 0, "fcb write error");
+
+	/* Write a transaction entry as settings_transaction_commit() does,
+	 * but without its CRC, as if a reset happened before it was written.
+	 */
+	align = cf.cf_fcb.f_align;
+	hdr_len = ROUND_UP(sizeof(line_len), align);
+	line_len = settings_line_len_calc(name, sizeof(new8));
+	w_off = ROUND_UP(strlen(SETTINGS_BATCH_NAME) + 1, align);
+
+	rc = fcb_append(&cf.cf_fcb, w_off + hdr_len + ROUND_UP(line_len, align),
+			&loc.loc);
+	zassert_true(rc == 0, "can't append fcb entry");
+	loc.fap = cf.cf_fcb.fap;
+
+	rc = settings_line_write(SETTINGS_BATCH_NAME, NULL, 0, 0, &loc);
+	zassert_true(rc == 0, "fcb write error");
+
+	memset(hdr, 0, sizeof(hdr));
+	memcpy(hdr, &line_len, sizeof(line_len));
+	rc = flash_area_write(loc.fap, FCB_ENTRY_FA_DATA_OFF(loc.loc) + w_off,
+			      hdr, hdr_len);
+	zassert_true(rc == 0, "fcb write error");
+
+	rc = settings_line_write(name, (const char *)&new8, sizeof(new8),
+				 w_off + hdr_len, &loc);
+	zassert_true(rc == 0, "fcb write error");
+
+	fcb_reboot(&cf);
+
+	val8 = 0U;
+	rc = settings_load();
+	zassert_true(rc == 0, "fcb read error");
+	zassert_equal(val8, old8, "truncated transaction loaded");
+
+	/* Settings are still saved after the truncated entry */
+	rc = settings_save_one(name, &new8, sizeof(new8));
+	zassert_true(rc == 0, "fcb write error");
+
+	fcb_reboot(&cf);
+
+	val8 = 0U;
+	rc = settings_load();
+	zassert_true(rc == 0, "fcb read error");
+	zassert_equal(val8, new8, "bad value read");
+
+	settings_unregister(&c_test_handlers[0]);
+}
+
+#endif /* CONFIG_SETTINGS_TRANSACTION */
@@ -619,3 +619,80 @@ ZTEST(settings_functional, test_direct_loading_filter)
 	}
 	settings_deregister(&filtered_loader_settings);
 }
+
+#if defined(CONFIG_SETTINGS_TRANSACTION)
+ZTEST(settings_functional, test_transaction)
+{
+	int rc;
+	const struct test_loading_data *ldata;
+	const char *prefix = filtered_loader_settings.name;
+	char buffer[48];
+	size_t n;
+
+	settings_subsys_init();
+
+	rc = settings_transaction_commit();
+	zassert_equal(-EINVAL, rc, "commit without a transaction");
+
+	rc = settings_transaction_begin();
+	zassert_equal(0, rc);
+
+	rc = settings_transaction_begin();
+	zassert_equal(-EALREADY, rc);
+
+	/* Staged values are replaced, deleted values are not stored */
+	strcpy(buffer, prefix);
+	strcat(buffer, "/to_delete");
+	rc = settings_save_one(buffer, "1", 2);
+	zassert_equal(0, rc);
+	rc = settings_delete(buffer);
+	zassert_equal(0, rc);
+
+	for (ldata = data_final; ldata->n; ++ldata) {
+		strcpy(buffer, prefix);
+		strcat(buffer, "/");
+		strcat(buffer, ldata->n);
+		rc = settings_transaction_stage(buffer, "dup", 4);
+		zassert_equal(0, rc);
+		rc = settings_save_one(buffer, ldata->v, strlen(ldata->v) + 1);
+		zassert_equal(0, rc);
+	}
+
+	rc = settings_transaction_commit();
+	zassert_equal(0, rc);
+
+	memset(data_final_called, 0, sizeof(data_final_called));
+
+	rc = settings_load_subtree_direct(prefix, direct_filtered_loader,
+					  (void *)0x3456);
+	zassert_equal(0, rc);
+
+	for (n = 0; data_final[n].n; ++n) {
+		zassert_equal(1, data_final_called[n],
+			"Unexpected number of calls (%u) of (%s) element",
+			n, data_final[n].n);
+	}
+
+	/* Aborted values are not stored */
+	rc = settings_transaction_begin();
+	zassert_equal(0, rc);
+	strcpy(buffer, prefix);
+	strcat(buffer, "/");
+	strcat(buffer, data_final[0].n);
+	rc = settings_save_one(buffer, "aborted", 8);
+	zassert_equal(0, rc);
+	settings_transaction_abort();
+
+	memset(data_final_called, 0, sizeof(data_final_called));
+
+	rc = settings_load_subtree_direct(prefix, direct_filtered_loader,
+					  (void *)0x3456);
+	zassert_equal(0, rc);
+
+	for (n = 0; data_final[n].n; ++n) {
+		zassert_equal(1, data_final_called[n],
+			"Unexpected number of calls (%u) of (%s) element",
+			n, data_final[n].n);
+	}
+}
+#endif /* CONFIG_SETTINGS_TRANSACTION */
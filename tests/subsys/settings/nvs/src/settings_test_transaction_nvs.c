@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/storage/flash_map.h>
+
+#include "settings_priv.h"
+#include "settings_test.h"
+#include "settings/settings_nvs.h"
+
+#define TEST_PARTITION		storage_partition
+#define TEST_PARTITION_ID	FIXED_PARTITION_ID(TEST_PARTITION)
+#define TEST_SECTOR_COUNT	4
+
+static struct settings_nvs cf;
+static uint8_t batch[64];
+
+/* Append a setting to the content of a transaction entry */
+static size_t batch_add(size_t off, const char *name, const void *value,
+			uint16_t val_len)
+{
+	uint16_t name_len = strlen(name);
+
+	memcpy(&batch[off], &name_len, sizeof(name_len));
+	memcpy(&batch[off + sizeof(name_len)], &val_len, sizeof(val_len));
+	off += 2 * sizeof(uint16_t);
+	memcpy(&batch[off], name, name_len + 1);
+	off += name_len + 1;
+	memcpy(&batch[off], value, val_len);
+
+	return off + val_len;
+}
+
+/* Initialize the back-end as on boot, which replays the transaction entry */
+static void nvs_reboot(void)
+{
+	const struct flash_area *fa;
+	struct flash_sector sector;
+	uint32_t sector_cnt = 1;
+	int rc;
+
+	config_wipe_srcs();
+	memset(&cf, 0, sizeof(cf));
+
+	rc = flash_area_open(TEST_PARTITION_ID, &fa);
+	zassert_equal(rc, 0, "Can't open storage flash area");
+
+	rc = flash_area_get_sectors(TEST_PARTITION_ID, &sector_cnt, &sector);
+	zassert_true(rc == 0 || rc == -ENOMEM, "Can't get flash sectors");
+
+	cf.cf_nvs.sector_size = sector.fs_size;
+	cf.cf_nvs.sector_count = MIN(fa->fa_size / sector.fs_size,
+				     TEST_SECTOR_COUNT);
+	cf.cf_nvs.offset = fa->fa_off;
+	cf.flash_dev = fa->fa_dev;
+
+	rc = settings_nvs_backend_init(&cf);
+	zassert_equal(rc, 0, "Can't initialize NVS back-end (err=%d)", rc);
+
+	rc = settings_nvs_src(&cf);
+	zassert_equal(rc, 0, "can't register NVS as configuration source");
+
+	rc = settings_nvs_dst(&cf);
+	zassert_equal(rc, 0, "can't register NVS as configuration destination");
+}
+
+static void settings_transaction_nvs_before(void *fixture)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(TEST_PARTITION_ID, &fa);
+	zassert_equal(rc, 0, "Can't open storage flash area");
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_equal(rc, 0, "Can't erase storage flash area");
+}
+
+ZTEST(settings_transaction_nvs, test_config_transaction_replay_nvs)
+{
+	uint64_t new64 = 0x0102030405060708ULL;
+	uint8_t new8 = 7U;
+	size_t len;
+	int rc;
+
+	nvs_reboot();
+
+	/* A reset happened right after the transaction entry was written */
+	len = batch_add(0, "myfoo/mybar", &new8, sizeof(new8));
+	len = batch_add(len, "myfoo/mybar64", &new64, sizeof(new64));
+	rc = nvs_write(&cf.cf_nvs, NVS_BATCH_ID, batch, len);
+	zassert_equal(rc, len, "Can't write transaction entry (err=%d)", rc);
+
+	nvs_reboot();
+
+	rc = nvs_read(&cf.cf_nvs, NVS_BATCH_ID, batch, sizeof(batch));
+	zassert_equal(rc, -ENOENT, "Transaction entry not deleted");
+
+	val8 = 0U;
+	val64 = 0U;
+	rc = settings_load();
+	zassert_equal(rc, 0, "nvs read error");
+	zassert_equal(val8, new8, "bad value read");
+	zassert_equal(val64, new64, "bad value read");
+}
+
+ZTEST(settings_transaction_nvs, test_config_transaction_truncated_nvs)
+{
+	uint64_t new64 = 0x0102030405060708ULL;
+	uint8_t new8 = 7U;
+	uint8_t old8 = 1U;
+	size_t len;
+	int rc;
+
+	nvs_reboot();
+
+	rc = settings_save_one("myfoo/mybar", &old8, sizeof(old8));
+	zassert_equal(rc, 0, "nvs write error");
+
+	/* A reset happened once the first setting of the transaction was
+	 * saved, the other ones are saved on the next boot.
+	 */
+	len = batch_add(0, "myfoo/mybar", &new8, sizeof(new8));
+	len = batch_add(len, "myfoo/mybar64", &new64, sizeof(new64));
+	rc = nvs_write(&cf.cf_nvs, NVS_BATCH_ID, batch, len);
+	zassert_equal(rc, len, "Can't write transaction entry (err=%d)", rc);
+
+	rc = settings_save_one("myfoo/mybar", &new8, sizeof(new8));
+	zassert_equal(rc, 0, "nvs write error");
+
+	nvs_reboot();
+
+	val8 = 0U;
+	val64 = 0U;
+	rc = settings_load();
+	zassert_equal(rc, 0, "nvs read error");
+	zassert_equal(val8, new8, "bad value read");
+	zassert_equal(val64, new64, "bad value read");
+
+	/* A transaction entry cut in the middle of a setting is dropped */
+	len = batch_add(0, "myfoo/mybar", &old8, sizeof(old8));
+	len = batch_add(len, "myfoo/mybar64", &old8, sizeof(old8));
+	rc = nvs_write(&cf.cf_nvs, NVS_BATCH_ID, batch, len - 1);
+	zassert_equal(rc, len - 1, "Can't write transaction entry (err=%d)", rc);
+
+	nvs_reboot();
+
+	rc = nvs_read(&cf.cf_nvs, NVS_BATCH_ID, batch, sizeof(batch));
+	zassert_equal(rc, -ENOENT, "Transaction entry not deleted");
+
+	val8 = 0U;
+	val64 = 0U;
+	rc = settings_load();
+	zassert_equal(rc, 0, "nvs read error");
+	zassert_equal(val8, new8, "bad value read");
+	zassert_equal(val64, new64, "bad value read");
+}
+
+ZTEST_SUITE(settings_transaction_nvs, NULL, settings_config_setup,
+	    settings_transaction_nvs_before, NULL, settings_config_teardown);
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+struct sensor_msg {
+	uint32_t seq;
+	int32_t value;
+};
+
+ZBUS_SUBSCRIBER_DEFINE(plain_sub, 8);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub_a);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub_b);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub_runtime);
+
+ZBUS_CHAN_DEFINE(sensor_chan,	    /* Name */
+		 struct sensor_msg, /* Message type */
+
+		 NULL,						  /* Validator */
+		 NULL,						  /* User data */
+		 ZBUS_OBSERVERS(plain_sub, msg_sub_a, msg_sub_b), /* observers */
+		 ZBUS_MSG_INIT(0)				  /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(other_chan,	    /* Name */
+		 struct sensor_msg, /* Message type */
+
+		 NULL,		       /* Validator */
+		 NULL,		       /* User data */
+		 ZBUS_OBSERVERS_EMPTY, /* observers */
+		 ZBUS_MSG_INIT(0)      /* Initial value */
+);
+
+static void drain(const struct zbus_observer *sub)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	if (sub->queue != NULL) {
+		while (zbus_sub_wait(sub, &chan, K_NO_WAIT) == 0) {
+		}
+	} else {
+		while (zbus_sub_wait_msg(sub, &chan, &msg, K_NO_WAIT) == 0) {
+		}
+	}
+}
+
+static void msg_subscriber_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain(&plain_sub);
+	drain(&msg_sub_a);
+	drain(&msg_sub_b);
+	drain(&msg_sub_runtime);
+}
+
+static void publish(const struct zbus_channel *chan, uint32_t seq, int expected)
+{
+	struct sensor_msg msg = {.seq = seq, .value = -(int32_t)seq};
+
+	zassert_equal(zbus_chan_pub(chan, &msg, K_NO_WAIT), expected, "publish %u", seq);
+}
+
+static void expect_msg(const struct zbus_observer *sub, const struct zbus_channel *exp_chan,
+		       uint32_t seq)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	zassert_equal(zbus_sub_wait_msg(sub, &chan, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal_ptr(chan, exp_chan, NULL);
+	zassert_equal(msg.seq, seq, "got %u instead of %u", msg.seq, seq);
+	zassert_equal(msg.value, -(int32_t)seq, NULL);
+}
+
+/* Messages published before a slow subscriber reads them are not lost */
+ZTEST(msg_subscriber, test_lossless)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	for (uint32_t seq = 1; seq <= 3; seq++) {
+		publish(&sensor_chan, seq, 0);
+	}
+
+	/* A regular subscriber only gets the last message */
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(zbus_sub_wait(&plain_sub, &chan, K_NO_WAIT), 0, NULL);
+		zassert_equal(zbus_chan_read(chan, &msg, K_NO_WAIT), 0, NULL);
+		zassert_equal(msg.seq, 3, NULL);
+	}
+
+	for (uint32_t seq = 1; seq <= 3; seq++) {
+		expect_msg(&msg_sub_a, &sensor_chan, seq);
+	}
+
+	for (uint32_t seq = 1; seq <= 3; seq++) {
+		expect_msg(&msg_sub_b, &sensor_chan, seq);
+	}
+
+	zassert_equal(zbus_sub_wait_msg(&msg_sub_a, &chan, &msg, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(zbus_sub_wait_msg(&msg_sub_b, &chan, &msg, K_MSEC(10)), -ENOMSG, NULL);
+}
+
+ZTEST(msg_subscriber, test_disabled)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	zbus_obs_set_enable(&msg_sub_b, false);
+	publish(&sensor_chan, 10, 0);
+	zbus_obs_set_enable(&msg_sub_b, true);
+	publish(&sensor_chan, 11, 0);
+
+	expect_msg(&msg_sub_a, &sensor_chan, 10);
+	expect_msg(&msg_sub_a, &sensor_chan, 11);
+	expect_msg(&msg_sub_b, &sensor_chan, 11);
+	zassert_equal(zbus_sub_wait_msg(&msg_sub_b, &chan, &msg, K_NO_WAIT), -ENOMSG, NULL);
+}
+
+ZTEST(msg_subscriber, test_runtime_observer)
+{
+	zassert_equal(zbus_chan_add_obs(&other_chan, &msg_sub_runtime, K_NO_WAIT), 0, NULL);
+
+	publish(&other_chan, 20, 0);
+	publish(&sensor_chan, 21, 0);
+	publish(&other_chan, 22, 0);
+
+	expect_msg(&msg_sub_runtime, &other_chan, 20);
+	expect_msg(&msg_sub_runtime, &other_chan, 22);
+
+	zassert_equal(zbus_chan_rm_obs(&other_chan, &msg_sub_runtime, K_NO_WAIT), 0, NULL);
+}
+
+/* Each publication takes one buffer per message subscriber until it is received */
+ZTEST(msg_subscriber, test_pool_exhausted)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	for (uint32_t seq = 1; seq <= 3; seq++) {
+		publish(&sensor_chan, seq, 0);
+	}
+
+	/* The buffer for the second subscriber is missing */
+	publish(&sensor_chan, 4, -ENOMEM);
+
+	for (uint32_t seq = 1; seq <= 4; seq++) {
+		expect_msg(&msg_sub_a, &sensor_chan, seq);
+	}
+
+	for (uint32_t seq = 1; seq <= 3; seq++) {
+		expect_msg(&msg_sub_b, &sensor_chan, seq);
+	}
+	zassert_equal(zbus_sub_wait_msg(&msg_sub_b, &chan, &msg, K_NO_WAIT), -ENOMSG, NULL);
+
+	/* The buffers are back in the pool */
+	publish(&sensor_chan, 5, 0);
+	expect_msg(&msg_sub_a, &sensor_chan, 5);
+	expect_msg(&msg_sub_b, &sensor_chan, 5);
+}
+
+ZTEST(msg_subscriber, test_wrong_observer_type)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	zassert_equal(zbus_sub_wait(&msg_sub_a, &chan, K_NO_WAIT), -EINVAL, NULL);
+	zassert_equal(zbus_sub_wait_msg(&plain_sub, &chan, &msg, K_NO_WAIT), -EINVAL, NULL);
+}
+
+ZTEST_SUITE(msg_subscriber, NULL, NULL, msg_subscriber_before, NULL, NULL);
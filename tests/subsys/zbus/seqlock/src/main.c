@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/irq_offload.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+#define SAMPLE_WORDS 32
+
+struct sample_msg {
+	uint32_t words[SAMPLE_WORDS];
+};
+
+static void sample_fill(struct sample_msg *msg, uint32_t value)
+{
+	for (int i = 0; i < SAMPLE_WORDS; i++) {
+		msg->words[i] = value;
+	}
+}
+
+static bool sample_is_consistent(const struct sample_msg *msg)
+{
+	for (int i = 1; i < SAMPLE_WORDS; i++) {
+		if (msg->words[i] != msg->words[0]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static uint32_t last_seen;
+static int listener_count;
+
+static void sample_callback(const struct zbus_channel *chan)
+{
+	const struct sample_msg *msg = zbus_chan_const_msg(chan);
+
+	last_seen = msg->words[0];
+	listener_count++;
+}
+
+ZBUS_LISTENER_DEFINE(sample_lis, sample_callback);
+
+ZBUS_SUBSCRIBER_DEFINE(sample_sub, 4);
+
+ZBUS_CHAN_SEQLOCK_DEFINE(sample_chan,	   /* Name */
+			 struct sample_msg, /* Message type */
+
+			 NULL,				      /* Validator */
+			 NULL,				      /* User data */
+			 ZBUS_OBSERVERS(sample_lis, sample_sub), /* observers */
+			 ZBUS_MSG_INIT(0)		      /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(regular_chan,	    /* Name */
+		 struct sample_msg, /* Message type */
+
+		 NULL,		       /* Validator */
+		 NULL,		       /* User data */
+		 ZBUS_OBSERVERS_EMPTY, /* observers */
+		 ZBUS_MSG_INIT(0)      /* Initial value */
+);
+
+static void sample_reset(void)
+{
+	const struct zbus_channel *chan;
+
+	while (zbus_sub_wait(&sample_sub, &chan, K_NO_WAIT) == 0) {
+	}
+
+	listener_count = 0;
+	last_seen = 0;
+}
+
+ZTEST(seqlock, test_pub_read)
+{
+	const struct zbus_channel *chan;
+	struct sample_msg msg;
+
+	sample_reset();
+
+	zassert_equal(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.words[0], 0, NULL);
+
+	for (uint32_t value = 1; value <= 3; value++) {
+		sample_fill(&msg, value);
+		zassert_equal(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT), 0, NULL);
+
+		zassert_equal(last_seen, value, "listener got %u", last_seen);
+		zassert_equal(zbus_sub_wait(&sample_sub, &chan, K_NO_WAIT), 0, NULL);
+		zassert_equal_ptr(chan, &sample_chan, NULL);
+
+		memset(&msg, 0, sizeof(msg));
+		zassert_equal(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT), 0, NULL);
+		zassert_true(sample_is_consistent(&msg), NULL);
+		zassert_equal(msg.words[0], value, NULL);
+	}
+
+	zassert_equal(listener_count, 3, NULL);
+
+	zassert_equal(zbus_chan_notify(&sample_chan, K_NO_WAIT), 0, NULL);
+	zassert_equal(listener_count, 4, NULL);
+	zassert_equal(zbus_sub_wait(&sample_sub, &chan, K_NO_WAIT), 0, NULL);
+}
+
+ZTEST(seqlock, test_unsupported)
+{
+	zassert_equal(zbus_chan_claim(&sample_chan, K_NO_WAIT), -ENOTSUP, NULL);
+	zassert_equal(zbus_chan_finish(&sample_chan), -ENOTSUP, NULL);
+	zassert_equal(zbus_chan_add_obs(&sample_chan, &sample_lis, K_NO_WAIT), -ENOTSUP, NULL);
+
+	/* Regular channels keep their behavior */
+	zassert_equal(zbus_chan_claim(&regular_chan, K_NO_WAIT), 0, NULL);
+	zassert_equal(zbus_chan_finish(&regular_chan), 0, NULL);
+}
+
+static int isr_pub_err;
+static int isr_read_err;
+static struct sample_msg isr_msg;
+
+static void isr_pub_read(const void *param)
+{
+	struct sample_msg msg;
+
+	sample_fill(&msg, POINTER_TO_UINT(param));
+
+	isr_pub_err = zbus_chan_pub(&sample_chan, &msg, K_FOREVER);
+	isr_read_err = zbus_chan_read(&sample_chan, &isr_msg, K_NO_WAIT);
+}
+
+ZTEST(seqlock, test_isr)
+{
+	const struct zbus_channel *chan;
+
+	sample_reset();
+
+	irq_offload(isr_pub_read, UINT_TO_POINTER(42));
+
+	zassert_equal(isr_pub_err, 0, "publish from ISR failed (%d)", isr_pub_err);
+	zassert_equal(isr_read_err, 0, "read from ISR failed (%d)", isr_read_err);
+	zassert_true(sample_is_consistent(&isr_msg), NULL);
+	zassert_equal(isr_msg.words[0], 42, NULL);
+	zassert_equal(last_seen, 42, NULL);
+	zassert_equal(zbus_sub_wait(&sample_sub, &chan, K_NO_WAIT), 0, NULL);
+}
+
+static int timer_reads;
+static int timer_torn;
+
+static void reader_timer_handler(struct k_timer *timer)
+{
+	struct sample_msg msg;
+
+	if (zbus_chan_read(&sample_chan, &msg, K_NO_WAIT) != 0) {
+		return;
+	}
+
+	timer_reads++;
+	if (!sample_is_consistent(&msg)) {
+		timer_torn++;
+	}
+}
+
+K_TIMER_DEFINE(reader_timer, reader_timer_handler, NULL);
+
+/* Readers interrupting a publication must still see a complete message */
+ZTEST(seqlock, test_consistency)
+{
+	struct sample_msg msg;
+	int64_t end = k_uptime_get() + 500;
+	const struct zbus_channel *chan;
+	uint32_t value = 0;
+
+	sample_reset();
+	zassert_equal(zbus_obs_set_enable(&sample_sub, false), 0, NULL);
+
+	timer_reads = 0;
+	timer_torn = 0;
+	k_timer_start(&reader_timer, K_TICKS(1), K_TICKS(1));
+
+	while (k_uptime_get() < end) {
+		sample_fill(&msg, ++value);
+		zassert_equal(zbus_chan_pub(&sample_chan, &msg, K_NO_WAIT), 0, NULL);
+	}
+
+	k_timer_stop(&reader_timer);
+	zassert_equal(zbus_obs_set_enable(&sample_sub, true), 0, NULL);
+
+	zassert_true(timer_reads > 0, "reader did not run");
+	zassert_equal(timer_torn, 0, "%d torn reads out of %d", timer_torn, timer_reads);
+
+	zassert_equal(zbus_chan_read(&sample_chan, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.words[0], value, NULL);
+	zassert_equal(zbus_sub_wait(&sample_sub, &chan, K_NO_WAIT), -ENOMSG, NULL);
+}
+
+ZTEST_SUITE(seqlock, NULL, NULL, NULL, NULL, NULL);